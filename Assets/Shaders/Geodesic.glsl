@@ -26,12 +26,26 @@ layout(std140, binding = 2) uniform Disk
 
 layout(std140, binding = 3) uniform Objects 
 {
-    int    numObjects;
-    vec4   objPosRadius[16];
-    vec4   objColor[16];
-    float  mass[16]; 
+    int   numObjects;
+    int   numNodes;
+    float objectsReach; // Radius around the hole enclosing every object
 };
 
+struct SceneObject
+{
+    vec4 posRadius;
+    vec4 color;
+};
+
+struct BVHNode
+{
+    vec3 boundsMin; int leftFirst;
+    vec3 boundsMax; int count;
+};
+
+layout(std430, binding = 0) readonly buffer ObjectBuffer { SceneObject objects[]; };
+layout(std430, binding = 1) readonly buffer BVHBuffer    { BVHNode     nodes[];   };
+
 layout(std140, binding = 4) uniform Simulation 
 {
     int   maxStepsMoving;
@@ -52,13 +66,50 @@ const float MIN_STEP_SIZE = 1e6;
 const float MAX_STEP_SIZE = 5e7;
 const float STEP_ADAPTATION_FACTOR = 1.5;
 
+const int BVH_STACK_SIZE = 32;
+
+const uint TILE_SIZE = 16;
+
+// Escape direction of every invocation in the tile (w = 1 if the ray reached the sky)
+shared vec4 s_EscapeDirections[TILE_SIZE * TILE_SIZE];
+
 vec4 objectColor = vec4(0.0);
 vec3 hitCenter = vec3(0.0);
+vec3 hitPoint = vec3(0.0);
 float hitRadius = 0.0;
 
-vec3 SampleHDRI(vec3 direction)
+vec3 SampleHDRI(vec3 direction, float lod)
 {
-    return texture(u_HDRIEnvironment, direction).rgb;
+    return textureLod(u_HDRIEnvironment, direction, lod).rgb;
+}
+
+// Angle between this pixel's escape direction and a neighbour's, or -1 if the
+// neighbour lies outside the tile or never reached the sky
+float NeighbourSpread(vec3 direction, ivec2 offset)
+{
+    ivec2 id = ivec2(gl_LocalInvocationID.xy) + offset;
+    if (any(lessThan(id, ivec2(0))) || any(greaterThanEqual(id, ivec2(TILE_SIZE))))
+        return -1.0;
+
+    vec4 neighbour = s_EscapeDirections[id.y * int(TILE_SIZE) + id.x];
+    if (neighbour.w == 0.0)
+        return -1.0;
+
+    return 2.0 * asin(clamp(0.5 * length(direction - neighbour.xyz), 0.0, 1.0));
+}
+
+// Lensing can stretch one pixel over a large patch of sky; pick the mip whose
+// texels match the angular spread of the escape directions around this pixel
+float EnvironmentLod(vec3 direction)
+{
+    float spreadX = max(NeighbourSpread(direction, ivec2(1, 0)), NeighbourSpread(direction, ivec2(-1,  0)));
+    float spreadY = max(NeighbourSpread(direction, ivec2(0, 1)), NeighbourSpread(direction, ivec2( 0, -1)));
+    float spread  = max(spreadX, spreadY);
+    if (spread <= 0.0)
+        return 0.0;
+
+    float texelAngle = 1.5707963 / float(textureSize(u_HDRIEnvironment, 0).x);
+    return max(log2(spread / texelAngle), 0.0);
 }
 
 float hash(float p) 
@@ -216,29 +267,91 @@ bool Intercept(Ray ray, float rs)
     return ray.r <= rs;
 }
 
-bool InterceptObject(Ray ray) 
+bool SegmentHitsAABB(vec3 origin, vec3 invDir, float len, vec3 bmin, vec3 bmax)
 {
-    vec3 P = vec3(ray.x, ray.y, ray.z);
-    
-    for (int i = 0; i < numObjects; ++i) 
+    vec3 t0 = (bmin - origin) * invDir;
+    vec3 t1 = (bmax - origin) * invDir;
+    vec3 tNear = min(t0, t1);
+    vec3 tFar  = max(t0, t1);
+
+    float enter = max(max(tNear.x, tNear.y), max(tNear.z, 0.0));
+    float exit  = min(min(tFar.x, tFar.y), min(tFar.z, len));
+    return enter <= exit;
+}
+
+// Distance along the normalised segment direction to the first sphere hit, or -1.
+float SegmentSphere(vec3 origin, vec3 dir, float len, vec3 center, float radius)
+{
+    vec3  oc = origin - center;
+    float c  = dot(oc, oc) - radius * radius;
+    if (c <= 0.0)
+        return 0.0;
+
+    float b = dot(oc, dir);
+    if (b > 0.0)
+        return -1.0;
+
+    float disc = b * b - c;
+    if (disc < 0.0)
+        return -1.0;
+
+    float t = -b - sqrt(disc);
+    return t <= len ? t : -1.0;
+}
+
+bool InterceptObject(vec3 from, vec3 to) 
+{
+    if (numNodes == 0)
+        return false;
+
+    vec3  delta = to - from;
+    float len   = length(delta);
+    if (len <= 0.0)
+        return false;
+
+    vec3 dir    = delta / len;
+    vec3 invDir = 1.0 / dir;
+
+    float closest  = len;
+    int   hitIndex = -1;
+
+    int stack[BVH_STACK_SIZE];
+    int sp = 0;
+    stack[sp++] = 0;
+
+    while (sp > 0)
     {
-        vec3  center = objPosRadius[i].xyz;
-        float radius = objPosRadius[i].w;
-        
-        float distSq = dot(P - center, P - center);
-        if (distSq > radius * radius * 4.0) 
+        BVHNode node = nodes[stack[--sp]];
+        if (!SegmentHitsAABB(from, invDir, closest, node.boundsMin, node.boundsMax))
             continue;
 
-        if (distSq <= radius * radius)
+        if (node.count > 0)
         {
-            objectColor = objColor[i];
-            hitCenter = center;
-            hitRadius = radius;
-            return true;
+            for (int i = node.leftFirst; i < node.leftFirst + node.count; ++i)
+            {
+                float t = SegmentSphere(from, dir, closest, objects[i].posRadius.xyz, objects[i].posRadius.w);
+                if (t >= 0.0)
+                {
+                    closest  = t;
+                    hitIndex = i;
+                }
+            }
+        }
+        else if (sp + 2 <= BVH_STACK_SIZE)
+        {
+            stack[sp++] = node.leftFirst;
+            stack[sp++] = node.leftFirst + 1;
         }
     }
 
-    return false;
+    if (hitIndex < 0)
+        return false;
+
+    objectColor = objects[hitIndex].color;
+    hitPoint    = from + dir * closest;
+    hitCenter   = objects[hitIndex].posRadius.xyz;
+    hitRadius   = objects[hitIndex].posRadius.w;
+    return true;
 }
 
 void GeodesicRHS(Ray ray, out vec3 d1, out vec3 d2) 
@@ -347,15 +460,10 @@ float CalculateAdaptiveStepSize(Ray ray, float baseStepSize)
     return clamp(baseStepSize * r_factor * curvature_factor, MIN_STEP_SIZE, MAX_STEP_SIZE);
 }
 
-void main() 
+vec4 TracePixel(ivec2 pix, int WIDTH, int HEIGHT, out vec3 escapeDirection, out bool escaped)
 {
-    ivec2 pix  = ivec2(gl_GlobalInvocationID.xy);
-    int WIDTH  = imageSize(outImage).x;
-    int HEIGHT = imageSize(outImage).y;
-
-    if (pix.x >= WIDTH || 
-        pix.y >= HEIGHT) 
-        return;
+    escapeDirection = vec3(0.0);
+    escaped         = false;
 
     float u = (2.0 * (pix.x + 0.5) / WIDTH - 1.0) * 
               cam.aspect * cam.tanHalfFov;
@@ -393,7 +501,7 @@ void main()
         maxSteps = maxSteps / 2;
 
     float currentStepSize = D_LAMBDA;
-    int objectCheckInterval = 5;
+    bool objectsInReach = numObjects > 0;
 
     for (int i = 0; i < maxSteps; ++i) 
     {
@@ -448,10 +556,18 @@ void main()
             }
         }
         
-        if (i % objectCheckInterval == 0 && InterceptObject(ray)) 
-        { 
-            hitObject = true; 
-            break; 
+        if (objectsInReach)
+        {
+            if (InterceptObject(prevPos, newPos)) 
+            { 
+                hitObject = true; 
+                break; 
+            }
+
+            // Outgoing rays outside the photon sphere never turn back, so once
+            // past every object they can stop testing for hits
+            if (ray.dr > 0.0 && ray.r > objectsReach && ray.r > SagA_rs * 1.5)
+                objectsInReach = false;
         }
         
         prevPos = newPos;
@@ -466,7 +582,7 @@ void main()
         color = vec4(0.0, 0.0, 0.0, 1.0);
     else if (hitObject) 
     {
-        vec3 P = vec3(ray.x, ray.y, ray.z);
+        vec3 P = hitPoint;
         vec3 N = normalize(P - hitCenter);
         vec3 V = normalize(cam.camPos - P);
 
@@ -479,9 +595,40 @@ void main()
         color = mix(accumulatedColor, color, color.a);
     } else
     {
-        vec3 rayDirection = normalize(vec3(ray.x, ray.y, ray.z) - cam.camPos);
-        vec3 hdriColor = SampleHDRI(rayDirection);
-        color  = vec4(mix(accumulatedColor.rgb, hdriColor, 1.0 - accumulatedColor.a), 1.0);
+        // The sky is composited in main() once the tile's escape directions are known
+        escapeDirection = normalize(vec3(ray.x, ray.y, ray.z) - cam.camPos);
+        escaped         = true;
+        color           = accumulatedColor;
+    }
+
+    return color;
+}
+
+void main() 
+{
+    ivec2 pix  = ivec2(gl_GlobalInvocationID.xy);
+    int WIDTH  = imageSize(outImage).x;
+    int HEIGHT = imageSize(outImage).y;
+    bool inside = pix.x < WIDTH && pix.y < HEIGHT;
+
+    vec3 escapeDirection = vec3(0.0);
+    bool escaped         = false;
+    vec4 color           = vec4(0.0);
+
+    if (inside)
+        color = TracePixel(pix, WIDTH, HEIGHT, escapeDirection, escaped);
+
+    // Every invocation has to reach the barrier, so pixels outside the image only skip the work
+    s_EscapeDirections[gl_LocalInvocationIndex] = vec4(escapeDirection, escaped ? 1.0 : 0.0);
+    barrier();
+
+    if (!inside)
+        return;
+
+    if (escaped)
+    {
+        vec3 hdriColor = SampleHDRI(escapeDirection, EnvironmentLod(escapeDirection));
+        color = vec4(mix(color.rgb, hdriColor, 1.0 - color.a), 1.0);
     }
 
     imageStore(outImage, pix, color);
@@ -5,17 +5,33 @@
 layout(location = 0) in vec3 a_Position;
 layout(location = 1) in vec3 a_Normal;
 
+// Per instance
+layout(location = 2) in vec4 a_CentreRadius;
+layout(location = 3) in vec4 a_ColorSpecular;
+layout(location = 4) in vec4 a_Params; // x = emission, y = selected, z = outline width
+
 uniform mat4 u_ViewProjection;
-uniform mat4 u_Transform;
 
 out vec3 v_Normal;
 out vec3 v_WorldPos;
+flat out vec3  v_Color;
+flat out float v_Specular;
+flat out float v_Emission;
+flat out int   v_IsSelected;
+flat out float v_OutlineWidth;
 
 void main()
 {
-    v_WorldPos  = vec3(u_Transform * vec4(a_Position, 1.0));
-    v_Normal    = mat3(transpose(inverse(u_Transform))) * a_Normal;
+    // Spheres only carry a uniform scale, so the unit-sphere normal is already the world normal
+    v_WorldPos  = a_CentreRadius.xyz + a_Position * a_CentreRadius.w;
+    v_Normal    = a_Normal;
     gl_Position = u_ViewProjection * vec4(v_WorldPos, 1.0);
+
+    v_Color        = a_ColorSpecular.rgb;
+    v_Specular     = a_ColorSpecular.a;
+    v_Emission     = a_Params.x;
+    v_IsSelected   = int(a_Params.y);
+    v_OutlineWidth = a_Params.z;
 }
 
 #type fragment
@@ -24,15 +40,15 @@ void main()
 
 in vec3 v_Normal;
 in vec3 v_WorldPos;
+flat in vec3  v_Color;
+flat in float v_Specular;
+flat in float v_Emission;
+flat in int   v_IsSelected;
+flat in float v_OutlineWidth;
 
-uniform vec3  u_Color;
-uniform float u_Specular;
-uniform float u_Emission;
 uniform vec3  u_LightPos;
 uniform vec3  u_CameraPos;
-uniform int   u_IsSelected;
 uniform vec3  u_OutlineColor;
-uniform float u_OutlineWidth;
 uniform samplerCube u_HDRIEnvironment;
 
 out vec4 o_FragColor;
@@ -51,18 +67,18 @@ void main()
     float diff = max(dot(normal, lightDir), 0.0);
     float spec = pow(max(dot(viewDir, reflectDir), 0.0), 32.0);
     
-    vec3 diffuse  = u_Color * (diff + hdriIntensity * hdriLight);
-    vec3 specular = vec3(u_Specular) * spec;
-    vec3 emission = u_Color * u_Emission;
+    vec3 diffuse  = v_Color * (diff + hdriIntensity * hdriLight);
+    vec3 specular = vec3(v_Specular) * spec;
+    vec3 emission = v_Color * v_Emission;
     
     vec3 result = diffuse + specular + emission;
 
-    if (u_IsSelected > 0)
+    if (v_IsSelected > 0)
     {
         float ndotv       = max(dot(normal, viewDir), 0.0);
         float rim         = 1.0 - ndotv;
-        float width       = clamp(u_OutlineWidth, 0.0, 1.0);
-        float outlineMask = step(1.0 - u_OutlineWidth, rim);;
+        float width       = clamp(v_OutlineWidth, 0.0, 1.0);
+        float outlineMask = step(1.0 - v_OutlineWidth, rim);;
         result = mix(result, u_OutlineColor, outlineMask);
     }
 
@@ -0,0 +1,105 @@
+#type vertex
+
+#version 330 core
+
+layout(location = 0) in vec2 a_Corner;
+
+// Per instance, same data as Sphere.glsl; locations follow the quad's single attribute
+layout(location = 1) in vec4 a_CentreRadius;
+layout(location = 2) in vec4 a_ColorSpecular;
+layout(location = 3) in vec4 a_Params; // x = emission
+
+uniform mat4 u_ViewProjection;
+uniform vec3 u_CameraPos;
+
+out vec3 v_WorldPos;
+flat out vec4  v_CentreRadius;
+flat out vec3  v_Color;
+flat out float v_Specular;
+flat out float v_Emission;
+
+void main()
+{
+    vec3  centre = a_CentreRadius.xyz;
+    float radius = a_CentreRadius.w;
+
+    vec3  toCamera = u_CameraPos - centre;
+    float dist     = length(toCamera);
+
+    v_CentreRadius = a_CentreRadius;
+    v_Color        = a_ColorSpecular.rgb;
+    v_Specular     = a_ColorSpecular.a;
+    v_Emission     = a_Params.x;
+
+    // Inside the sphere there is no silhouette to cover
+    if (dist <= radius)
+    {
+        gl_Position = vec4(0.0);
+        return;
+    }
+
+    // A camera-facing quad through the centre that just contains the tangent cone,
+    // so every ray that can hit the sphere crosses it
+    vec3 forward = toCamera / dist;
+    vec3 helper  = abs(forward.y) > 0.99 ? vec3(1.0, 0.0, 0.0) : vec3(0.0, 1.0, 0.0);
+    vec3 right   = normalize(cross(helper, forward));
+    vec3 up      = cross(forward, right);
+
+    float halfSize = radius * dist / sqrt(dist * dist - radius * radius);
+
+    v_WorldPos  = centre + (right * a_Corner.x + up * a_Corner.y) * halfSize;
+    gl_Position = u_ViewProjection * vec4(v_WorldPos, 1.0);
+}
+
+#type fragment
+
+#version 330 core
+
+in vec3 v_WorldPos;
+flat in vec4  v_CentreRadius;
+flat in vec3  v_Color;
+flat in float v_Specular;
+flat in float v_Emission;
+
+uniform mat4  u_ViewProjection;
+uniform vec3  u_LightPos;
+uniform vec3  u_CameraPos;
+uniform samplerCube u_HDRIEnvironment;
+
+out vec4 o_FragColor;
+
+void main()
+{
+    vec3  centre = v_CentreRadius.xyz;
+    float radius = v_CentreRadius.w;
+
+    vec3  rayDir = normalize(v_WorldPos - u_CameraPos);
+    vec3  oc     = u_CameraPos - centre;
+    float b      = dot(oc, rayDir);
+    float c      = dot(oc, oc) - radius * radius;
+    float h      = b * b - c;
+    if (h < 0.0)
+        discard;
+
+    vec3 hitPos = u_CameraPos + rayDir * (-b - sqrt(h));
+    vec3 normal = (hitPos - centre) / radius;
+
+    vec4 clipPos = u_ViewProjection * vec4(hitPos, 1.0);
+    gl_FragDepth = (clipPos.z / clipPos.w) * 0.5 + 0.5;
+
+    vec3 lightDir   = normalize(u_LightPos - hitPos);
+    vec3 viewDir    = -rayDir;
+    vec3 reflectDir = reflect(-lightDir, normal);
+
+    vec3 hdriLight = texture(u_HDRIEnvironment, normal).rgb;
+    float hdriIntensity = 0.3;
+
+    float diff = max(dot(normal, lightDir), 0.0);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), 32.0);
+
+    vec3 diffuse  = v_Color * (diff + hdriIntensity * hdriLight);
+    vec3 specular = vec3(v_Specular) * spec;
+    vec3 emission = v_Color * v_Emission;
+
+    o_FragColor = vec4(diffuse + specular + emission, 1.0);
+}
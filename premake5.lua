@@ -359,6 +359,7 @@ project "Donut"
 		links
 		{
 			"opengl32.lib",
+			"winmm.lib",
 		}
 
 	filter "configurations:Debug"
@@ -1,7 +1,13 @@
 #include "Application.h"
 
 #include "Rendering/Renderer.h"
+#include "Rendering/AssetRegistry.h"
 #include "SettingsManager.h"
+#include "JobSystem.h"
+#include "HDRIManager.h"
+#include "RenderThread.h"
+
+#include "Engine/PreviewRenderer.h"
 
 #include "States/SimulationState.h"
 #include "States/ConfigState.h"
@@ -10,16 +16,30 @@
 #include <GLFW/glfw3.h>
 #include <ImGuizmo.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
 namespace Donut
 {
     Application* Application::s_Instance = nullptr;
 
-    Application::Application(const std::string& name, int width, int height)
-        : m_Running(true), m_Minimized(false)
+    Application::Application(const std::string& name, int width, int height, ApplicationCommandLineArgs args)
+        : m_CommandLineArgs(args), m_Running(true), m_Minimized(false),
+          m_Headless(args.HasFlag("--headless"))
     {
         s_Instance = this;
 
-        m_Window = CreateScope<Window>(name, width, height);
+        Logger::Init();
+        JobSystem::Init();
+        SettingsManager::Initialize();
+
+        // The backend decides what kind of context the window needs, so it is chosen first
+        SelectRendererAPI();
+
+        m_Window = CreateScope<Window>(name, width, height, m_Headless);
         m_Window->SetEventCallback([this](Event& event) 
         {
             OnEvent(event);
@@ -36,16 +56,103 @@ namespace Donut
 
     void Application::Run()
     {
+        if (m_Headless)
+        {
+            RunHeadless();
+            return;
+        }
+
         while (m_Running)
         {
+            m_Window->PollEvents();
+
+            // Uploads and main-thread jobs touch GL, so they wait for the render thread
+            if (JobSystem::HasMainThreadJobs() || HDRIManager::Get().IsUploading())
+            {
+                RenderThread::Execute([]()
+                {
+                    JobSystem::ProcessMainThreadJobs();
+                    HDRIManager::Get().Update();
+                });
+            }
+            else
+                HDRIManager::Get().Update();
+
             if (!m_Minimized)
             {
                 OnUpdate();
                 OnRender();
             }
 
+            // Also paces minimised frames, where no swap would otherwise hold the loop back
+            m_FrameScheduler.SetTargetFPS(m_Engine->GetTargetFPS());
+            m_FrameScheduler.WaitForNextFrame();
+        }
+    }
+
+    // Renders --frames frames of the simulation off-screen and writes the last one to --output.
+    // Nothing here touches ImGui or input, so it runs on Mesa llvmpipe in a container.
+    void Application::RunHeadless()
+    {
+        uint32_t width  = m_Window->GetWidth();
+        uint32_t height = m_Window->GetHeight();
+
+        const char* frames = m_CommandLineArgs.GetValue("--frames");
+        const char* output = m_CommandLineArgs.GetValue("--output");
+        int frameCount = frames ? std::max(std::atoi(frames), 1) : 1;
+
+        FramebufferSpecification spec;
+        spec.Width       = width;
+        spec.Height      = height;
+        spec.Attachments = { FramebufferTextureFormat::RGBA8 };
+        Ref<Framebuffer> target = Framebuffer::Create(spec);
+
+        // A fixed step, with physics ticked in lockstep with it, keeps the output independent
+        // of how fast the machine is
+        float deltaTime = 1.0f / static_cast<float>(m_Engine->GetTargetFPS());
+        m_Engine->GetGravity() = SettingsManager::GetGravityEnabled();
+        m_Engine->SetLockstepPhysics(true);
+
+        // The first frame already needs the sky, so the start-up HDRI is finished before timing starts
+        auto& hdriManager = HDRIManager::Get();
+        while (hdriManager.IsLoading())
+        {
+            JobSystem::ProcessMainThreadJobs();
+            hdriManager.Update();
+            if (hdriManager.IsDecoding())
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        // HDRIManager::Update() is no longer pumped, so no prefetch uploads land in the timed frames
+        auto start = std::chrono::steady_clock::now();
+        for (int frame = 0; frame < frameCount && m_Running; ++frame)
+        {
+            JobSystem::ProcessMainThreadJobs();
+
+            m_Engine->UpdatePerformance(deltaTime);
+            m_Engine->UpdatePhysics(deltaTime);
+
+            EngineFrame engineFrame = m_Engine->BuildFrame(m_Engine->GetCamera());
+            target->Bind();
+            RenderCommand::SetClearColor(glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+            RenderCommand::Clear();
+            m_Engine->DispatchCompute(engineFrame);
+            m_Engine->DrawBlurPass(engineFrame);
+            target->Unbind();
+
             m_Window->OnUpdate();
         }
+
+        // The readback waits for the GPU, so the timing covers every queued frame
+        std::vector<uint8_t> pixels;
+        target->ReadColorAttachment(0, pixels);
+        double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        std::printf("Headless %s: %d frames at %ux%u in %.1f ms (%.2f ms/frame)\n",
+                    RendererAPI::GetAPIName(Renderer::GetAPI()), frameCount, width, height, elapsed, elapsed / frameCount);
+
+        if (output)
+            PreviewRenderer::SaveImage(output, pixels, width, height);
     }
 
     void Application::Close()
@@ -55,6 +162,9 @@ namespace Donut
 
     void Application::OnEvent(Event& event)
     {
+        if (event.IsInCategory(EventCategoryInput) && m_PendingInputTime == 0.0)
+            m_PendingInputTime = glfwGetTime();
+
         EventDispatcher dispatcher(event);
         dispatcher.Dispatch<WindowCloseEvent>([this, &event](WindowCloseEvent& e) 
         {
@@ -70,12 +180,15 @@ namespace Donut
             else
                 m_Minimized = false;
             
-            Renderer::OnWindowResize(e.GetWidth(), e.GetHeight());
+            RenderThread::Execute([&e]() { Renderer::OnWindowResize(e.GetWidth(), e.GetHeight()); });
             m_Engine->SetWindowDimensions(e.GetWidth(), e.GetHeight());
             event.Handled = true;
             return true;
         });
         
+        if (!m_StateManager)
+            return;
+
         dispatcher.Dispatch<KeyPressedEvent>([this, &event](KeyPressedEvent& e) 
         {
             if (e.GetKeyCode() == GLFW_KEY_1)
@@ -103,37 +216,80 @@ namespace Donut
         m_StateManager->OnEvent(event);
     }
 
+    void Application::SelectRendererAPI()
+    {
+        const auto& settings = SettingsManager::GetSettingsConst();
+        RendererAPI::API api = RendererAPI::GetAPIFromName(settings.graphics.renderAPI);
+        if (m_CommandLineArgs.HasFlag("--software"))
+            api = RendererAPI::API::Software;
+
+        if (!RendererAPI::IsSupported(api))
+        {
+            DONUT_WARN("{} renderer is not available yet, falling back to OpenGL", RendererAPI::GetAPIName(api));
+            api = RendererAPI::API::OpenGL;
+        }
+        RendererAPI::SetAPI(api);
+        DONUT_INFO("Using the {} renderer", RendererAPI::GetAPIName(api));
+    }
+
     void Application::OnInit()     
     { 
-        Logger::Init();
-        
-        SettingsManager::Initialize();
-        
         const auto& settings = SettingsManager::GetSettingsConst();
-        RendererAPI::API api = (settings.graphics.renderAPI == "Vulkan") ? RendererAPI::API::Vulkan : RendererAPI::API::OpenGL;
-        RendererAPI::SetAPI(api);
         
+        // Only the OpenGL backend presents through a context another thread can own
+        bool renderThreaded = !m_Headless && Renderer::GetAPI() == RendererAPI::API::OpenGL &&
+                              !m_CommandLineArgs.HasFlag("--no-render-thread");
+
         Renderer::Init();
-        m_Window->InitImGui();
+        if (!m_Headless)
+            m_Window->InitImGui(!renderThreaded);
+
+        // Otherwise shared assets are created the first time a state asks for them
+        AssetRegistry::Init();
+        if (m_CommandLineArgs.HasFlag("--preload"))
+            AssetRegistry::Preload();
+
+        HDRIManager::Get().SetMemoryBudget(static_cast<uint64_t>(settings.graphics.hdriCacheBudgetMB) * 1024 * 1024);
+        SettingsManager::Subscribe([](const Settings& changed, uint64_t)
+        {
+            HDRIManager::Get().SetMemoryBudget(static_cast<uint64_t>(changed.graphics.hdriCacheBudgetMB) * 1024 * 1024);
+        });
         
-        Renderer::OnWindowResize(1280, 720);
+        Renderer::OnWindowResize(m_Window->GetWidth(), m_Window->GetHeight());
         RenderCommand::SetFaceCulling(false);
 
         m_Engine = CreateScope<Engine>();
-        m_Engine->SetWindowDimensions(1280, 720);
+        m_Engine->SetWindowDimensions(m_Window->GetWidth(), m_Window->GetHeight());
+        m_Engine->SetTargetFPS(settings.simulation.targetFPS);
+        if (const char* scenePath = m_CommandLineArgs.GetValue("--scene"))
+            m_Engine->LoadSceneFromPath(scenePath);
+
+        // The states are editor UI; headless runs drive the engine directly
+        if (m_Headless)
+            return;
         
         m_StateManager = CreateScope<StateManager>();
         m_StateManager->RegisterState("Config",       CreateScope<ConfigState>());
         m_StateManager->RegisterState("Simulation",   CreateScope<SimulationState>());
         m_StateManager->RegisterState("WorldBuilder", CreateScope<WorldBuilderState>());
         m_StateManager->SwitchToState("Config");
+
+        RenderThread::Init(*m_Window, renderThreaded);
     }
 
     void Application::OnShutdown() 
     { 
+        // Everything below deletes GL objects, so the context comes back to this thread first
+        RenderThread::Shutdown();
+
         if (m_StateManager)
             m_StateManager->Shutdown();
-            
+
+        // The engine's physics thread schedules jobs, so it has to stop first
+        m_Engine.reset();
+        JobSystem::Shutdown();
+
+        AssetRegistry::Shutdown();
         Renderer::Shutdown();
         SettingsManager::Shutdown();
         Logger::Shutdown();
@@ -150,7 +306,14 @@ namespace Donut
 
     void Application::OnRender()
     {
-        m_StateManager->Render();
+        Scope<FramePacket> packet = CreateScope<FramePacket>();
+        packet->FrameIndex = m_FrameIndex++;
+        packet->BuildTime  = glfwGetTime();
+        packet->InputTime  = m_PendingInputTime;
+        packet->Graphics   = SettingsManager::GetSettingsConst().graphics;
+        m_PendingInputTime = 0.0;
+
+        m_StateManager->Render(*packet);
         m_Window->BeginImGuiFrame();
         
         ImGuizmo::BeginFrame();
@@ -159,6 +322,9 @@ namespace Donut
         SetupDockingLayout();
         m_StateManager->OnImUIRender();
         m_Window->EndImGuiFrame();
+        packet->UI.Capture(ImGui::GetDrawData());
+
+        RenderThread::Submit(std::move(packet));
     }
     
     void Application::SetupDockingLayout()
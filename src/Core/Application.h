@@ -1,6 +1,7 @@
 #pragma once
 
 #include "StateManager.h"
+#include "FrameScheduler.h"
 #include "Memory.h"
 #include "Window.h"
 #include "Event.h"
@@ -8,13 +9,43 @@
 
 #include "Engine/Engine.h"
 
+#include <string_view>
+
 namespace Donut
 {
+    struct ApplicationCommandLineArgs
+    {
+        int    Count = 0;
+        char** Args  = nullptr;
+
+        bool HasFlag(std::string_view flag) const
+        {
+            for (int i = 1; i < Count; ++i)
+            {
+                if (flag == Args[i])
+                    return true;
+            }
+            return false;
+        }
+
+        // The argument following flag, or nullptr if the flag is absent or last
+        const char* GetValue(std::string_view flag) const
+        {
+            for (int i = 1; i + 1 < Count; ++i)
+            {
+                if (flag == Args[i])
+                    return Args[i + 1];
+            }
+            return nullptr;
+        }
+    };
+
     class Application
     {
     public:
         Application(const std::string& name = "Donut", 
-                    int width = 1280, int height = 720);
+                    int width = 1280, int height = 720,
+                    ApplicationCommandLineArgs args = {});
         ~Application();
 
         void Run();
@@ -23,25 +54,37 @@ namespace Donut
         Window& GetWindow()             { return *m_Window;       }
         StateManager& GetStateManager() { return *m_StateManager; }
         Engine& GetEngine()             { return *m_Engine;       }
+        const FrameScheduler& GetFrameScheduler() const { return m_FrameScheduler; }
+        bool IsHeadless()         const { return m_Headless;      }
+        const ApplicationCommandLineArgs& GetCommandLineArgs() const { return m_CommandLineArgs; }
         static Application& Get()       { return *s_Instance;     }
     private:
+        void SelectRendererAPI();
         void OnInit();
         void OnShutdown();
         void OnUpdate();
         void OnRender();
+        void RunHeadless();
         void OnEvent(Event& event);
         void SetupDockingLayout();
     private:
         Scope<StateManager> m_StateManager;
         Scope<Window> m_Window;
         Scope<Engine> m_Engine;
+        ApplicationCommandLineArgs m_CommandLineArgs;
+        FrameScheduler m_FrameScheduler;
 
         bool m_Running;
         bool m_Minimized;
+        bool m_Headless = false;
         
         float m_DeltaTime = 0.0f;
         float m_LastFrame = 0.0f;
 
+        // glfwGetTime() of the oldest input event not yet carried by a frame packet
+        uint64_t m_FrameIndex       = 0;
+        double   m_PendingInputTime = 0.0;
+
         static Application* s_Instance;
     };
 }
\ No newline at end of file
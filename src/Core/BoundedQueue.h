@@ -0,0 +1,75 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+
+namespace Donut
+{
+    // Blocking single-consumer FIFO with a fixed capacity. An item keeps its slot
+    // until the consumer pops it, so a consumer that pops only after processing
+    // holds the producer at most capacity items ahead. Close() wakes both sides;
+    // items already queued are still handed out.
+    template<typename T>
+    class BoundedQueue
+    {
+    public:
+        explicit BoundedQueue(size_t capacity = 1)
+            : m_Capacity(capacity) {}
+
+        // Blocks while the queue is full; returns false once it has been closed
+        bool Push(T item)
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_NotFull.wait(lock, [this]() { return m_Closed || m_Items.size() < m_Capacity; });
+            if (m_Closed)
+                return false;
+
+            m_Items.push_back(std::move(item));
+            m_NotEmpty.notify_one();
+            return true;
+        }
+
+        // Blocks until an item is queued, or returns nullptr once closed and drained.
+        // The item stays queued, and its address valid, until Pop().
+        T* WaitFront()
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_NotEmpty.wait(lock, [this]() { return m_Closed || !m_Items.empty(); });
+            return m_Items.empty() ? nullptr : &m_Items.front();
+        }
+
+        void Pop()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                m_Items.pop_front();
+            }
+            m_NotFull.notify_all();
+        }
+
+        void Close()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                m_Closed = true;
+            }
+            m_NotFull.notify_all();
+            m_NotEmpty.notify_all();
+        }
+
+        size_t GetSize() const
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            return m_Items.size();
+        }
+    private:
+        mutable std::mutex      m_Mutex;
+        std::condition_variable m_NotFull;
+        std::condition_variable m_NotEmpty;
+        std::deque<T>           m_Items;
+        size_t                  m_Capacity;
+        bool                    m_Closed = false;
+    };
+};
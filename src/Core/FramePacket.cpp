@@ -0,0 +1,39 @@
+#include "FramePacket.h"
+
+namespace Donut
+{
+    UIDrawData::~UIDrawData()
+    {
+        Clear();
+    }
+
+    void UIDrawData::Capture(const ImDrawData* source)
+    {
+        Clear();
+        if (!source || !source->Valid)
+            return;
+
+        m_DrawData.CmdListsCount    = source->CmdListsCount;
+        m_DrawData.TotalIdxCount    = source->TotalIdxCount;
+        m_DrawData.TotalVtxCount    = source->TotalVtxCount;
+        m_DrawData.DisplayPos       = source->DisplayPos;
+        m_DrawData.DisplaySize      = source->DisplaySize;
+        m_DrawData.FramebufferScale = source->FramebufferScale;
+        m_DrawData.OwnerViewport    = source->OwnerViewport;
+
+        // Only the vertex, index and command buffers are copied; that is all a renderer reads
+        m_DrawData.CmdLists.reserve(source->CmdLists.Size);
+        for (ImDrawList* list : source->CmdLists)
+            m_DrawData.CmdLists.push_back(list->CloneOutput());
+
+        m_DrawData.Valid = true;
+    }
+
+    void UIDrawData::Clear()
+    {
+        for (ImDrawList* list : m_DrawData.CmdLists)
+            IM_DELETE(list);
+
+        m_DrawData.Clear();
+    }
+};
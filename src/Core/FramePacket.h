@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Core/SettingsManager.h"
+
+#include <imgui.h>
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace Donut
+{
+    using RenderCommandFn = std::function<void()>;
+
+    // Deep copy of the draw data ImGui::Render() produced. ImGui reuses its draw lists
+    // on the next NewFrame(), so the render thread draws from this copy instead.
+    class UIDrawData
+    {
+    public:
+        UIDrawData() = default;
+        ~UIDrawData();
+
+        UIDrawData(const UIDrawData&)            = delete;
+        UIDrawData& operator=(const UIDrawData&) = delete;
+
+        void Capture(const ImDrawData* source);
+        void Clear();
+
+        ImDrawData* Get() { return m_DrawData.Valid ? &m_DrawData : nullptr; }
+    private:
+        ImDrawData m_DrawData;
+    };
+
+    // Everything the render thread needs to draw one frame, built by the main thread.
+    // Commands run in submission order and may only use what they captured by value,
+    // since the main thread is already changing its own state for the next frame.
+    struct FramePacket
+    {
+        uint64_t FrameIndex = 0;
+
+        // glfwGetTime() when building started, and of the oldest input event folded
+        // into this frame; zero when the frame carries no new input
+        double BuildTime = 0.0;
+        double InputTime = 0.0;
+
+        GraphicsSettings             Graphics;
+        std::vector<RenderCommandFn> Commands;
+        UIDrawData                   UI;
+
+        void Submit(RenderCommandFn command) { Commands.push_back(std::move(command)); }
+    };
+};
@@ -0,0 +1,101 @@
+#include "FrameScheduler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+#if defined(DONUT_WINDOWS)
+    #include <windows.h>
+    #include <timeapi.h>
+#endif
+
+namespace Donut
+{
+    namespace
+    {
+        double ToSeconds(std::chrono::steady_clock::duration duration)
+        {
+            return std::chrono::duration<double>(duration).count();
+        }
+    }
+
+    FrameScheduler::FrameScheduler()
+    {
+#if defined(DONUT_WINDOWS)
+        // The default 15.6 ms timer would leave most of every frame to the spin
+        timeBeginPeriod(1);
+#endif
+    }
+
+    FrameScheduler::~FrameScheduler()
+    {
+#if defined(DONUT_WINDOWS)
+        timeEndPeriod(1);
+#endif
+    }
+
+    void FrameScheduler::SetTargetFPS(int fps)
+    {
+        m_TargetFPS = std::max(fps, 0);
+    }
+
+    void FrameScheduler::WaitForNextFrame()
+    {
+        Clock::time_point now = Clock::now();
+        if (m_FrameStart == Clock::time_point())
+            m_FrameStart = now;
+
+        if (m_TargetFPS > 0)
+        {
+            const auto period   = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / m_TargetFPS));
+            const auto deadline = m_NextFrame;
+
+            if (now < deadline)
+                SleepUntil(deadline);
+
+            Clock::time_point woke = Clock::now();
+            m_Stats.Lateness = std::max(ToSeconds(woke - deadline), 0.0) * 1000.0;
+
+            // Scheduling from the deadline keeps small overshoots from accumulating;
+            // after a slow frame that cost a whole period, resynchronise instead of bursting
+            m_NextFrame = woke - deadline < period ? deadline + period : woke + period;
+        }
+
+        Clock::time_point end = Clock::now();
+        double work  = ToSeconds(now - m_FrameStart);
+        double wait  = ToSeconds(end - now);
+        double total = work + wait;
+
+        m_Stats.Frames++;
+        m_Stats.WorkTime       = work * 1000.0;
+        m_Stats.WaitTime       = wait * 1000.0;
+        m_Stats.TotalIdleTime += wait;
+        if (total > 0.0)
+        {
+            double blend = std::min(total, 1.0);
+            m_Stats.IdleFraction = m_Stats.IdleFraction * (1.0 - blend) + (wait / total) * blend;
+        }
+
+        m_FrameStart = end;
+    }
+
+    void FrameScheduler::SleepUntil(Clock::time_point deadline)
+    {
+        while (ToSeconds(deadline - Clock::now()) > m_SleepEstimate)
+        {
+            Clock::time_point start = Clock::now();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            double observed = ToSeconds(Clock::now() - start);
+
+            // Welford's update; the estimate is one standard deviation above the mean
+            m_SleepSamples++;
+            double delta = observed - m_SleepMean;
+            m_SleepMean += delta / static_cast<double>(m_SleepSamples);
+            m_SleepM2   += delta * (observed - m_SleepMean);
+            m_SleepEstimate = m_SleepMean + std::sqrt(m_SleepM2 / static_cast<double>(m_SleepSamples - 1));
+        }
+
+        while (Clock::now() < deadline)
+            std::this_thread::yield();
+    }
+};
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace Donut
+{
+    struct FrameSchedulerStats
+    {
+        uint64_t Frames = 0;
+
+        // Milliseconds of the last frame spent working and waiting for its deadline
+        double WorkTime = 0.0;
+        double WaitTime = 0.0;
+
+        // Share of wall time spent waiting, smoothed over roughly the last second
+        double IdleFraction = 0.0;
+        double TotalIdleTime = 0.0; // Seconds
+
+        // How far past its deadline the last frame started, in milliseconds
+        double Lateness = 0.0;
+    };
+
+    // Paces the main loop to a target frame rate. The OS sleep is only trusted to
+    // wake up within its observed jitter, so each wait sleeps in short slices while
+    // there is enough time left and spins through the remainder.
+    class FrameScheduler
+    {
+    public:
+        FrameScheduler();
+        ~FrameScheduler();
+
+        FrameScheduler(const FrameScheduler&)            = delete;
+        FrameScheduler& operator=(const FrameScheduler&) = delete;
+
+        // Zero or less leaves the loop unpaced
+        void SetTargetFPS(int fps);
+        int  GetTargetFPS() const { return m_TargetFPS; }
+
+        // Blocks until the next frame is due, called once at the end of every frame
+        void WaitForNextFrame();
+
+        const FrameSchedulerStats& GetStats() const { return m_Stats; }
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        void SleepUntil(Clock::time_point deadline);
+    private:
+        int               m_TargetFPS = 0;
+        Clock::time_point m_NextFrame;
+        Clock::time_point m_FrameStart;
+
+        // Running mean and variance of how long a 1 ms sleep really takes, in seconds
+        double   m_SleepEstimate = 5e-3;
+        double   m_SleepMean     = 5e-3;
+        double   m_SleepM2       = 0.0;
+        uint64_t m_SleepSamples  = 1;
+
+        FrameSchedulerStats m_Stats;
+    };
+};
@@ -0,0 +1,170 @@
+#include "HDRICache.h"
+#include "Core/Log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace Donut
+{
+    namespace
+    {
+        constexpr char CacheMagic[4] = { 'D', 'C', 'U', 'B' };
+
+        uint64_t LevelTexelCount(uint32_t faceSize, uint32_t level)
+        {
+            uint64_t size = std::max(faceSize >> level, 1u);
+            return size * size * 6;
+        }
+    }
+
+    uint64_t HDRICache::HashFile(const std::string& path)
+    {
+        MappedFile file;
+        if (!file.Open(path))
+            return 0;
+
+        // FNV-1a over the contents, so edited or replaced sources get a fresh entry
+        uint64_t hash = 14695981039346656037ull;
+        const uint8_t* data = file.GetData();
+        for (size_t i = 0; i < file.GetSize(); ++i)
+        {
+            hash ^= data[i];
+            hash *= 1099511628211ull;
+        }
+
+        return hash;
+    }
+
+    std::string HDRICache::GetEntryPath(uint64_t sourceHash, uint32_t faceSize)
+    {
+        char name[64];
+        std::snprintf(name, sizeof(name), "%016llx_%u.dcube", static_cast<unsigned long long>(sourceHash), faceSize);
+        return GetCacheDirectory() + "/" + name;
+    }
+
+    Ref<HDRICacheEntry> HDRICache::Open(uint64_t sourceHash, uint32_t faceSize)
+    {
+        auto entry = CreateRef<HDRICacheEntry>();
+        if (!entry->File.Open(GetEntryPath(sourceHash, faceSize)))
+            return nullptr;
+
+        if (entry->File.GetSize() < sizeof(HDRICacheHeader))
+            return nullptr;
+
+        HDRICacheHeader header;
+        std::memcpy(&header, entry->File.GetData(), sizeof(header));
+
+        if (std::memcmp(header.Magic, CacheMagic, sizeof(CacheMagic)) != 0 ||
+            header.Version    != FormatVersion ||
+            header.SourceHash != sourceHash    ||
+            header.FaceSize   != faceSize      ||
+            header.MipCount   == 0)
+            return nullptr;
+
+        uint64_t expected = 0;
+        for (uint32_t level = 0; level < header.MipCount; ++level)
+            expected += LevelTexelCount(faceSize, level) * sizeof(uint32_t);
+
+        if (header.DataSize != expected || entry->File.GetSize() < sizeof(HDRICacheHeader) + expected)
+        {
+            DONUT_WARN("Ignoring truncated HDRI cache entry: {}", GetEntryPath(sourceHash, faceSize));
+            return nullptr;
+        }
+
+        entry->Data.FaceSize = faceSize;
+        entry->Data.MipCount = header.MipCount;
+        entry->Data.Texels   = reinterpret_cast<const uint32_t*>(entry->File.GetData() + sizeof(HDRICacheHeader));
+        return entry;
+    }
+
+    bool HDRICache::Store(uint64_t sourceHash, uint32_t faceSize, const std::vector<std::vector<float>>& levels)
+    {
+        if (levels.empty())
+            return false;
+
+        HDRICacheHeader header = {};
+        std::memcpy(header.Magic, CacheMagic, sizeof(CacheMagic));
+        header.Version    = FormatVersion;
+        header.SourceHash = sourceHash;
+        header.FaceSize   = faceSize;
+        header.MipCount   = static_cast<uint32_t>(levels.size());
+
+        std::vector<uint32_t> texels;
+        for (uint32_t level = 0; level < header.MipCount; ++level)
+        {
+            const auto& rgb = levels[level];
+            uint64_t count  = LevelTexelCount(faceSize, level);
+            if (rgb.size() != count * 3)
+                return false;
+
+            for (uint64_t i = 0; i < count; ++i)
+                texels.push_back(PackRGB9E5(rgb[i * 3 + 0], rgb[i * 3 + 1], rgb[i * 3 + 2]));
+        }
+        header.DataSize = texels.size() * sizeof(uint32_t);
+
+        std::string path    = GetEntryPath(sourceHash, faceSize);
+        std::string tmpPath = path + ".tmp";
+
+        try
+        {
+            std::filesystem::create_directories(GetCacheDirectory());
+
+            {
+                std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+                file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+                file.write(reinterpret_cast<const char*>(texels.data()), static_cast<std::streamsize>(header.DataSize));
+                if (!file)
+                    throw std::runtime_error("write failed");
+            }
+
+            // Readers either see the previous entry or the complete new one
+            std::filesystem::rename(tmpPath, path);
+        }
+        catch (const std::exception& e)
+        {
+            DONUT_ERROR("Failed to write HDRI cache entry {}: {}", path, e.what());
+            std::error_code ec;
+            std::filesystem::remove(tmpPath, ec);
+            return false;
+        }
+
+        DONUT_INFO("Cached converted HDRI: {} ({} mip levels)", path, header.MipCount);
+        return true;
+    }
+
+    uint32_t HDRICache::PackRGB9E5(float r, float g, float b)
+    {
+        // Shared-exponent encoding from EXT_texture_shared_exponent: 9-bit mantissas, 5-bit exponent, bias 15
+        constexpr int   MantissaBits = 9;
+        constexpr int   ExponentBias = 15;
+        static constexpr float MaxValue = 65408.0f;
+
+        auto clampChannel = [](float v) { return v > 0.0f ? std::min(v, MaxValue) : 0.0f; };
+        r = clampChannel(r);
+        g = clampChannel(g);
+        b = clampChannel(b);
+
+        float maxChannel = std::max(r, std::max(g, b));
+        if (maxChannel < 1e-20f)
+            return 0;
+
+        int exponent = std::max(-ExponentBias - 1, static_cast<int>(std::floor(std::log2(maxChannel)))) + 1 + ExponentBias;
+        float scale  = std::exp2(static_cast<float>(exponent - ExponentBias - MantissaBits));
+
+        if (static_cast<int>(std::floor(maxChannel / scale + 0.5f)) == (1 << MantissaBits))
+        {
+            scale *= 2.0f;
+            exponent++;
+        }
+
+        uint32_t rm = static_cast<uint32_t>(std::floor(r / scale + 0.5f));
+        uint32_t gm = static_cast<uint32_t>(std::floor(g / scale + 0.5f));
+        uint32_t bm = static_cast<uint32_t>(std::floor(b / scale + 0.5f));
+
+        return rm | (gm << 9) | (bm << 18) | (static_cast<uint32_t>(exponent) << 27);
+    }
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Core/Memory.h"
+#include "Core/MappedFile.h"
+#include "Rendering/Texture.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Donut
+{
+    struct HDRICacheHeader
+    {
+        char     Magic[4];
+        uint32_t Version;
+        uint64_t SourceHash;
+        uint32_t FaceSize;
+        uint32_t MipCount;
+        uint64_t DataSize;
+    };
+    static_assert(sizeof(HDRICacheHeader) == 32, "HDRICacheHeader layout is part of the file format");
+
+    // A mapped cache file; Data points into the mapping and dies with it
+    struct HDRICacheEntry
+    {
+        MappedFile  File;
+        CubemapData Data;
+    };
+
+    // Converted cubemaps stored under cache/hdri/ keyed by a hash of the source
+    // .hdr and the face size. Files are a header followed by the RGB9E5 texels
+    // of every mip level, so loading is a mapping and a single upload.
+    class HDRICache
+    {
+    public:
+        static constexpr uint32_t FormatVersion = 1;
+
+        static uint64_t    HashFile(const std::string& path);
+        static std::string GetEntryPath(uint64_t sourceHash, uint32_t faceSize);
+
+        // Returns nullptr for a missing, truncated or outdated entry
+        static Ref<HDRICacheEntry> Open(uint64_t sourceHash, uint32_t faceSize);
+
+        // levels holds RGB floats for all six faces of each mip level, largest first
+        static bool Store(uint64_t sourceHash, uint32_t faceSize, const std::vector<std::vector<float>>& levels);
+
+        static uint32_t PackRGB9E5(float r, float g, float b);
+    private:
+        static std::string GetCacheDirectory() { return "cache/hdri"; }
+    };
+};
@@ -1,4 +1,12 @@
 #include "HDRIManager.h"
+#include "Core/JobSystem.h"
+#include "Core/HDRICache.h"
+#include "Core/RenderThread.h"
+
+#include "stb_image.h"
+#include <glm/gtc/packing.hpp>
+
+#include <algorithm>
 #include <filesystem>
 
 namespace Donut
@@ -9,7 +17,8 @@ namespace Donut
         if (it != m_HDRICache.end())
         {
             DONUT_INFO("HDRI already cached: {}", path);
-            return it->second;
+            it->second.LastUsed = ++m_UseClock;
+            return it->second.Texture;
         }
 
         DONUT_INFO("Loading HDRI: {}", path);
@@ -17,7 +26,8 @@ namespace Donut
         
         if (hdri)
         {
-            m_HDRICache[path] = hdri;
+            MakeResident(path, hdri);
+            EvictToBudget();
             DONUT_INFO("Successfully loaded and cached HDRI: {}", path);
         }
         else
@@ -28,14 +38,309 @@ namespace Donut
 
     void HDRIManager::SetCurrentHDRI(const std::string& path)
     {
-        auto hdri = LoadHDRI(path);
-        if (hdri)
+        auto it = m_HDRICache.find(path);
+        if (it != m_HDRICache.end())
+        {
+            // A prefetch of some other entry can keep going in the background
+            if (m_Loading && !m_Prefetching)
+                CancelLoading();
+
+            m_Stats.Hits++;
+            MakeCurrent(path, it->second.Texture);
+            return;
+        }
+
+        m_Stats.Misses++;
+
+        if (m_Loading && m_LoadingPath == path)
+        {
+            m_Prefetching = false;
+            return;
+        }
+
+        CancelLoading();
+        StartLoading(path, false);
+    }
+
+    void HDRIManager::StartLoading(const std::string& path, bool prefetch)
+    {
+        m_Loading     = true;
+        m_Prefetching = prefetch;
+        m_LoadingPath = path;
+
+        uint64_t generation = m_LoadGeneration;
+        DONUT_INFO("{} HDRI in the background: {}", prefetch ? "Prefetching" : "Loading", path);
+
+        JobSystem::Run([this, path, generation]()
+        {
+            uint64_t sourceHash = HDRICache::HashFile(path);
+
+            Ref<HDRICacheEntry> entry = sourceHash ? HDRICache::Open(sourceHash, CubemapFaceSize) : nullptr;
+            Ref<HDRIImage>      image = entry ? nullptr : DecodeHDRI(path);
+
+            JobSystem::RunOnMainThread([this, entry, image, sourceHash, generation]()
+            {
+                OnHDRILoaded(entry, image, sourceHash, generation);
+            });
+        });
+    }
+
+    void HDRIManager::Update()
+    {
+        if (!m_Loading)
+        {
+            StartNextPrefetch();
+            return;
+        }
+
+        if (!m_LoadingTexture || !m_LoadingTexture->ContinueUpload(UploadBytesPerFrame))
+            return;
+
+        if (m_LoadingHash)
+            StoreInCache(m_LoadingTexture, m_LoadingHash);
+
+        CompleteLoading(m_LoadingTexture);
+    }
+
+    float HDRIManager::GetLoadingProgress() const
+    {
+        if (!m_Loading)
+            return 1.0f;
+
+        return m_LoadingTexture ? m_LoadingTexture->GetUploadProgress() : 0.0f;
+    }
+
+    Ref<HDRIImage> HDRIManager::DecodeHDRI(const std::string& path)
+    {
+        // The thread-local flag keeps this independent of the synchronous loader's global setting
+        stbi_set_flip_vertically_on_load_thread(true);
+
+        int width, height, channels;
+        float* hdrData = stbi_loadf(path.c_str(), &width, &height, &channels, 3);
+        if (!hdrData)
+            return nullptr;
+
+        auto image    = CreateRef<HDRIImage>();
+        image->Path   = path;
+        image->Width  = static_cast<uint32_t>(width);
+        image->Height = static_cast<uint32_t>(height);
+        image->Pixels.resize(static_cast<size_t>(width) * height * 4);
+
+        // Half floats halve the bytes streamed to the GPU; the alpha lane keeps rows 8-byte aligned
+        const uint16_t one = glm::packHalf1x16(1.0f);
+        size_t pixelCount  = static_cast<size_t>(width) * height;
+        for (size_t i = 0; i < pixelCount; ++i)
+        {
+            image->Pixels[i * 4 + 0] = glm::packHalf1x16(hdrData[i * 3 + 0]);
+            image->Pixels[i * 4 + 1] = glm::packHalf1x16(hdrData[i * 3 + 1]);
+            image->Pixels[i * 4 + 2] = glm::packHalf1x16(hdrData[i * 3 + 2]);
+            image->Pixels[i * 4 + 3] = one;
+        }
+
+        stbi_image_free(hdrData);
+        return image;
+    }
+
+    void HDRIManager::OnHDRILoaded(const Ref<HDRICacheEntry>& entry, const Ref<HDRIImage>& image, uint64_t sourceHash, uint64_t generation)
+    {
+        if (!m_Loading || generation != m_LoadGeneration)
+            return;
+
+        if (entry)
+        {
+            DONUT_INFO("Loaded HDRI from cache: {}", HDRICache::GetEntryPath(sourceHash, CubemapFaceSize));
+            auto hdri = CubemapTexture::Create(entry->Data);
+            if (hdri)
+                CompleteLoading(hdri);
+            else
+                ResetLoading();
+            return;
+        }
+
+        if (!image)
+        {
+            DONUT_ERROR("Failed to load HDRI: {}", m_LoadingPath);
+            std::string path = m_LoadingPath;
+            bool prefetch    = m_Prefetching;
+            ResetLoading();
+
+            // With nothing to keep showing, fall back to the loader's default sky
+            if (!prefetch && !m_CurrentHDRI)
+                MakeCurrent(path, LoadHDRI(path));
+            return;
+        }
+
+        DONUT_INFO("Decoded HDRI: {} ({}x{})", image->Path, image->Width, image->Height);
+
+        m_LoadingTexture = CubemapTexture::Create(CubemapFaceSize, CubemapFaceSize);
+        if (!m_LoadingTexture)
+        {
+            ResetLoading();
+            return;
+        }
+
+        m_LoadingHash = sourceHash;
+        m_LoadingTexture->BeginUpload(image);
+    }
+
+    void HDRIManager::CompleteLoading(const Ref<CubemapTexture>& hdri)
+    {
+        std::string path = m_LoadingPath;
+        bool prefetch    = m_Prefetching;
+        ResetLoading();
+
+        MakeResident(path, hdri);
+        if (prefetch)
         {
-            m_CurrentHDRI = hdri;
-            DONUT_INFO("Set current HDRI to: {}", path);
+            m_Stats.Prefetches++;
+            EvictToBudget();
         }
         else
-            DONUT_ERROR("Failed to set current HDRI: {}", path);
+            MakeCurrent(path, hdri);
+    }
+
+    void HDRIManager::StoreInCache(const Ref<CubemapTexture>& hdri, uint64_t sourceHash)
+    {
+        // Readback has to happen here on the GL thread; packing and writing the file do not
+        auto levels = CreateRef<std::vector<std::vector<float>>>(hdri->GetMipCount());
+        for (uint32_t level = 0; level < hdri->GetMipCount(); ++level)
+        {
+            if (!hdri->ReadPixels(level, (*levels)[level]))
+                return;
+        }
+
+        uint32_t faceSize = hdri->GetWidth();
+        JobSystem::Run([levels, sourceHash, faceSize]()
+        {
+            HDRICache::Store(sourceHash, faceSize, *levels);
+        });
+    }
+
+    void HDRIManager::ResetLoading()
+    {
+        // Cancelling from the UI happens off the render thread
+        RenderThread::Release(std::move(m_LoadingTexture));
+        m_LoadingPath.clear();
+        m_LoadingHash = 0;
+        m_Loading     = false;
+        m_Prefetching = false;
+    }
+
+    void HDRIManager::CancelLoading()
+    {
+        m_LoadGeneration++;
+        ResetLoading();
+    }
+
+    void HDRIManager::MakeResident(const std::string& path, const Ref<CubemapTexture>& hdri)
+    {
+        auto& resident = m_HDRICache[path];
+        if (resident.Texture)
+            m_Stats.ResidentBytes -= resident.Bytes;
+        else
+            m_Stats.ResidentCount++;
+
+        resident.Texture  = hdri;
+        resident.Bytes    = hdri->GetMemorySize();
+        resident.LastUsed = ++m_UseClock;
+        m_Stats.ResidentBytes += resident.Bytes;
+    }
+
+    void HDRIManager::MakeCurrent(const std::string& path, const Ref<CubemapTexture>& hdri)
+    {
+        if (!hdri)
+            return;
+
+        auto it = m_HDRICache.find(path);
+        if (it != m_HDRICache.end())
+            it->second.LastUsed = ++m_UseClock;
+
+        m_CurrentHDRI = hdri;
+        m_CurrentPath = path;
+        DONUT_INFO("Set current HDRI to: {}", path);
+
+        EvictToBudget();
+        QueuePrefetch();
+    }
+
+    void HDRIManager::SetMemoryBudget(uint64_t bytes)
+    {
+        m_MemoryBudget = bytes;
+        EvictToBudget();
+    }
+
+    void HDRIManager::SetPinned(const std::string& path, bool pinned)
+    {
+        if (pinned)
+            m_PinnedHDRI.insert(path);
+        else
+        {
+            m_PinnedHDRI.erase(path);
+            EvictToBudget();
+        }
+    }
+
+    void HDRIManager::EvictToBudget()
+    {
+        while (m_Stats.ResidentBytes > m_MemoryBudget)
+        {
+            auto victim = m_HDRICache.end();
+            for (auto it = m_HDRICache.begin(); it != m_HDRICache.end(); ++it)
+            {
+                if (it->first == m_CurrentPath || IsPinned(it->first))
+                    continue;
+                if (victim == m_HDRICache.end() || it->second.LastUsed < victim->second.LastUsed)
+                    victim = it;
+            }
+
+            // Whatever is left is current or pinned, so the budget is simply exceeded
+            if (victim == m_HDRICache.end())
+                break;
+
+            DONUT_INFO("Evicting HDRI: {} ({} MB)", victim->first, victim->second.Bytes / (1024 * 1024));
+            m_Stats.ResidentBytes -= victim->second.Bytes;
+            m_Stats.ResidentCount--;
+            m_Stats.Evictions++;
+            RenderThread::Release(victim->second.Texture);
+            m_HDRICache.erase(victim);
+        }
+    }
+
+    void HDRIManager::QueuePrefetch()
+    {
+        m_PrefetchQueue.clear();
+
+        auto current = std::find(m_AvailableHDRI.begin(), m_AvailableHDRI.end(), m_CurrentPath);
+        if (current == m_AvailableHDRI.end() || m_AvailableHDRI.size() < 2)
+            return;
+
+        size_t index = static_cast<size_t>(current - m_AvailableHDRI.begin());
+        size_t count = m_AvailableHDRI.size();
+        m_PrefetchQueue.push_back(m_AvailableHDRI[(index + 1) % count]);
+        m_PrefetchQueue.push_back(m_AvailableHDRI[(index + count - 1) % count]);
+    }
+
+    void HDRIManager::StartNextPrefetch()
+    {
+        while (!m_PrefetchQueue.empty())
+        {
+            std::string path = m_PrefetchQueue.front();
+            m_PrefetchQueue.pop_front();
+
+            if (IsResident(path))
+                continue;
+
+            // Prefetching must never push out something that was actually used
+            uint64_t estimate = m_CurrentHDRI ? m_CurrentHDRI->GetMemorySize() : 0;
+            if (m_Stats.ResidentBytes + estimate > m_MemoryBudget)
+            {
+                m_PrefetchQueue.clear();
+                return;
+            }
+
+            StartLoading(path, true);
+            return;
+        }
     }
 
     std::string HDRIManager::GetHDRIName(const std::string& path) const
@@ -57,8 +362,23 @@ namespace Donut
 
     void HDRIManager::ClearCache()
     {
-        m_HDRICache.clear();
-        m_CurrentHDRI.reset();
+        CancelLoading();
+        m_PrefetchQueue.clear();
+
+        for (auto it = m_HDRICache.begin(); it != m_HDRICache.end();)
+        {
+            if (it->first == m_CurrentPath || IsPinned(it->first))
+            {
+                ++it;
+                continue;
+            }
+
+            m_Stats.ResidentBytes -= it->second.Bytes;
+            m_Stats.ResidentCount--;
+            RenderThread::Release(it->second.Texture);
+            it = m_HDRICache.erase(it);
+        }
+
         DONUT_INFO("HDRI cache cleared");
     }
 };
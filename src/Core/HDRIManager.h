@@ -4,11 +4,25 @@
 #include "Rendering/Texture.h"
 
 #include <string>
+#include <deque>
 #include <unordered_map>
+#include <unordered_set>
 #include <memory>
 
 namespace Donut
 {
+    struct HDRICacheEntry;
+
+    struct HDRIResidencyStats
+    {
+        uint64_t Hits          = 0;
+        uint64_t Misses        = 0;
+        uint64_t Evictions     = 0;
+        uint64_t Prefetches    = 0;
+        uint64_t ResidentBytes = 0;
+        uint32_t ResidentCount = 0;
+    };
+
     class HDRIManager
     {
     public:
@@ -18,12 +32,40 @@ namespace Donut
             return instance;
         }
 
+        static constexpr uint32_t CubemapFaceSize     = 1024;
+        static constexpr uint32_t UploadBytesPerFrame = 8 * 1024 * 1024;
+
         Ref<CubemapTexture> LoadHDRI(const std::string& path);
         Ref<CubemapTexture> GetCurrentHDRI() const { return m_CurrentHDRI; }
         
+        // Maps a cached conversion or decodes on a worker, then uploads from Update();
+        // the current HDRI stays in use until the new cubemap is complete
         void SetCurrentHDRI(const std::string& path);
+        void Update();
+
+        // Background prefetches of neighbouring entries are not reported here
+        bool               IsLoading()          const { return m_Loading && !m_Prefetching; }
+        bool               IsDecoding()         const { return IsLoading() && !m_LoadingTexture; }
+        const std::string& GetLoadingPath()     const { return m_LoadingPath; }
+        float              GetLoadingProgress() const;
+
+        // Prefetches included: Update() issues GL uploads while this is set
+        bool IsUploading() const { return m_LoadingTexture != nullptr; }
+
+        // Resident cubemaps are evicted least recently used first once their total
+        // size exceeds the budget; the current and pinned entries are never evicted
+        void     SetMemoryBudget(uint64_t bytes);
+        uint64_t GetMemoryBudget() const { return m_MemoryBudget; }
+        void     SetPinned(const std::string& path, bool pinned);
+        bool     IsPinned(const std::string& path) const { return m_PinnedHDRI.count(path) > 0; }
+        bool     IsResident(const std::string& path) const { return m_HDRICache.count(path) > 0; }
+
+        const HDRIResidencyStats& GetStats() const { return m_Stats; }
+
         const std::vector<std::string>& GetAvailableHDRI() const { return m_AvailableHDRI; }
         std::string GetHDRIName(const std::string& path)   const;
+
+        // Drops every resident cubemap that is neither current nor pinned
         void ClearCache();
     private:
          HDRIManager() = default;
@@ -32,9 +74,44 @@ namespace Donut
         HDRIManager(const HDRIManager&)            = delete;
         HDRIManager& operator=(const HDRIManager&) = delete;
 
-        std::unordered_map<std::string, Ref<CubemapTexture>> m_HDRICache;
+        static Ref<HDRIImage> DecodeHDRI(const std::string& path);
+        void StartLoading(const std::string& path, bool prefetch);
+        void OnHDRILoaded(const Ref<HDRICacheEntry>& entry, const Ref<HDRIImage>& image, uint64_t sourceHash, uint64_t generation);
+        void CompleteLoading(const Ref<CubemapTexture>& hdri);
+        void StoreInCache(const Ref<CubemapTexture>& hdri, uint64_t sourceHash);
+        void ResetLoading();
+        void CancelLoading();
+
+        void MakeResident(const std::string& path, const Ref<CubemapTexture>& hdri);
+        void MakeCurrent(const std::string& path, const Ref<CubemapTexture>& hdri);
+        void EvictToBudget();
+        void QueuePrefetch();
+        void StartNextPrefetch();
+
+        struct ResidentHDRI
+        {
+            Ref<CubemapTexture> Texture;
+            uint64_t            Bytes    = 0;
+            uint64_t            LastUsed = 0;
+        };
+
+        std::unordered_map<std::string, ResidentHDRI> m_HDRICache;
+        std::unordered_set<std::string>               m_PinnedHDRI;
+        std::deque<std::string>                       m_PrefetchQueue;
         
         Ref<CubemapTexture> m_CurrentHDRI;
+        std::string         m_CurrentPath;
+
+        uint64_t            m_MemoryBudget = 256ull * 1024 * 1024;
+        uint64_t            m_UseClock     = 0;
+        HDRIResidencyStats  m_Stats;
+
+        bool                m_Loading        = false;
+        bool                m_Prefetching    = false;
+        uint64_t            m_LoadGeneration = 0;
+        uint64_t            m_LoadingHash    = 0;
+        std::string         m_LoadingPath;
+        Ref<CubemapTexture> m_LoadingTexture;
         
         std::vector<std::string> m_AvailableHDRI = 
         {
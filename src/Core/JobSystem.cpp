@@ -0,0 +1,319 @@
+#include "JobSystem.h"
+#include "Log.h"
+
+#include <deque>
+#include <thread>
+#include <condition_variable>
+#include <algorithm>
+
+namespace Donut
+{
+    namespace
+    {
+        struct QueuedJob
+        {
+            Job         Function;
+            JobCounter* Counter = nullptr;
+        };
+
+        struct Worker
+        {
+            std::deque<QueuedJob> Queue;
+            std::mutex            Mutex;
+            std::thread           Thread;
+        };
+
+        struct JobSystemData
+        {
+            std::vector<std::unique_ptr<Worker>> Workers;
+            std::atomic<uint32_t>                NextWorker = 0;
+            std::atomic<uint32_t>                QueuedJobs = 0;
+            std::atomic_bool                     Stopping   = false;
+            std::mutex                           SleepMutex;
+            std::condition_variable              WakeCondition;
+
+            std::mutex       MainThreadMutex;
+            std::vector<Job> MainThreadJobs;
+            std::vector<Job> MainThreadScratch;
+        };
+
+        JobSystemData*        s_Data        = nullptr;
+        thread_local int32_t  t_WorkerIndex = -1;
+    }
+
+    static void Enqueue(QueuedJob job)
+    {
+        uint32_t index = t_WorkerIndex >= 0 
+            ? static_cast<uint32_t>(t_WorkerIndex) 
+            : s_Data->NextWorker.fetch_add(1, std::memory_order_relaxed) % s_Data->Workers.size();
+
+        Worker& worker = *s_Data->Workers[index];
+        {
+            std::lock_guard<std::mutex> lock(worker.Mutex);
+            worker.Queue.push_back(std::move(job));
+        }
+
+        // Counted under the sleep mutex, otherwise the notify can land between a worker's
+        // predicate check and its wait and be lost
+        {
+            std::lock_guard<std::mutex> lock(s_Data->SleepMutex);
+            s_Data->QueuedJobs.fetch_add(1, std::memory_order_release);
+        }
+        s_Data->WakeCondition.notify_one();
+    }
+
+    static bool TryPop(QueuedJob& out)
+    {
+        const uint32_t count = static_cast<uint32_t>(s_Data->Workers.size());
+        const uint32_t self  = t_WorkerIndex >= 0 ? static_cast<uint32_t>(t_WorkerIndex) : 0;
+
+        if (t_WorkerIndex >= 0)
+        {
+            Worker& own = *s_Data->Workers[self];
+            std::lock_guard<std::mutex> lock(own.Mutex);
+            if (!own.Queue.empty())
+            {
+                out = std::move(own.Queue.back());
+                own.Queue.pop_back();
+                s_Data->QueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+
+        for (uint32_t offset = 1; offset <= count; ++offset)
+        {
+            Worker& victim = *s_Data->Workers[(self + offset) % count];
+            std::lock_guard<std::mutex> lock(victim.Mutex);
+            if (!victim.Queue.empty())
+            {
+                out = std::move(victim.Queue.front());
+                victim.Queue.pop_front();
+                s_Data->QueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // Takes a queued job of counter only, newest first
+    static bool TryPopFor(const JobCounter* counter, QueuedJob& out)
+    {
+        for (auto& worker : s_Data->Workers)
+        {
+            std::lock_guard<std::mutex> lock(worker->Mutex);
+            auto it = std::find_if(worker->Queue.rbegin(), worker->Queue.rend(),
+                [counter](const QueuedJob& job) { return job.Counter == counter; });
+            if (it == worker->Queue.rend())
+                continue;
+
+            out = std::move(*it);
+            worker->Queue.erase(std::next(it).base());
+            s_Data->QueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        return false;
+    }
+
+    void JobSystem::Complete(JobCounter* counter)
+    {
+        if (!counter)
+            return;
+
+        // The counter is only touched under its mutex so a waiter that observes
+        // zero and then takes the lock knows this thread is finished with it
+        std::vector<Job> continuations;
+        {
+            std::lock_guard<std::mutex> lock(counter->m_Mutex);
+            if (counter->m_Pending.fetch_sub(1, std::memory_order_acq_rel) != 1)
+                return;
+            continuations.swap(counter->m_Continuations);
+        }
+
+        for (auto& job : continuations)
+            job();
+    }
+
+    void JobSystem::WorkerLoop(int32_t index)
+    {
+        t_WorkerIndex = index;
+
+        while (true)
+        {
+            QueuedJob job;
+            if (TryPop(job))
+            {
+                job.Function();
+                Complete(job.Counter);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(s_Data->SleepMutex);
+            if (s_Data->Stopping.load(std::memory_order_acquire) && s_Data->QueuedJobs.load(std::memory_order_acquire) == 0)
+                break;
+
+            s_Data->WakeCondition.wait(lock, []()
+            {
+                return s_Data->QueuedJobs.load(std::memory_order_acquire) > 0 || 
+                       s_Data->Stopping.load(std::memory_order_acquire);
+            });
+        }
+
+        t_WorkerIndex = -1;
+    }
+
+    void JobSystem::Init(uint32_t workerCount)
+    {
+        if (s_Data)
+            return;
+
+        if (workerCount == 0)
+            workerCount = std::max(2u, std::thread::hardware_concurrency()) - 1; // Zero when unknown
+
+        s_Data = new JobSystemData();
+        s_Data->Workers.reserve(workerCount);
+        for (uint32_t i = 0; i < workerCount; ++i)
+            s_Data->Workers.push_back(std::make_unique<Worker>());
+
+        for (uint32_t i = 0; i < workerCount; ++i)
+            s_Data->Workers[i]->Thread = std::thread(WorkerLoop, static_cast<int32_t>(i));
+
+        DONUT_INFO("Job system initialized with {} workers", workerCount);
+    }
+
+    void JobSystem::Shutdown()
+    {
+        if (!s_Data)
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(s_Data->SleepMutex);
+            s_Data->Stopping = true;
+        }
+        s_Data->WakeCondition.notify_all();
+
+        for (auto& worker : s_Data->Workers)
+            worker->Thread.join();
+
+        ProcessMainThreadJobs();
+
+        delete s_Data;
+        s_Data = nullptr;
+    }
+
+    void JobSystem::Run(Job job, JobCounter* counter, JobCounter* dependency)
+    {
+        if (counter)
+            counter->m_Pending.fetch_add(1, std::memory_order_relaxed);
+
+        if (!s_Data)
+        {
+            job();
+            Complete(counter);
+            return;
+        }
+
+        QueuedJob queued = { std::move(job), counter };
+        if (dependency)
+        {
+            std::lock_guard<std::mutex> lock(dependency->m_Mutex);
+            if (!dependency->IsDone())
+            {
+                dependency->m_Continuations.push_back([queued = std::move(queued)]() mutable { Enqueue(std::move(queued)); });
+                return;
+            }
+        }
+
+        Enqueue(std::move(queued));
+    }
+
+    void JobSystem::Wait(JobCounter& counter)
+    {
+        // Only the counter's own jobs are helped with; a physics tick or a frame must not
+        // pick up an HDRI decode or a batch of preview tiles while it waits
+        while (!counter.IsDone())
+        {
+            QueuedJob job;
+            if (s_Data && TryPopFor(&counter, job))
+            {
+                job.Function();
+                Complete(job.Counter);
+            }
+            else
+                std::this_thread::yield();
+        }
+
+        // Wait for the thread that finished the last job to release the counter
+        std::lock_guard<std::mutex> lock(counter.m_Mutex);
+    }
+
+    void JobSystem::ParallelFor(uint32_t count, uint32_t grain, const std::function<void(uint32_t begin, uint32_t end)>& fn)
+    {
+        if (count == 0)
+            return;
+
+        grain = std::max(1u, grain);
+        if (!s_Data || count <= grain)
+        {
+            fn(0, count);
+            return;
+        }
+
+        JobCounter counter;
+        for (uint32_t begin = grain; begin < count; begin += grain)
+        {
+            uint32_t end = std::min(count, begin + grain);
+            Run([&fn, begin, end]() { fn(begin, end); }, &counter);
+        }
+
+        fn(0, grain);
+        Wait(counter);
+    }
+
+    void JobSystem::RunOnMainThread(Job job)
+    {
+        if (!s_Data)
+        {
+            job();
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(s_Data->MainThreadMutex);
+        s_Data->MainThreadJobs.push_back(std::move(job));
+    }
+
+    void JobSystem::ProcessMainThreadJobs()
+    {
+        if (!s_Data)
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(s_Data->MainThreadMutex);
+            s_Data->MainThreadScratch.swap(s_Data->MainThreadJobs);
+        }
+
+        for (auto& job : s_Data->MainThreadScratch)
+            job();
+        s_Data->MainThreadScratch.clear();
+    }
+
+    bool JobSystem::HasMainThreadJobs()
+    {
+        if (!s_Data)
+            return false;
+
+        std::lock_guard<std::mutex> lock(s_Data->MainThreadMutex);
+        return !s_Data->MainThreadJobs.empty();
+    }
+
+    bool JobSystem::IsInitialized()
+    {
+        return s_Data != nullptr;
+    }
+
+    uint32_t JobSystem::GetWorkerCount()
+    {
+        return s_Data ? static_cast<uint32_t>(s_Data->Workers.size()) : 0;
+    }
+};
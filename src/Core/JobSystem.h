@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace Donut
+{
+    using Job = std::function<void()>;
+
+    // Counts outstanding jobs. Jobs scheduled with a dependency counter are held
+    // back until it reaches zero. A counter must outlive every job that references it.
+    class JobCounter
+    {
+    public:
+        bool IsDone() const { return m_Pending.load(std::memory_order_acquire) == 0; }
+    private:
+        friend class JobSystem;
+
+        std::atomic<uint32_t> m_Pending = 0;
+        std::mutex            m_Mutex;
+        std::vector<Job>      m_Continuations;
+    };
+
+    // Work-stealing scheduler: every worker owns a deque it pops from the back,
+    // idle workers steal from the front of the others. Threads that wait on a
+    // counter help run that counter's queued jobs instead of blocking.
+    class JobSystem
+    {
+    public:
+        static void Init(uint32_t workerCount = 0);
+        static void Shutdown();
+
+        static void Run(Job job, JobCounter* counter = nullptr, JobCounter* dependency = nullptr);
+        static void Wait(JobCounter& counter);
+
+        // Splits [0, count) into grain-sized ranges and blocks until all have run
+        static void ParallelFor(uint32_t count, uint32_t grain, const std::function<void(uint32_t begin, uint32_t end)>& fn);
+
+        // Queues work that must run on the main thread, e.g. GL uploads after a decode job.
+        // With a render thread the application processes them there while the main thread waits.
+        static void RunOnMainThread(Job job);
+        static void ProcessMainThreadJobs();
+        static bool HasMainThreadJobs();
+
+        static bool     IsInitialized();
+        static uint32_t GetWorkerCount();
+    private:
+        static void WorkerLoop(int32_t index);
+        static void Complete(JobCounter* counter);
+    };
+};
@@ -1,6 +1,8 @@
 #include "Log.h"
 
 #include <filesystem>
+#include <cstdio>
+#include <ctime>
 
 #if defined(DONUT_WINDOWS)
     #include <windows.h>
@@ -18,13 +20,13 @@ namespace Donut
         s_Logger->EnableFileOutput(true);
         s_Logger->SetLogFile("logs/donut.log");
         
-        s_Logger->LogMessage(LogLevel::INFO, "Logging system initialized");
+        s_Logger->LogMessage(LogLevel::INFO, 0, "Logging system initialized");
     }
 
     void Logger::Shutdown()
     {
         if (s_Logger)
-            s_Logger->LogMessage(LogLevel::INFO, "Shutting down logging system");
+            s_Logger->LogMessage(LogLevel::INFO, 0, "Shutting down logging system");
         s_Logger.reset();
     }
 
@@ -33,13 +35,45 @@ namespace Donut
         return s_Logger;
     }
 
+    bool LogRateLimiter::Allow(uint32_t& suppressed)
+    {
+        int64_t now   = std::chrono::duration_cast<std::chrono::milliseconds>(
+                            std::chrono::steady_clock::now().time_since_epoch()).count();
+        int64_t start = m_WindowStart.load(std::memory_order_relaxed);
+        if (now - start >= 1000 && m_WindowStart.compare_exchange_strong(start, now, std::memory_order_relaxed))
+            m_Count.store(0, std::memory_order_relaxed);
+
+        if (m_Count.fetch_add(1, std::memory_order_relaxed) < m_MaxPerSecond)
+        {
+            suppressed = m_Suppressed.exchange(0, std::memory_order_relaxed);
+            return true;
+        }
+
+        m_Suppressed.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
     Logger::Logger()
         : m_LogLevel(LogLevel::INFO), 
           m_ConsoleOutput(true), 
-          m_FileOutput(false) { }
+          m_FileOutput(false)
+    {
+        m_Ring = std::make_unique<Slot[]>(RingCapacity);
+        for (size_t i = 0; i < RingCapacity; ++i)
+            m_Ring[i].Sequence.store(i, std::memory_order_relaxed);
+
+        m_Writer = std::thread(&Logger::WriterLoop, this);
+    }
 
     Logger::~Logger() 
     {
+        {
+            std::lock_guard<std::mutex> lock(m_WriterMutex);
+            m_StopWriter = true;
+        }
+        m_WriterCondition.notify_one();
+        m_Writer.join();
+
         if (m_LogFile.is_open())
             m_LogFile.close();
     }
@@ -54,6 +88,203 @@ namespace Donut
             std::cerr << "Failed to open log file: " << filename << std::endl;
     }
 
+    void Logger::Flush()
+    {
+        size_t target = m_EnqueuePosition.load(std::memory_order_acquire);
+        m_WriterCondition.notify_one();
+        while (m_DequeuePosition.load(std::memory_order_acquire) < target)
+            std::this_thread::yield();
+    }
+
+    LogRecord* Logger::ClaimRecord(size_t& position)
+    {
+        position = m_EnqueuePosition.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Slot&    slot     = m_Ring[position & (RingCapacity - 1)];
+            size_t   sequence = slot.Sequence.load(std::memory_order_acquire);
+            intptr_t diff     = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+            if (diff == 0)
+            {
+                if (m_EnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    return &slot.Record;
+            }
+            else if (diff < 0)
+                return nullptr;
+            else
+                position = m_EnqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    void Logger::CommitRecord(size_t position, bool urgent)
+    {
+        m_Ring[position & (RingCapacity - 1)].Sequence.store(position + 1, std::memory_order_release);
+        if (urgent)
+            m_WriterCondition.notify_one();
+    }
+
+    bool Logger::DrainBatch()
+    {
+        bool   wroteAny = false;
+        size_t position = m_DequeuePosition.load(std::memory_order_relaxed);
+        m_FileBatch.clear();
+
+        uint64_t dropped = m_Dropped.exchange(0, std::memory_order_relaxed);
+        if (dropped > 0)
+        {
+            m_Line = GetTimeStamp() + " [WARN] " + std::to_string(dropped) + " log messages dropped, ring buffer full";
+            if (m_ConsoleOutput)
+            {
+                SetConsoleColor(LogLevel::WARN);
+                std::cout << m_Line << '\n';
+                ResetConsoleColor();
+            }
+            m_FileBatch.append(m_Line).push_back('\n');
+            wroteAny = true;
+        }
+
+        while (true)
+        {
+            Slot& slot = m_Ring[position & (RingCapacity - 1)];
+            if (slot.Sequence.load(std::memory_order_acquire) != position + 1)
+                break;
+
+            FormatRecord(slot.Record, m_Line);
+            LogLevel level = slot.Record.Level;
+
+            slot.Sequence.store(position + RingCapacity, std::memory_order_release);
+            position++;
+
+            if (m_ConsoleOutput)
+            {
+#if defined(DONUT_WINDOWS)
+                std::cout.flush();
+#endif
+                SetConsoleColor(level);
+                std::cout << m_Line << '\n';
+                ResetConsoleColor();
+            }
+
+            m_FileBatch.append(m_Line).push_back('\n');
+            wroteAny = true;
+        }
+
+        if (wroteAny)
+        {
+            if (m_ConsoleOutput)
+                std::cout.flush();
+
+            if (m_FileOutput && m_LogFile.is_open())
+            {
+                m_LogFile.write(m_FileBatch.data(), static_cast<std::streamsize>(m_FileBatch.size()));
+                m_LogFile.flush();
+            }
+        }
+
+        m_DequeuePosition.store(position, std::memory_order_release);
+        return wroteAny;
+    }
+
+    void Logger::FormatRecord(const LogRecord& record, std::string& out)
+    {
+        int64_t second = record.Timestamp / 1000000;
+        if (second != m_CachedSecond)
+        {
+            std::time_t time = static_cast<std::time_t>(second);
+            std::stringstream ss;
+            ss << std::put_time(std::localtime(&time), "%Y-%m-%d %H:%M:%S");
+            m_CachedTimeStamp = ss.str();
+            m_CachedSecond    = second;
+        }
+
+        out = m_CachedTimeStamp;
+        out += " [";
+        out += GetLogLevelString(record.Level);
+        out += "] ";
+
+        std::string_view format(record.Format, record.FormatLength);
+        const char* cursor  = record.Payload;
+        uint8_t     argsLeft = record.ArgCount;
+        char        number[64];
+
+        size_t start = 0;
+        while (true)
+        {
+            size_t pos = format.find("{}", start);
+            if (pos == std::string_view::npos || argsLeft == 0)
+            {
+                out.append(format.substr(start));
+                break;
+            }
+
+            out.append(format.substr(start, pos - start));
+            start = pos + 2;
+            argsLeft--;
+
+            auto type = static_cast<LogRecord::ArgType>(*cursor++);
+            switch (type)
+            {
+            case LogRecord::ArgType::Int:
+            {
+                int64_t value;
+                std::memcpy(&value, cursor, sizeof(value));
+                cursor += sizeof(value);
+                out += std::to_string(value);
+                break;
+            }
+            case LogRecord::ArgType::UInt:
+            {
+                uint64_t value;
+                std::memcpy(&value, cursor, sizeof(value));
+                cursor += sizeof(value);
+                out += std::to_string(value);
+                break;
+            }
+            case LogRecord::ArgType::Float:
+            {
+                double value;
+                std::memcpy(&value, cursor, sizeof(value));
+                cursor += sizeof(value);
+                std::snprintf(number, sizeof(number), "%g", value);
+                out += number;
+                break;
+            }
+            case LogRecord::ArgType::Bool:
+                out += *cursor++ ? "1" : "0";
+                break;
+            case LogRecord::ArgType::String:
+            {
+                uint16_t length;
+                std::memcpy(&length, cursor, sizeof(length));
+                cursor += sizeof(length);
+                out.append(cursor, length);
+                cursor += length;
+                break;
+            }
+            }
+        }
+
+        if (record.Suppressed > 0)
+            out += " (" + std::to_string(record.Suppressed) + " similar messages suppressed)";
+    }
+
+    void Logger::WriterLoop()
+    {
+        while (true)
+        {
+            if (DrainBatch())
+                continue;
+
+            std::unique_lock<std::mutex> lock(m_WriterMutex);
+            if (m_StopWriter)
+                break;
+            m_WriterCondition.wait_for(lock, std::chrono::milliseconds(10));
+        }
+
+        DrainBatch();
+    }
+
     std::string Logger::GetTimeStamp() 
     {
         auto now = std::chrono::system_clock::now();
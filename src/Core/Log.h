@@ -4,13 +4,19 @@
 
 #include <string>
 #include <vector>
+#include <algorithm>
 #include <sstream>
 #include <iostream>
 #include <fstream>
 #include <chrono>
 #include <iomanip>
 #include <mutex>
+#include <atomic>
+#include <thread>
+#include <cstring>
+#include <condition_variable>
 #include <string_view>
+#include <type_traits>
 
 namespace Donut
 {
@@ -23,7 +29,107 @@ namespace Donut
         FATAL = 5
     };
 
-    class Logger 
+    // A format string the logging thread may read after the call returns. The
+    // constructor is consteval, so only string literals and other character arrays
+    // whose address is a constant (static storage) convert; a std::string, a
+    // string_view or a local buffer fails to compile instead of dangling.
+    struct LogFormat
+    {
+        template<size_t N>
+        consteval LogFormat(const char (&format)[N])
+            : Data(format), Length(static_cast<uint32_t>(N - 1)) { }
+
+        const char* Data;
+        uint32_t    Length;
+    };
+
+    // Fixed-size entry handed from producers to the logging thread. Arguments are
+    // serialised as tagged values; the format is referenced rather than copied,
+    // which LogFormat makes safe.
+    struct LogRecord
+    {
+        static constexpr uint32_t PayloadCapacity = 200;
+
+        enum class ArgType : uint8_t { Int, UInt, Float, Bool, String };
+
+        int64_t     Timestamp    = 0; // Microseconds since the system clock epoch
+        const char* Format       = nullptr;
+        uint32_t    FormatLength = 0;
+        uint32_t    Suppressed   = 0; // Messages dropped by the call site's rate limiter
+        LogLevel    Level        = LogLevel::INFO;
+        uint8_t     ArgCount     = 0;
+        uint16_t    PayloadSize  = 0;
+        char        Payload[PayloadCapacity];
+
+        template<typename T>
+        void PushArg(const T& value)
+        {
+            using Type = std::decay_t<T>;
+
+            if constexpr (std::is_same_v<Type, bool>)
+                PushValue(ArgType::Bool, static_cast<uint8_t>(value));
+            else if constexpr (std::is_same_v<Type, char>)
+                PushString(std::string_view(&value, 1));
+            else if constexpr (std::is_integral_v<Type> && std::is_signed_v<Type>)
+                PushValue(ArgType::Int, static_cast<int64_t>(value));
+            else if constexpr (std::is_integral_v<Type>)
+                PushValue(ArgType::UInt, static_cast<uint64_t>(value));
+            else if constexpr (std::is_floating_point_v<Type>)
+                PushValue(ArgType::Float, static_cast<double>(value));
+            else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+                PushString(std::string_view(value));
+            else
+            {
+                std::ostringstream ss;
+                ss << value;
+                PushString(ss.str());
+            }
+        }
+    private:
+        template<typename V>
+        void PushValue(ArgType type, V value)
+        {
+            if (PayloadSize + 1 + sizeof(V) > PayloadCapacity)
+                return;
+
+            Payload[PayloadSize++] = static_cast<char>(type);
+            std::memcpy(Payload + PayloadSize, &value, sizeof(V));
+            PayloadSize += sizeof(V);
+            ArgCount++;
+        }
+
+        void PushString(std::string_view value)
+        {
+            if (PayloadSize + 1 + sizeof(uint16_t) > PayloadCapacity)
+                return;
+
+            uint16_t length = static_cast<uint16_t>(std::min<size_t>(value.size(), PayloadCapacity - PayloadSize - 1 - sizeof(uint16_t)));
+            Payload[PayloadSize++] = static_cast<char>(ArgType::String);
+            std::memcpy(Payload + PayloadSize, &length, sizeof(length));
+            PayloadSize += sizeof(length);
+            std::memcpy(Payload + PayloadSize, value.data(), length);
+            PayloadSize += length;
+            ArgCount++;
+        }
+    };
+
+    // Allows at most maxPerSecond messages per window from one call site
+    class LogRateLimiter
+    {
+    public:
+        explicit LogRateLimiter(uint32_t maxPerSecond) : m_MaxPerSecond(maxPerSecond) { }
+
+        bool Allow(uint32_t& suppressed);
+    private:
+        uint32_t              m_MaxPerSecond;
+        std::atomic<int64_t>  m_WindowStart = 0;
+        std::atomic<uint32_t> m_Count       = 0;
+        std::atomic<uint32_t> m_Suppressed  = 0;
+    };
+
+    // Producers serialise records into a bounded multi-producer/single-consumer
+    // ring; a background thread formats and writes them in batches.
+    class Logger
     {
     public:
         static void Init();
@@ -32,95 +138,82 @@ namespace Donut
         static Ref<Logger> GetLogger();
 
         template<typename... Args>
-        static void Trace(const std::string_view& format, const Args&... args) 
+        static void Trace(LogFormat format, const Args&... args)
+        {
+            Log(LogLevel::TRACE, 0, format, args...);
+        }
+
+        template<typename... Args>
+        static void Info(LogFormat format, const Args&... args)
         {
-            auto logger = GetLogger();
-            if (logger) logger->LogMessage(LogLevel::TRACE, format, args...);
+            Log(LogLevel::INFO, 0, format, args...);
         }
 
         template<typename... Args>
-        static void Info(const std::string_view& format, const Args&... args) 
+        static void Warn(LogFormat format, const Args&... args)
         {
-            auto logger = GetLogger();
-            if (logger) logger->LogMessage(LogLevel::INFO, format, args...);
+            Log(LogLevel::WARN, 0, format, args...);
         }
 
         template<typename... Args>
-        static void Warn(const std::string_view& format, const Args&... args) 
+        static void Error(LogFormat format, const Args&... args)
         {
-            auto logger = GetLogger();
-            if (logger) logger->LogMessage(LogLevel::WARN, format, args...);
+            Log(LogLevel::ERR, 0, format, args...);
         }
 
         template<typename... Args>
-        static void Error(const std::string_view& format, const Args&... args) 
+        static void Fatal(LogFormat format, const Args&... args)
         {
-            auto logger = GetLogger();
-            if (logger) logger->LogMessage(LogLevel::ERR, format, args...);
+            Log(LogLevel::FATAL, 0, format, args...);
         }
 
         template<typename... Args>
-        static void Fatal(const std::string_view& format, const Args&... args) 
+        static void Log(LogLevel level, uint32_t suppressed, LogFormat format, const Args&... args)
         {
-            auto logger = GetLogger();
-            if (logger) logger->LogMessage(LogLevel::FATAL, format, args...);
+            Logger* logger = s_Logger.get();
+            if (logger) logger->LogMessage(level, suppressed, format, args...);
         }
 
         template<typename... Args>
-        void LogMessage(LogLevel level, const std::string_view& format, const Args&... args) 
+        void LogMessage(LogLevel level, uint32_t suppressed, LogFormat format, const Args&... args)
         {
-            if (level < m_LogLevel) 
+            if (level < m_LogLevel)
                 return;
 
-            std::lock_guard<std::mutex> lock(m_Mutex);
-            std::string message = FormatString(format, args...);
-            std::string fullMessage = GetTimeStamp() + " [" + GetLogLevelString(level) + "] " + message;
-            
-            if (m_ConsoleOutput) 
-            {
-                SetConsoleColor(level);
-                std::cout << fullMessage << std::endl;
-                ResetConsoleColor();
-            }
-            
-            if (m_FileOutput && m_LogFile.is_open()) 
+            // A full ring drops chatter but makes warnings and errors wait for space
+            size_t position;
+            LogRecord* record = ClaimRecord(position);
+            while (!record && level >= LogLevel::WARN)
             {
-                m_LogFile << fullMessage << std::endl;
-                m_LogFile.flush();
+                m_WriterCondition.notify_one();
+                std::this_thread::yield();
+                record = ClaimRecord(position);
             }
-        }
 
-        template<typename... Args>
-        std::string FormatString(const std::string_view& format, const Args&... args)
-        {
-            std::string result = format.data();
-            std::vector<std::string> argStrings = { ToString(args)... };
-            
-            size_t argIndex = 0;
-            size_t pos = 0;
-            
-            while ((pos = result.find("{}", pos)) != std::string::npos && argIndex < argStrings.size())
+            if (!record)
             {
-                result.replace(pos, 2, argStrings[argIndex]);
-                pos += argStrings[argIndex].length();
-                argIndex++;
+                m_Dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
             }
-            
-            return result;
-        }
 
-        template<typename T>
-        std::string ToString(const T& value)
-        {
-            std::stringstream ss;
-            ss << value;
-            return ss.str();
+            record->Timestamp    = std::chrono::duration_cast<std::chrono::microseconds>(
+                                       std::chrono::system_clock::now().time_since_epoch()).count();
+            record->Format       = format.Data;
+            record->FormatLength = format.Length;
+            record->Suppressed   = suppressed;
+            record->Level        = level;
+            record->ArgCount     = 0;
+            record->PayloadSize  = 0;
+            (record->PushArg(args), ...);
+
+            CommitRecord(position, level >= LogLevel::WARN);
         }
 
         void SetLogLevel(LogLevel level)      { m_LogLevel      = level;  }
         void EnableConsoleOutput(bool enable) { m_ConsoleOutput = enable; }
         void EnableFileOutput(bool enable)    { m_FileOutput    = enable; }
         void SetLogFile(const std::string& filename);
+        void Flush();
     public:
         Logger();
         ~Logger();
@@ -130,26 +223,91 @@ namespace Donut
         void SetConsoleColor(LogLevel level);
         void ResetConsoleColor();
     private:
-        LogLevel      m_LogLevel;
-        bool          m_ConsoleOutput;
-        bool          m_FileOutput;
-        std::ofstream m_LogFile;
-        std::mutex    m_Mutex;
+        struct Slot
+        {
+            std::atomic<size_t> Sequence;
+            LogRecord           Record;
+        };
+
+        static constexpr size_t RingCapacity = 4096;
+
+        LogRecord* ClaimRecord(size_t& position);
+        void       CommitRecord(size_t position, bool urgent);
+        bool       DrainBatch();
+        void       FormatRecord(const LogRecord& record, std::string& out);
+        void       WriterLoop();
+    private:
+        std::atomic<LogLevel> m_LogLevel;
+        bool                  m_ConsoleOutput;
+        bool                  m_FileOutput;
+        std::ofstream         m_LogFile;
+
+        std::unique_ptr<Slot[]> m_Ring;
+        std::atomic<size_t>     m_EnqueuePosition = 0;
+        std::atomic<size_t>     m_DequeuePosition = 0;
+        std::atomic<uint64_t>   m_Dropped         = 0;
+
+        std::thread             m_Writer;
+        std::atomic_bool        m_StopWriter = false;
+        std::mutex              m_WriterMutex;
+        std::condition_variable m_WriterCondition;
+        std::string             m_Line;
+        std::string             m_FileBatch;
+        int64_t                 m_CachedSecond = -1;
+        std::string             m_CachedTimeStamp;
 
         static Ref<Logger> s_Logger;
     };
 }
 
-#if defined(DONUT_DEBUG)
-    #define DONUT_TRACE(format, ...)    ::Donut::Logger::Trace(format, ##__VA_ARGS__)
-    #define DONUT_INFO(format, ...)     ::Donut::Logger::Info(format, ##__VA_ARGS__)
-    #define DONUT_WARN(format, ...)     ::Donut::Logger::Warn(format, ##__VA_ARGS__)
-    #define DONUT_ERROR(format, ...)    ::Donut::Logger::Error(format, ##__VA_ARGS__)
-    #define DONUT_FATAL(format, ...)    ::Donut::Logger::Fatal(format, ##__VA_ARGS__)
+// Levels below DONUT_LOG_MIN_LEVEL (numeric LogLevel value) are compiled out entirely
+#ifndef DONUT_LOG_MIN_LEVEL
+    #define DONUT_LOG_MIN_LEVEL 0
+#endif
+
+#define DONUT_LOG_LIMITED(level, perSecond, format, ...)                                                    \
+    do                                                                                                      \
+    {                                                                                                       \
+        static ::Donut::LogRateLimiter donutRateLimiter(perSecond);                                         \
+        uint32_t donutSuppressed = 0;                                                                       \
+        if (donutRateLimiter.Allow(donutSuppressed))                                                        \
+            ::Donut::Logger::Log(level, donutSuppressed, format, ##__VA_ARGS__);                            \
+    } while (0)
+
+#if defined(DONUT_DEBUG) && DONUT_LOG_MIN_LEVEL <= 0
+    #define DONUT_TRACE(format, ...)                    ::Donut::Logger::Trace(format, ##__VA_ARGS__)
+    #define DONUT_TRACE_LIMITED(perSecond, format, ...) DONUT_LOG_LIMITED(::Donut::LogLevel::TRACE, perSecond, format, ##__VA_ARGS__)
+#else
+    #define DONUT_TRACE(format, ...)                    {}
+    #define DONUT_TRACE_LIMITED(perSecond, format, ...) {}
+#endif
+
+#if defined(DONUT_DEBUG) && DONUT_LOG_MIN_LEVEL <= 2
+    #define DONUT_INFO(format, ...)                     ::Donut::Logger::Info(format, ##__VA_ARGS__)
+    #define DONUT_INFO_LIMITED(perSecond, format, ...)  DONUT_LOG_LIMITED(::Donut::LogLevel::INFO, perSecond, format, ##__VA_ARGS__)
+#else
+    #define DONUT_INFO(format, ...)                     {}
+    #define DONUT_INFO_LIMITED(perSecond, format, ...)  {}
+#endif
+
+#if defined(DONUT_DEBUG) && DONUT_LOG_MIN_LEVEL <= 3
+    #define DONUT_WARN(format, ...)                     ::Donut::Logger::Warn(format, ##__VA_ARGS__)
+    #define DONUT_WARN_LIMITED(perSecond, format, ...)  DONUT_LOG_LIMITED(::Donut::LogLevel::WARN, perSecond, format, ##__VA_ARGS__)
+#else
+    #define DONUT_WARN(format, ...)                     {}
+    #define DONUT_WARN_LIMITED(perSecond, format, ...)  {}
+#endif
+
+#if defined(DONUT_DEBUG) && DONUT_LOG_MIN_LEVEL <= 4
+    #define DONUT_ERROR(format, ...)                    ::Donut::Logger::Error(format, ##__VA_ARGS__)
+    #define DONUT_ERROR_LIMITED(perSecond, format, ...) DONUT_LOG_LIMITED(::Donut::LogLevel::ERR, perSecond, format, ##__VA_ARGS__)
+#else
+    #define DONUT_ERROR(format, ...)                    {}
+    #define DONUT_ERROR_LIMITED(perSecond, format, ...) {}
+#endif
+
+#if defined(DONUT_DEBUG) && DONUT_LOG_MIN_LEVEL <= 5
+    #define DONUT_FATAL(format, ...)                    ::Donut::Logger::Fatal(format, ##__VA_ARGS__)
 #else
-    #define DONUT_TRACE(format, ...)    {}
-    #define DONUT_INFO(format, ...)     {}
-    #define DONUT_WARN(format, ...)     {}
-    #define DONUT_ERROR(format, ...)    {}
-    #define DONUT_FATAL(format, ...)    {}
-#endif
\ No newline at end of file
+    #define DONUT_FATAL(format, ...)                    {}
+#endif
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Donut
+{
+    // Read-only view of a whole file; the pointer stays valid until Close() or destruction
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile&)            = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        bool Open(const std::string& path);
+        void Close();
+
+        const uint8_t* GetData() const { return m_Data;            }
+        size_t         GetSize() const { return m_Size;            }
+        bool           IsOpen()  const { return m_Data != nullptr; }
+    private:
+        const uint8_t* m_Data = nullptr;
+        size_t         m_Size = 0;
+
+#if defined(DONUT_WINDOWS)
+        void* m_File    = nullptr;
+        void* m_Mapping = nullptr;
+#endif
+    };
+};
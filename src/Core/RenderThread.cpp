@@ -0,0 +1,200 @@
+#include "RenderThread.h"
+#include "BoundedQueue.h"
+#include "Window.h"
+#include "Log.h"
+
+#include "Rendering/Renderer.h"
+
+#include <GLFW/glfw3.h>
+
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Donut
+{
+    namespace
+    {
+        // A submitted frame, or a task from Execute() when Packet is null
+        struct RenderWork
+        {
+            Scope<FramePacket>           Packet;
+            const std::function<void()>* Task = nullptr;
+            std::promise<void>*          Done = nullptr;
+        };
+
+        struct RenderThreadData
+        {
+            std::thread              Thread;
+            std::thread::id          ThreadID;
+            BoundedQueue<RenderWork> Queue { 1 };
+
+            std::mutex               ReleaseMutex;
+            std::vector<Ref<void>>   Released;
+        };
+
+        RenderThreadData* s_Data         = nullptr;
+        Window*           s_Window       = nullptr;
+        int               s_SwapInterval = -1;
+
+        std::mutex        s_StatsMutex;
+        RenderThreadStats s_Stats;
+    }
+
+    void RenderThread::Init(Window& window, bool threaded)
+    {
+        s_Window = &window;
+        if (!threaded)
+            return;
+
+        // The context can only be current on one thread at a time
+        glfwMakeContextCurrent(nullptr);
+
+        s_Data = new RenderThreadData();
+        s_Data->Thread   = std::thread(&RenderThread::Run);
+        s_Data->ThreadID = s_Data->Thread.get_id();
+
+        DONUT_INFO("Render thread started");
+    }
+
+    void RenderThread::Shutdown()
+    {
+        if (s_Data)
+        {
+            s_Data->Queue.Close();
+            s_Data->Thread.join();
+
+            delete s_Data;
+            s_Data = nullptr;
+
+            // Shutdown still deletes GL objects from the main thread
+            glfwMakeContextCurrent(static_cast<GLFWwindow*>(s_Window->GetNativeWindow()));
+            DONUT_INFO("Render thread stopped");
+        }
+
+        s_Window = nullptr;
+    }
+
+    bool RenderThread::IsRunning()
+    {
+        return s_Data != nullptr;
+    }
+
+    bool RenderThread::IsRenderThread()
+    {
+        return !s_Data || std::this_thread::get_id() == s_Data->ThreadID;
+    }
+
+    void RenderThread::Submit(Scope<FramePacket> packet)
+    {
+        if (!s_Data)
+        {
+            RenderPacket(*packet);
+            return;
+        }
+
+        double start = glfwGetTime();
+        s_Data->Queue.Push({ std::move(packet) });
+
+        std::lock_guard<std::mutex> lock(s_StatsMutex);
+        s_Stats.SubmitWait = (glfwGetTime() - start) * 1000.0;
+    }
+
+    void RenderThread::Execute(const std::function<void()>& fn)
+    {
+        if (IsRenderThread())
+        {
+            fn();
+            return;
+        }
+
+        std::promise<void> done;
+        std::future<void>  finished = done.get_future();
+        s_Data->Queue.Push({ nullptr, &fn, &done });
+        finished.wait();
+    }
+
+    void RenderThread::Release(Ref<void> resource)
+    {
+        if (IsRenderThread())
+            return;
+
+        std::lock_guard<std::mutex> lock(s_Data->ReleaseMutex);
+        s_Data->Released.push_back(std::move(resource));
+    }
+
+    RenderThreadStats RenderThread::GetStats()
+    {
+        std::lock_guard<std::mutex> lock(s_StatsMutex);
+        return s_Stats;
+    }
+
+    void RenderThread::Run()
+    {
+        glfwMakeContextCurrent(static_cast<GLFWwindow*>(s_Window->GetNativeWindow()));
+
+        while (RenderWork* work = s_Data->Queue.WaitFront())
+        {
+            if (work->Packet)
+                RenderPacket(*work->Packet);
+            else
+            {
+                ReleaseResources();
+                (*work->Task)();
+            }
+
+            // Popping destroys the packet here, so whatever its commands captured is released with the context current
+            std::promise<void>* done = work->Done;
+            s_Data->Queue.Pop();
+            if (done)
+                done->set_value();
+        }
+
+        ReleaseResources();
+        glfwMakeContextCurrent(nullptr);
+    }
+
+    void RenderThread::RenderPacket(FramePacket& packet)
+    {
+        double start = glfwGetTime();
+        if (s_Data)
+            ReleaseResources();
+
+        int swapInterval = packet.Graphics.vSyncEnabled ? 1 : 0;
+        if (swapInterval != s_SwapInterval)
+        {
+            glfwSwapInterval(swapInterval);
+            s_SwapInterval = swapInterval;
+        }
+
+        for (auto& command : packet.Commands)
+            command();
+
+        RenderCommand::Present();
+        s_Window->RenderImGui(packet.UI.Get());
+        s_Window->SwapBuffers();
+
+        double end = glfwGetTime();
+
+        std::lock_guard<std::mutex> lock(s_StatsMutex);
+        s_Stats.FramesRendered++;
+        s_Stats.RenderTime = (end - start) * 1000.0;
+        if (packet.InputTime > 0.0)
+        {
+            s_Stats.LastLatency    = (end - packet.InputTime) * 1000.0;
+            s_Stats.AverageLatency = s_Stats.AverageLatency > 0.0
+                                   ? s_Stats.AverageLatency * 0.9 + s_Stats.LastLatency * 0.1
+                                   : s_Stats.LastLatency;
+        }
+    }
+
+    void RenderThread::ReleaseResources()
+    {
+        std::vector<Ref<void>> released;
+        {
+            std::lock_guard<std::mutex> lock(s_Data->ReleaseMutex);
+            released.swap(s_Data->Released);
+        }
+    }
+};
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Core/FramePacket.h"
+#include "Core/Memory.h"
+
+#include <cstdint>
+#include <functional>
+
+namespace Donut
+{
+    class Window;
+
+    struct RenderThreadStats
+    {
+        uint64_t FramesRendered = 0;
+
+        // Milliseconds from the oldest input event a frame carried to its buffer swap
+        double LastLatency    = 0.0;
+        double AverageLatency = 0.0;
+
+        // Milliseconds the render thread spent on the last frame, and the main thread
+        // spent blocked submitting it because the previous one had not finished
+        double RenderTime = 0.0;
+        double SubmitWait = 0.0;
+    };
+
+    // Presents FramePackets built by the main thread. Threaded, a dedicated thread owns
+    // the window's GL context, replays each packet's commands, draws its UI and swaps.
+    // A packet keeps its queue slot until it has been presented, so the main thread
+    // simulates at most one frame ahead. Otherwise every call runs inline.
+    class RenderThread
+    {
+    public:
+        static void Init(Window& window, bool threaded);
+        static void Shutdown();
+
+        static bool IsRunning();
+
+        // True on the thread that may issue GL calls right now
+        static bool IsRenderThread();
+
+        // Blocks while the previous packet is still in flight
+        static void Submit(Scope<FramePacket> packet);
+
+        // Runs fn on the render thread after every packet already submitted and waits for
+        // it, so fn may also use main-thread state. For GL work outside a frame: state
+        // changes, resizes, uploads, readbacks.
+        static void Execute(const std::function<void()>& fn);
+
+        // Drops a reference on the render thread, so the GL objects it owns are deleted
+        // where the context is current
+        static void Release(Ref<void> resource);
+
+        static RenderThreadStats GetStats();
+    private:
+        static void Run();
+        static void RenderPacket(FramePacket& packet);
+        static void ReleaseResources();
+    };
+};
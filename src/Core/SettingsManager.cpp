@@ -6,18 +6,47 @@
 #include <fstream>
 #include <filesystem>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <condition_variable>
 
 namespace Donut
 {
     Settings SettingsManager::s_Settings;
     bool     SettingsManager::s_Initialized = false;
 
+    namespace
+    {
+        constexpr auto SaveQuietPeriod = std::chrono::milliseconds(500);
+
+        std::mutex            s_SettingsMutex;
+        std::atomic<uint64_t> s_Version      = 0;
+        std::atomic<uint64_t> s_SavedVersion = 0;
+
+        std::thread                           s_SaverThread;
+        std::mutex                            s_SaverMutex;
+        std::condition_variable               s_SaverCondition;
+        std::chrono::steady_clock::time_point s_LastChange;
+        bool                                  s_StopSaver = false;
+
+        std::mutex                                         s_ListenerMutex;
+        std::vector<std::pair<uint32_t, SettingsListener>> s_Listeners;
+        uint32_t                                           s_NextListenerID = 1;
+    }
+
     void SettingsManager::Initialize()
     {
         if (s_Initialized)
             return;
             
         LoadSettings();
+
+        s_StopSaver   = false;
+        s_SaverThread = std::thread(&SettingsManager::SaverLoop);
+
         s_Initialized = true;
         DONUT_INFO("Settings Manager initialized");
     }
@@ -27,7 +56,14 @@ namespace Donut
         if (!s_Initialized)
             return;
             
-        SaveSettings();
+        {
+            std::lock_guard<std::mutex> lock(s_SaverMutex);
+            s_StopSaver = true;
+        }
+        s_SaverCondition.notify_one();
+        s_SaverThread.join();
+
+        FlushPendingSave();
         s_Initialized = false;
         DONUT_INFO("Settings Manager shutdown");
     }
@@ -46,6 +82,7 @@ namespace Donut
                 {
                     auto sim = config["simulation"];
                     s_Settings.simulation.targetFPS         = toml::find_or(sim, "target_fps",          60);
+                    s_Settings.simulation.physicsRate       = toml::find_or(sim, "physics_rate",        60);
                     s_Settings.simulation.computeHeight     = toml::find_or(sim, "compute_height",      512);
                     s_Settings.simulation.maxStepsMoving    = toml::find_or(sim, "max_steps_moving",    30000);
                     s_Settings.simulation.maxStepsStatic    = toml::find_or(sim, "max_steps_static",    15000);
@@ -58,6 +95,7 @@ namespace Donut
                     s_Settings.simulation.glowIntensity     = toml::find_or(sim, "glow_intensity",      0.1f);
                     
                     s_Settings.simulation.targetFPS         = std::max(30,    std::min(120,   s_Settings.simulation.targetFPS));
+                    s_Settings.simulation.physicsRate       = std::max(10,    std::min(1000,  s_Settings.simulation.physicsRate));
                     s_Settings.simulation.computeHeight     = std::max(64,    std::min(2048,  s_Settings.simulation.computeHeight));
                     s_Settings.simulation.maxStepsMoving    = std::max(1000,  std::min(60000, s_Settings.simulation.maxStepsMoving));
                     s_Settings.simulation.maxStepsStatic    = std::max(1000,  std::min(30000, s_Settings.simulation.maxStepsStatic));
@@ -79,14 +117,17 @@ namespace Donut
                     s_Settings.graphics.showDebugInfo          = toml::find_or(gfx, "show_debug_info",          false);
                     s_Settings.graphics.enableAntiAliasing     = toml::find_or(gfx, "enable_anti_aliasing",     true);
                     s_Settings.graphics.selectedTheme          = toml::find_or(gfx, "selected_theme",           std::string("Dark"));
+                    s_Settings.graphics.hdriCacheBudgetMB      = toml::find_or(gfx, "hdri_cache_budget_mb",     256);
                     
                     if (s_Settings.graphics.renderAPI != "OpenGL" && 
-                        s_Settings.graphics.renderAPI != "Vulkan")
+                        s_Settings.graphics.renderAPI != "Vulkan" &&
+                        s_Settings.graphics.renderAPI != "Software")
                         s_Settings.graphics.renderAPI = "OpenGL";
                     if (s_Settings.graphics.selectedTheme != "Dark" && 
                         s_Settings.graphics.selectedTheme != "Light" && 
                         s_Settings.graphics.selectedTheme != "Blue")
                         s_Settings.graphics.selectedTheme = "Dark";
+                    s_Settings.graphics.hdriCacheBudgetMB = std::max(64, std::min(16384, s_Settings.graphics.hdriCacheBudgetMB));
                 }
                 
                 DONUT_INFO("Settings loaded from {}", filePath);
@@ -106,6 +147,20 @@ namespace Donut
     }
 
     void SettingsManager::SaveSettings()
+    {
+        uint64_t version  = s_Version.load(std::memory_order_acquire);
+        Settings snapshot = GetSnapshot();
+        WriteSettings(snapshot);
+        s_SavedVersion.store(version, std::memory_order_release);
+    }
+
+    void SettingsManager::FlushPendingSave()
+    {
+        if (s_Version.load(std::memory_order_acquire) != s_SavedVersion.load(std::memory_order_acquire))
+            SaveSettings();
+    }
+
+    void SettingsManager::WriteSettings(const Settings& settings)
     {
         std::string filePath = GetSettingsFilePath();
         
@@ -116,28 +171,30 @@ namespace Donut
             
             toml::value simulation = toml::table
             {
-                {"target_fps",          s_Settings.simulation.targetFPS        },
-                {"compute_height",      s_Settings.simulation.computeHeight    },
-                {"max_steps_moving",    s_Settings.simulation.maxStepsMoving   },
-                {"max_steps_static",    s_Settings.simulation.maxStepsStatic   },
-                {"early_exit_distance", s_Settings.simulation.earlyExitDistance},
-                {"gravity_enabled",     s_Settings.simulation.gravityEnabled   },
-                {"disk_thickness",      s_Settings.simulation.diskThickness    },
-                {"disk_density",        s_Settings.simulation.diskDensity      },
-                {"rotation_speed",      s_Settings.simulation.rotationSpeed    },
-                {"blur_strength",       s_Settings.simulation.blurStrength     },
-                {"glow_intensity",      s_Settings.simulation.glowIntensity    }
+                {"target_fps",          settings.simulation.targetFPS        },
+                {"physics_rate",        settings.simulation.physicsRate      },
+                {"compute_height",      settings.simulation.computeHeight    },
+                {"max_steps_moving",    settings.simulation.maxStepsMoving   },
+                {"max_steps_static",    settings.simulation.maxStepsStatic   },
+                {"early_exit_distance", settings.simulation.earlyExitDistance},
+                {"gravity_enabled",     settings.simulation.gravityEnabled   },
+                {"disk_thickness",      settings.simulation.diskThickness    },
+                {"disk_density",        settings.simulation.diskDensity      },
+                {"rotation_speed",      settings.simulation.rotationSpeed    },
+                {"blur_strength",       settings.simulation.blurStrength     },
+                {"glow_intensity",      settings.simulation.glowIntensity    }
             };
             
             toml::value graphics = toml::table
             {
-                {"render_api",               s_Settings.graphics.renderAPI             },
-                {"vsync_enabled",            s_Settings.graphics.vSyncEnabled          },
-                {"show_fps",                 s_Settings.graphics.showFPS               },
-                {"show_performance_metrics", s_Settings.graphics.showPerformanceMetrics},
-                {"show_debug_info",          s_Settings.graphics.showDebugInfo         },
-                {"enable_anti_aliasing",     s_Settings.graphics.enableAntiAliasing    },
-                {"selected_theme",           s_Settings.graphics.selectedTheme         }
+                {"render_api",               settings.graphics.renderAPI             },
+                {"vsync_enabled",            settings.graphics.vSyncEnabled          },
+                {"show_fps",                 settings.graphics.showFPS               },
+                {"show_performance_metrics", settings.graphics.showPerformanceMetrics},
+                {"show_debug_info",          settings.graphics.showDebugInfo         },
+                {"enable_anti_aliasing",     settings.graphics.enableAntiAliasing    },
+                {"selected_theme",           settings.graphics.selectedTheme         },
+                {"hdri_cache_budget_mb",     settings.graphics.hdriCacheBudgetMB     }
             };
             
             toml::value config = toml::table
@@ -146,9 +203,16 @@ namespace Donut
                 {"graphics",   graphics}
             };
             
-            std::ofstream file(filePath);
-            file << config;
-            file.close();
+            // Write beside the real file and swap it in so a crash never leaves it truncated
+            std::string tempPath = filePath + ".tmp";
+            {
+                std::ofstream file(tempPath, std::ios::trunc);
+                file << config;
+                file.flush();
+                if (!file)
+                    throw std::runtime_error("could not write " + tempPath);
+            }
+            std::filesystem::rename(tempPath, filePath);
             
             DONUT_INFO("Settings saved to {}", filePath);
         }
@@ -160,14 +224,94 @@ namespace Donut
 
     void SettingsManager::SetSimulationSettings(const SimulationSettings& settings)
     {
-        s_Settings.simulation = settings;
-        SaveSettings();
+        {
+            std::lock_guard<std::mutex> lock(s_SettingsMutex);
+            s_Settings.simulation = settings;
+        }
+        MarkChanged();
     }
 
     void SettingsManager::SetGraphicsSettings(const GraphicsSettings& settings)
     {
-        s_Settings.graphics = settings;
-        SaveSettings();
+        {
+            std::lock_guard<std::mutex> lock(s_SettingsMutex);
+            s_Settings.graphics = settings;
+        }
+        MarkChanged();
+    }
+
+    Settings SettingsManager::GetSnapshot()
+    {
+        std::lock_guard<std::mutex> lock(s_SettingsMutex);
+        return s_Settings;
+    }
+
+    uint64_t SettingsManager::GetVersion()
+    {
+        return s_Version.load(std::memory_order_acquire);
+    }
+
+    uint32_t SettingsManager::Subscribe(SettingsListener listener)
+    {
+        std::lock_guard<std::mutex> lock(s_ListenerMutex);
+        uint32_t id = s_NextListenerID++;
+        s_Listeners.emplace_back(id, std::move(listener));
+        return id;
+    }
+
+    void SettingsManager::Unsubscribe(uint32_t id)
+    {
+        std::lock_guard<std::mutex> lock(s_ListenerMutex);
+        s_Listeners.erase(std::remove_if(s_Listeners.begin(), s_Listeners.end(), 
+            [id](const auto& entry) { return entry.first == id; }), s_Listeners.end());
+    }
+
+    void SettingsManager::MarkChanged()
+    {
+        uint64_t version = s_Version.fetch_add(1, std::memory_order_acq_rel) + 1;
+        {
+            std::lock_guard<std::mutex> lock(s_SaverMutex);
+            s_LastChange = std::chrono::steady_clock::now();
+        }
+        s_SaverCondition.notify_one();
+
+        std::vector<std::pair<uint32_t, SettingsListener>> listeners;
+        {
+            std::lock_guard<std::mutex> lock(s_ListenerMutex);
+            listeners = s_Listeners;
+        }
+
+        if (listeners.empty())
+            return;
+
+        Settings snapshot = GetSnapshot();
+        for (const auto& [id, listener] : listeners)
+            listener(snapshot, version);
+    }
+
+    void SettingsManager::SaverLoop()
+    {
+        std::unique_lock<std::mutex> lock(s_SaverMutex);
+        while (!s_StopSaver)
+        {
+            if (s_Version.load(std::memory_order_acquire) == s_SavedVersion.load(std::memory_order_acquire))
+            {
+                s_SaverCondition.wait(lock);
+                continue;
+            }
+
+            // Keep pushing the deadline back while changes are still arriving
+            auto deadline = s_LastChange + SaveQuietPeriod;
+            if (std::chrono::steady_clock::now() < deadline)
+            {
+                s_SaverCondition.wait_until(lock, deadline);
+                continue;
+            }
+
+            lock.unlock();
+            SaveSettings();
+            lock.lock();
+        }
     }
 
     std::string SettingsManager::GetSettingsFilePath()
@@ -178,6 +322,7 @@ namespace Donut
     void SettingsManager::LoadDefaultSettings()
     {
         s_Settings.simulation.targetFPS         = 60;
+        s_Settings.simulation.physicsRate       = 60;
         s_Settings.simulation.computeHeight     = 512;
         s_Settings.simulation.maxStepsMoving    = 30000;
         s_Settings.simulation.maxStepsStatic    = 15000;
@@ -196,5 +341,6 @@ namespace Donut
         s_Settings.graphics.showDebugInfo          = false;
         s_Settings.graphics.enableAntiAliasing     = true;
         s_Settings.graphics.selectedTheme          = "Dark";
+        s_Settings.graphics.hdriCacheBudgetMB      = 256;
     }
 }
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <string>
+#include <cstdint>
+#include <functional>
 #include <toml.hpp>
 
 namespace Donut
@@ -8,6 +10,7 @@ namespace Donut
     struct SimulationSettings
     {
         int   targetFPS         = 60;
+        int   physicsRate       = 60;
         int   computeHeight     = 512;
         int   maxStepsMoving    = 30000;
         int   maxStepsStatic    = 15000;
@@ -29,6 +32,7 @@ namespace Donut
         bool        showDebugInfo          = false;
         bool        enableAntiAliasing     = true;
         std::string selectedTheme          = "Dark";
+        int         hdriCacheBudgetMB      = 256;
     };
 
     struct Settings
@@ -37,6 +41,11 @@ namespace Donut
         GraphicsSettings   graphics;
     };
 
+    using SettingsListener = std::function<void(const Settings& settings, uint64_t version)>;
+
+    // Every change bumps a version and notifies listeners on the changing thread.
+    // Writes to disk are coalesced and done by a background thread once changes
+    // have been quiet for a while, and always before Shutdown() returns.
     class SettingsManager
     {
     public:
@@ -45,6 +54,7 @@ namespace Donut
         
         static void LoadSettings();
         static void SaveSettings();
+        static void FlushPendingSave();
         
         static       Settings& GetSettings()      { return s_Settings; }
         static const Settings& GetSettingsConst() { return s_Settings; }
@@ -52,7 +62,15 @@ namespace Donut
         static void SetSimulationSettings(const SimulationSettings& settings);
         static void SetGraphicsSettings(const GraphicsSettings& settings);
 
+        // Thread-safe copy for readers off the main thread
+        static Settings GetSnapshot();
+        static uint64_t GetVersion();
+
+        static uint32_t Subscribe(SettingsListener listener);
+        static void     Unsubscribe(uint32_t id);
+
         static int   GetTargetFPS()              { return s_Settings.simulation.targetFPS;            }
+        static int   GetPhysicsRate()            { return s_Settings.simulation.physicsRate;          }
         static int   GetComputeHeight()          { return s_Settings.simulation.computeHeight;        }
         static int   GetMaxStepsMoving()         { return s_Settings.simulation.maxStepsMoving;       }
         static int   GetMaxStepsStatic()         { return s_Settings.simulation.maxStepsStatic;       }
@@ -69,10 +87,14 @@ namespace Donut
         static bool  GetShowPerformanceMetrics() { return s_Settings.graphics.showPerformanceMetrics; }
         static bool  GetShowDebugInfo()          { return s_Settings.graphics.showDebugInfo;          }
         static bool  GetEnableAntiAliasing()     { return s_Settings.graphics.enableAntiAliasing;     }
+        static int   GetHDRICacheBudgetMB()      { return s_Settings.graphics.hdriCacheBudgetMB;      }
         static std::string GetSelectedTheme()    { return s_Settings.graphics.selectedTheme;          }
     private:
         static std::string GetSettingsFilePath();
         static void        LoadDefaultSettings();
+        static void        WriteSettings(const Settings& settings);
+        static void        MarkChanged();
+        static void        SaverLoop();
     private:
         static Settings s_Settings;
         static bool     s_Initialized;
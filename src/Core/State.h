@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Event.h"
+#include "FramePacket.h"
 
 namespace Donut
 {
@@ -9,11 +10,11 @@ namespace Donut
     public:
         virtual ~State() = default;
         
-        virtual void OnEnter()                 = 0;
-        virtual void OnExit()                  = 0;
-        virtual void OnUpdate(float deltaTime) = 0;
-        virtual void OnRender()                = 0;
-        virtual void OnImUIRender()            = 0;
-        virtual void OnEvent(Event& event)     = 0;
+        virtual void OnEnter()                     = 0;
+        virtual void OnExit()                      = 0;
+        virtual void OnUpdate(float deltaTime)     = 0;
+        virtual void OnRender(FramePacket& packet) = 0; // Recorded commands run later, on the render thread
+        virtual void OnImUIRender()                = 0;
+        virtual void OnEvent(Event& event)         = 0;
     };
 };
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "StateManager.h"
 #include "Log.h"
+#include "RenderThread.h"
 
 namespace Donut
 {
@@ -40,12 +41,16 @@ namespace Donut
         if (newState == m_CurrentState)
             return;
 
-        if (m_CurrentState)
-            m_CurrentState->OnExit();
+        // States create and drop GL resources on entry and exit
+        RenderThread::Execute([&]()
+        {
+            if (m_CurrentState)
+                m_CurrentState->OnExit();
 
-        m_CurrentState = newState;
-        m_CurrentStateName = stateName;
-        m_CurrentState->OnEnter();
+            m_CurrentState = newState;
+            m_CurrentStateName = stateName;
+            m_CurrentState->OnEnter();
+        });
         DONUT_INFO("Switched to state: {}", stateName);
     }
 
@@ -68,10 +73,10 @@ namespace Donut
             m_CurrentState->OnUpdate(deltaTime);
     }
 
-    void StateManager::Render()
+    void StateManager::Render(FramePacket& packet)
     {
         if (m_CurrentState)
-            m_CurrentState->OnRender();
+            m_CurrentState->OnRender(packet);
     }
 
     void StateManager::OnImUIRender()
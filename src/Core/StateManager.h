@@ -15,7 +15,7 @@ namespace Donut
         void Shutdown();
         
         void Update(float deltaTime);
-        void Render();
+        void Render(FramePacket& packet);
         void OnImUIRender();
         void OnEvent(Event& event);
         
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace Donut
+{
+    // Single-producer/single-consumer triple buffer. The writer fills GetBack()
+    // and calls Publish(); the reader calls Acquire() and reads GetFront().
+    // Neither side ever blocks, and the reader always sees the newest complete value.
+    template<typename T>
+    class TripleBuffer
+    {
+    public:
+        T&       GetBack()        { return m_Buffers[m_Back];  }
+        const T& GetFront() const { return m_Buffers[m_Front]; }
+
+        void Publish()
+        {
+            m_Back = m_Middle.exchange(m_Back | DirtyBit, std::memory_order_acq_rel) & IndexMask;
+        }
+
+        // Returns true if a newer value was swapped in
+        bool Acquire()
+        {
+            if (!(m_Middle.load(std::memory_order_relaxed) & DirtyBit))
+                return false;
+
+            m_Front = m_Middle.exchange(m_Front, std::memory_order_acq_rel) & IndexMask;
+            return true;
+        }
+    private:
+        static constexpr uint8_t IndexMask = 0x3;
+        static constexpr uint8_t DirtyBit  = 0x4;
+
+        T                    m_Buffers[3];
+        uint8_t              m_Back   = 0;
+        uint8_t              m_Front  = 1;
+        std::atomic<uint8_t> m_Middle = 2;
+    };
+};
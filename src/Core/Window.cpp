@@ -2,6 +2,8 @@
 #include "Window.h"
 #include "ThemeManager.h"
 
+#include "Rendering/Renderer.h"
+
 #include <cstdint>
 
 #include <imgui.h>
@@ -13,9 +15,9 @@ namespace Donut
     static bool     s_GLFWInitialized = false;
     static uint32_t s_GLFWWindowCount = 0;
 
-    Window::Window(const std::string& title, int width, int height)
+    Window::Window(const std::string& title, int width, int height, bool headless)
         : m_Title(title), m_Width(width), 
-          m_Height(height), m_IsClosed(false)
+          m_Height(height), m_IsClosed(false), m_Headless(headless)
     {
         Init();
     }
@@ -31,6 +33,10 @@ namespace Donut
         
         if (!s_GLFWInitialized)
         {
+            // The null platform needs no display server
+            if (m_Headless)
+                glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+
             int success = glfwInit();
             if (!success)
             {
@@ -42,7 +48,8 @@ namespace Donut
             DONUT_INFO("GLFW initialized successfully");
         }
 
-        m_Window = glfwCreateWindow(m_Width, m_Height, m_Title.c_str(), nullptr, nullptr);
+        m_Window = m_Headless ? CreateHeadlessWindow()
+                              : glfwCreateWindow(m_Width, m_Height, m_Title.c_str(), nullptr, nullptr);
         if (!m_Window)
         {
             DONUT_ERROR("Could not create GLFW window!");
@@ -52,12 +59,18 @@ namespace Donut
         
         DONUT_INFO("GLFW window created successfully");
 
-        glfwMakeContextCurrent(m_Window);
+        if (glfwGetWindowAttrib(m_Window, GLFW_CLIENT_API) != GLFW_NO_API)
+            glfwMakeContextCurrent(m_Window);
         glfwSetWindowUserPointer(m_Window, this);
 
         glfwSetErrorCallback(GLFWErrorCallback);
         glfwSetWindowCloseCallback(m_Window, GLFWWindowCloseCallback);
         glfwSetWindowSizeCallback(m_Window,  GLFWWindowSizeCallback);
+
+        s_GLFWWindowCount++;
+        if (m_Headless)
+            return;
+
         glfwSetWindowFocusCallback(m_Window, GLFWWindowFocusCallback);
         glfwSetWindowPosCallback(m_Window,   GLFWWindowPosCallback);
         glfwSetKeyCallback(m_Window,         GLFWKeyCallback);
@@ -65,8 +78,40 @@ namespace Donut
         glfwSetMouseButtonCallback(m_Window, GLFWMouseButtonCallback);
         glfwSetScrollCallback(m_Window,      GLFWMouseScrollCallback);
         glfwSetCursorPosCallback(m_Window,   GLFWCursorPosCallback);
+    }
 
-        s_GLFWWindowCount++;
+    GLFWwindow* Window::CreateHeadlessWindow()
+    {
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+        // The software renderer never touches GL off-screen, so it runs without any context
+        if (RendererAPI::GetAPI() == RendererAPI::API::Software)
+        {
+            glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+            GLFWwindow* window = glfwCreateWindow(m_Width, m_Height, m_Title.c_str(), nullptr, nullptr);
+            glfwDefaultWindowHints();
+            return window;
+        }
+
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+        // EGL gives a surfaceless context on Mesa; OSMesa covers machines without libEGL
+        GLFWwindow* window = nullptr;
+        for (int contextAPI : { GLFW_EGL_CONTEXT_API, GLFW_OSMESA_CONTEXT_API })
+        {
+            glfwWindowHint(GLFW_CONTEXT_CREATION_API, contextAPI);
+            window = glfwCreateWindow(m_Width, m_Height, m_Title.c_str(), nullptr, nullptr);
+            if (window)
+            {
+                DONUT_INFO("Created headless {} context", contextAPI == GLFW_EGL_CONTEXT_API ? "EGL" : "OSMesa");
+                break;
+            }
+        }
+
+        glfwDefaultWindowHints();
+        return window;
     }
 
     void Window::Shutdown()
@@ -87,9 +132,21 @@ namespace Donut
     }
 
     void Window::OnUpdate() const
+    {
+        PollEvents();
+        SwapBuffers();
+    }
+
+    void Window::PollEvents() const
     {
         glfwPollEvents();
-        glfwSwapBuffers(m_Window);
+    }
+
+    void Window::SwapBuffers() const
+    {
+        // Surfaceless contexts have no default framebuffer to present
+        if (!m_Headless)
+            glfwSwapBuffers(m_Window);
     }
 
     bool Window::ShouldClose() const
@@ -111,14 +168,15 @@ namespace Donut
                          GLFW_CURSOR_NORMAL : GLFW_CURSOR_HIDDEN);
     }
 
-    void Window::InitImGui()
+    void Window::InitImGui(bool multiViewports)
     {
         IMGUI_CHECKVERSION();
         ImGui::CreateContext();
         ImGuiIO& io = ImGui::GetIO();
         io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;
         io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;
-        io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable;
+        if (multiViewports)
+            io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable;
 
         SetupImGuiFonts();
         ThemeManager::SetTheme(Theme::Dark);
@@ -132,6 +190,10 @@ namespace Donut
 
         ImGui_ImplGlfw_InitForOpenGL(m_Window, true);
         ImGui_ImplOpenGL3_Init("#version 130");
+
+        // Builds the font atlas while the context is still current here; NewFrame() needs it
+        ImGui_ImplOpenGL3_CreateDeviceObjects();
+        m_ImGuiInitialized = true;
         
         DONUT_INFO("ImGUI initialized successfully");
     }
@@ -164,6 +226,9 @@ namespace Donut
 
     void Window::ShutdownImGui()
     {
+        if (!m_ImGuiInitialized)
+            return;
+
         ImGui_ImplOpenGL3_Shutdown();
         ImGui_ImplGlfw_Shutdown();
         ImGui::DestroyContext();
@@ -173,7 +238,6 @@ namespace Donut
 
     void Window::BeginImGuiFrame()
     {
-        ImGui_ImplOpenGL3_NewFrame();
         ImGui_ImplGlfw_NewFrame();
         ImGui::NewFrame();
     }
@@ -181,13 +245,28 @@ namespace Donut
     void Window::EndImGuiFrame()
     {
         ImGui::Render();
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 
+        // Creating a platform window makes its context current
         ImGuiIO& io = ImGui::GetIO();
         if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
         {
             GLFWwindow* backup_current_context = glfwGetCurrentContext();
             ImGui::UpdatePlatformWindows();
+            glfwMakeContextCurrent(backup_current_context);
+        }
+    }
+
+    void Window::RenderImGui(ImDrawData* drawData)
+    {
+        if (!drawData)
+            return;
+
+        ImGui_ImplOpenGL3_RenderDrawData(drawData);
+
+        ImGuiIO& io = ImGui::GetIO();
+        if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
+        {
+            GLFWwindow* backup_current_context = glfwGetCurrentContext();
             ImGui::RenderPlatformWindowsDefault();
             glfwMakeContextCurrent(backup_current_context);
         }
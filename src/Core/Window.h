@@ -15,11 +15,15 @@ namespace Donut
     public:
         using EventCallbackFn = std::function<void(Event&)>;
 
-        Window(const std::string& title, int width, int height);
+        // A headless window has no surface: its context is created on GLFW's null
+        // platform through EGL or OSMesa, and it never receives input
+        Window(const std::string& title, int width, int height, bool headless = false);
         ~Window();
 
         bool ShouldClose() const;
         void OnUpdate()    const;
+        void PollEvents()  const;
+        void SwapBuffers() const;
 
         void SetEventCallback(const EventCallbackFn& callback)
         {
@@ -32,18 +36,24 @@ namespace Donut
         unsigned int GetHeight() const { return m_Height; }
 
         void* GetNativeWindow()  const { return m_Window; }
+        bool  IsHeadless()       const { return m_Headless; }
 
         void SetCursorLocked(bool locked);
         void SetCursorVisible(bool visible);
         bool IsCursorLocked()  const { return m_CursorLocked;  }
         bool IsCursorVisible() const { return m_CursorVisible; }
     
-        void InitImGui();
+        // Platform windows need ImGui's renderer on the main thread, so a render thread turns them off
+        void InitImGui(bool multiViewports = true);
         void BeginImGuiFrame();
         void EndImGuiFrame();
+
+        // GL side of the UI: draws what EndImGuiFrame() produced, on whichever thread owns the context
+        void RenderImGui(ImDrawData* drawData);
     private:
         void Init();
         void Shutdown();
+        GLFWwindow* CreateHeadlessWindow();
 
         void SetupImGuiFonts();
         void ShutdownImGui();
@@ -66,6 +76,8 @@ namespace Donut
         unsigned int m_Width;
         unsigned int m_Height;
         bool m_IsClosed;
+        bool m_Headless         = false;
+        bool m_ImGuiInitialized = false;
         bool m_CursorLocked  = false;
         bool m_CursorVisible = true;
         
@@ -0,0 +1,112 @@
+#include "BVH.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace Donut
+{
+    void BVH::Build(const std::vector<glm::vec4>& spheres)
+    {
+        Clear();
+        if (spheres.empty())
+            return;
+
+        m_Indices.resize(spheres.size());
+        std::iota(m_Indices.begin(), m_Indices.end(), 0u);
+
+        m_Nodes.reserve(spheres.size() * 2);
+        BVHNode& root = m_Nodes.emplace_back();
+        root.m_LeftFirst = 0;
+        root.m_Count     = static_cast<int32_t>(spheres.size());
+
+        UpdateNodeBounds(0, spheres);
+        Subdivide(0, spheres);
+    }
+
+    void BVH::Refit(const std::vector<glm::vec4>& spheres)
+    {
+        for (size_t i = m_Nodes.size(); i-- > 0;)
+        {
+            BVHNode& node = m_Nodes[i];
+            if (node.IsLeaf())
+            {
+                UpdateNodeBounds(static_cast<uint32_t>(i), spheres);
+                continue;
+            }
+
+            const BVHNode& left  = m_Nodes[node.m_LeftFirst];
+            const BVHNode& right = m_Nodes[node.m_LeftFirst + 1];
+            node.m_Min = glm::min(left.m_Min, right.m_Min);
+            node.m_Max = glm::max(left.m_Max, right.m_Max);
+        }
+    }
+
+    void BVH::Clear()
+    {
+        m_Nodes.clear();
+        m_Indices.clear();
+    }
+
+    void BVH::UpdateNodeBounds(uint32_t nodeIndex, const std::vector<glm::vec4>& spheres)
+    {
+        BVHNode& node = m_Nodes[nodeIndex];
+        node.m_Min = glm::vec3( 1e30f);
+        node.m_Max = glm::vec3(-1e30f);
+
+        for (int32_t i = 0; i < node.m_Count; ++i)
+        {
+            const glm::vec4& sphere = spheres[m_Indices[node.m_LeftFirst + i]];
+            glm::vec3 centre = glm::vec3(sphere);
+            node.m_Min = glm::min(node.m_Min, centre - glm::vec3(sphere.w));
+            node.m_Max = glm::max(node.m_Max, centre + glm::vec3(sphere.w));
+        }
+    }
+
+    void BVH::Subdivide(uint32_t nodeIndex, const std::vector<glm::vec4>& spheres)
+    {
+        uint32_t first = static_cast<uint32_t>(m_Nodes[nodeIndex].m_LeftFirst);
+        uint32_t count = static_cast<uint32_t>(m_Nodes[nodeIndex].m_Count);
+        if (count <= MaxLeafSize)
+            return;
+
+        glm::vec3 centroidMin( 1e30f);
+        glm::vec3 centroidMax(-1e30f);
+        for (uint32_t i = first; i < first + count; ++i)
+        {
+            glm::vec3 centre = glm::vec3(spheres[m_Indices[i]]);
+            centroidMin = glm::min(centroidMin, centre);
+            centroidMax = glm::max(centroidMax, centre);
+        }
+
+        glm::vec3 extent = centroidMax - centroidMin;
+        int axis = 0;
+        if (extent.y > extent.x)    axis = 1;
+        if (extent.z > extent[axis]) axis = 2;
+
+        // Coincident centres (every sphere the editor adds starts at the origin) are split
+        // by index instead, so no leaf ever exceeds MaxLeafSize
+        uint32_t mid = first + count / 2;
+        if (extent[axis] > 0.0f)
+        {
+            std::nth_element(m_Indices.begin() + first, m_Indices.begin() + mid, m_Indices.begin() + first + count,
+                [&](uint32_t a, uint32_t b) { return spheres[a][axis] < spheres[b][axis]; });
+        }
+
+        uint32_t leftIndex = static_cast<uint32_t>(m_Nodes.size());
+        m_Nodes.emplace_back();
+        m_Nodes.emplace_back();
+
+        m_Nodes[leftIndex].m_LeftFirst     = static_cast<int32_t>(first);
+        m_Nodes[leftIndex].m_Count         = static_cast<int32_t>(mid - first);
+        m_Nodes[leftIndex + 1].m_LeftFirst = static_cast<int32_t>(mid);
+        m_Nodes[leftIndex + 1].m_Count     = static_cast<int32_t>(first + count - mid);
+
+        m_Nodes[nodeIndex].m_LeftFirst = static_cast<int32_t>(leftIndex);
+        m_Nodes[nodeIndex].m_Count     = 0;
+
+        UpdateNodeBounds(leftIndex,     spheres);
+        UpdateNodeBounds(leftIndex + 1, spheres);
+        Subdivide(leftIndex,     spheres);
+        Subdivide(leftIndex + 1, spheres);
+    }
+};
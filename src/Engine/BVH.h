@@ -0,0 +1,45 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+namespace Donut
+{
+    // Laid out to match the std430 BVHNode struct in Geodesic.glsl.
+    struct BVHNode
+    {
+        glm::vec3 m_Min;
+        int32_t   m_LeftFirst = 0; // First child for interior nodes, first primitive for leaves
+        glm::vec3 m_Max;
+        int32_t   m_Count     = 0; // Primitive count, zero for interior nodes
+
+        bool IsLeaf() const { return m_Count > 0; }
+    };
+    static_assert(sizeof(BVHNode) == 32, "BVHNode must match the GPU layout");
+
+    // Bounding volume hierarchy over spheres packed as (centre.xyz, radius).
+    // Children of a node are always stored as an adjacent pair after their parent,
+    // so Refit() can run as a single reverse sweep over the node array. Every leaf
+    // holds at most MaxLeafSize primitives, whatever their positions.
+    class BVH
+    {
+    public:
+        static constexpr uint32_t MaxLeafSize = 4;
+
+        void Build(const std::vector<glm::vec4>& spheres);
+        void Refit(const std::vector<glm::vec4>& spheres);
+        void Clear();
+
+        const std::vector<BVHNode>&  GetNodes()   const { return m_Nodes;   }
+        const std::vector<uint32_t>& GetIndices() const { return m_Indices; }
+        size_t GetPrimitiveCount()                const { return m_Indices.size(); }
+    private:
+        void UpdateNodeBounds(uint32_t nodeIndex, const std::vector<glm::vec4>& spheres);
+        void Subdivide(uint32_t nodeIndex, const std::vector<glm::vec4>& spheres);
+    private:
+        std::vector<BVHNode>  m_Nodes;
+        std::vector<uint32_t> m_Indices;
+    };
+};
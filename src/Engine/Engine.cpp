@@ -1,6 +1,8 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <cstring>
+#include <algorithm>
 
 #include <GLFW/glfw3.h>
 #include <glad/glad.h>
@@ -11,8 +13,13 @@
 #include "Engine.h"
 #include "Core/Log.h"
 #include "Core/HDRIManager.h"
+#include "Core/JobSystem.h"
+#include "Core/RenderThread.h"
 #include "Rendering/VertexBuffer.h"
 #include "Rendering/IndexBuffer.h"
+#include "Rendering/AssetRegistry.h"
+#include "Engine/SceneFile.h"
+#include "Engine/SceneSerializer.h"
 
 namespace Donut
 {
@@ -33,53 +40,29 @@ namespace Donut
             { glm::vec4(0.00f, 0.00f, 0.00f, m_SagA.m_Rs), glm::vec4(0, 0, 0, 1), static_cast<float>(m_SagA.m_Mass) }
         };
 
-        m_ComputeProgram = CreateComputeProgram("Assets/Shaders/Geodesic.glsl");
-        m_ShaderProgram  = Ref<Shader>(Shader::Create("Assets/Shaders/TexturedQuad.glsl"));
-        m_BlurShader     = Ref<Shader>(Shader::Create("Assets/Shaders/Blur.glsl"));
+        m_ComputeProgram = AssetRegistry::GetComputeShader("Assets/Shaders/Geodesic.glsl");
+        m_ShaderProgram  = AssetRegistry::GetShader("Assets/Shaders/TexturedQuad.glsl");
+        m_BlurShader     = AssetRegistry::GetShader("Assets/Shaders/Blur.glsl");
         
         auto& hdriManager = HDRIManager::Get();
-        m_HDRIEnvironment = hdriManager.GetCurrentHDRI();
-        if (!m_HDRIEnvironment)
-        {
+        if (!hdriManager.GetCurrentHDRI())
             hdriManager.SetCurrentHDRI("Assets/HDRI/HDR_blue_nebulae-1.hdr");
-            m_HDRIEnvironment = hdriManager.GetCurrentHDRI();
-            if (!m_HDRIEnvironment)
-                DONUT_WARN("Failed to load default HDRI, using fallback");
-        }
-        
-        m_CameraUBO = UniformBuffer::Create(128, 1);
-        m_DiskUBO   = UniformBuffer::Create(sizeof(float) * 5, 2);
-        
-        uint32_t objUBOSize = sizeof(int) + 3 * sizeof(float)
-            + 16 * (sizeof(glm::vec4) + sizeof(glm::vec4))
-            + 16 * sizeof(float);
-        m_ObjectsUBO = UniformBuffer::Create(objUBOSize, 3);
         
-        m_SimulationUBO = UniformBuffer::Create(sizeof(int) * 2 + sizeof(float) * 2, 4);
+        m_UniformRing  = UniformRingBuffer::Create(16 * 1024);
+        m_ObjectBuffer = StorageBuffer::Create(64 * sizeof(EngineFrame::GPUObject), 0);
+        m_BVHBuffer    = StorageBuffer::Create(128 * sizeof(BVHNode), 1);
+        RebuildObjectBVH();
+        SyncBodies();
+        m_Physics.Start();
 
-        auto result = QuadVAO();
-        m_QuadVAO = result.first;
-        m_Texture = result.second;
+        m_QuadVAO = AssetRegistry::GetFullscreenQuad();
     }
 
-    void Engine::UpdateWindowDimensions()
-    {
-        UpdateComputeDimensions();
-    }
-    
     void Engine::SetWindowDimensions(int width, int height)
     {
-        int oldWidth = m_Width;
-        int oldHeight = m_Height;
-        int oldComputeHeight = m_ComputeHeight;
-        
-        m_Width = width;
+        // The trace targets follow once a frame built at the new size is dispatched
+        m_Width  = width;
         m_Height = height;
-        
-        if (oldWidth         != m_Width  || 
-            oldHeight        != m_Height || 
-            oldComputeHeight != m_ComputeHeight)
-            UpdateComputeDimensions();
     }
 
     void Engine::UpdatePerformance(float deltaTime)
@@ -88,14 +71,23 @@ namespace Donut
             m_CurrentFPS = 1.0f / deltaTime;
     }
 
-    void Engine::UpdateComputeDimensions()
+    void Engine::ResizeTraceTargets(uint32_t width, uint32_t height)
     {
-        m_Texture = Texture2D::Create(GetComputeWidth(), m_ComputeHeight);
+        // Called every frame, so only reallocate when the resolution actually changed
+        if (m_TraceTargets[0] && m_TraceTargets[0]->GetWidth() == width && m_TraceTargets[0]->GetHeight() == height)
+            return;
+
+        for (auto& target : m_TraceTargets)
+            target = Texture2D::Create(width, height);
+
+        m_Texture      = m_TraceTargets[0];
+        m_TraceIndex   = 0;
+        m_TracedFrames = 0;
     }
 
-    void Engine::DrawFullScreenQuad()
+    void Engine::DrawFullScreenQuad(const EngineFrame& frame)
     {
-        RenderCommand::SetViewport(0, 0, m_Width, m_Height);
+        RenderCommand::SetViewport(0, 0, frame.Width, frame.Height);
         
         m_ShaderProgram->Bind();
         m_QuadVAO->Bind();
@@ -108,63 +100,184 @@ namespace Donut
         RenderCommand::EnableDepthTest();
     }
 
-    void Engine::DrawBlurPass()
+    void Engine::DrawBlurPass(const EngineFrame& frame)
     {
-        RenderCommand::SetViewport(0, 0, m_Width, m_Height);
+        RenderCommand::SetViewport(0, 0, frame.Width, frame.Height);
         
         m_BlurShader->Bind();
         m_QuadVAO->Bind();
 
         m_Texture->Bind(0);
         m_BlurShader->SetInt("u_ScreenTexture", 0);
-        m_BlurShader->SetFloat2("u_Resolution", glm::vec2(m_Width, m_Height));
-        m_BlurShader->SetFloat("u_BlurStrength", m_BlurStrength);
-        m_BlurShader->SetFloat("u_GlowIntensity", m_GlowIntensity);
+        m_BlurShader->SetFloat2("u_Resolution", glm::vec2(frame.Width, frame.Height));
+        m_BlurShader->SetFloat("u_BlurStrength", frame.BlurStrength);
+        m_BlurShader->SetFloat("u_GlowIntensity", frame.GlowIntensity);
 
         RenderCommand::DisableDepthTest();
         RenderCommand::DrawArrays(6);
         RenderCommand::EnableDepthTest();
     }
 
-    void Engine::DispatchCompute(const Camera& cam)
+    EngineFrame Engine::BuildFrame(const Camera& cam, bool reuseUnchangedTrace)
     {
-        auto& hdriManager = HDRIManager::Get();
-        m_HDRIEnvironment = hdriManager.GetCurrentHDRI();
-        
-        int cw = GetComputeWidth();
-        int ch = m_ComputeHeight;
+        // Only frames hold the environment: a main-thread reference could end up being the last
+        // one once the cache evicts it, and would then delete the cubemap off the render thread
+        EngineFrame frame;
+        frame.Environment   = HDRIManager::Get().GetCurrentHDRI();
+        frame.Width         = m_Width;
+        frame.Height        = m_Height;
+        frame.ComputeWidth  = GetComputeWidth();
+        frame.ComputeHeight = m_ComputeHeight;
+        frame.BlurStrength  = m_BlurStrength;
+        frame.GlowIntensity = m_GlowIntensity;
+        frame.Pipelined     = m_PipelinedCompute;
+
+        float aspect = static_cast<float>(frame.ComputeWidth) / static_cast<float>(frame.ComputeHeight);
+        BuildCameraBlock(frame, cam, aspect);
+        BuildDiskBlock(frame);
+        BuildObjectsBlock(frame);
+        BuildSimulationBlock(frame);
+
+        if (!reuseUnchangedTrace)
+            return frame;
+
+        frame.Retrace = TraceInputsChanged(frame);
+        if (frame.Retrace)
+            m_IssuedDispatches++;
+        else
+            m_SkippedDispatches++;
+        return frame;
+    }
 
-        m_Texture->SetData(nullptr, cw * ch * 4);
+    bool Engine::TraceInputsChanged(const EngineFrame& frame)
+    {
+        // Blocks are value-initialised, padding included, so they compare bytewise like the uniform cache does
+        bool unchanged = !frame.ObjectsChanged &&
+                         std::memcmp(&frame.CameraData,     &m_LastTraced.CameraData,     sizeof(frame.CameraData))     == 0 &&
+                         std::memcmp(frame.DiskData,        m_LastTraced.DiskData,        sizeof(frame.DiskData))       == 0 &&
+                         std::memcmp(&frame.ObjectsData,    &m_LastTraced.ObjectsData,    sizeof(frame.ObjectsData))    == 0 &&
+                         std::memcmp(&frame.SimulationData, &m_LastTraced.SimulationData, sizeof(frame.SimulationData)) == 0 &&
+                         frame.ComputeWidth  == m_LastTraced.ComputeWidth  &&
+                         frame.ComputeHeight == m_LastTraced.ComputeHeight &&
+                         frame.Pipelined     == m_LastTraced.Pipelined     &&
+                         !frame.Environment.owner_before(m_LastTracedEnvironment) &&
+                         !m_LastTracedEnvironment.owner_before(frame.Environment);
+        if (unchanged)
+            return false;
+
+        m_LastTraced.CameraData     = frame.CameraData;
+        m_LastTraced.ObjectsData    = frame.ObjectsData;
+        m_LastTraced.SimulationData = frame.SimulationData;
+        m_LastTraced.ComputeWidth   = frame.ComputeWidth;
+        m_LastTraced.ComputeHeight  = frame.ComputeHeight;
+        m_LastTraced.Pipelined      = frame.Pipelined;
+        std::memcpy(m_LastTraced.DiskData, frame.DiskData, sizeof(frame.DiskData));
+        m_LastTracedEnvironment = frame.Environment;
+        return true;
+    }
+
+    void Engine::DispatchCompute(const EngineFrame& frame)
+    {
+        int cw = frame.ComputeWidth;
+        int ch = frame.ComputeHeight;
+        ResizeTraceTargets(static_cast<uint32_t>(cw), static_cast<uint32_t>(ch));
+
+        if (frame.Pipelined != m_TracePipelined)
+        {
+            m_TracePipelined = frame.Pipelined;
+            m_TracedFrames   = 0;
+        }
+
+        if (!frame.Retrace && m_TracedFrames > 0)
+        {
+            PresentLatestTrace();
+            return;
+        }
+
+        // Every texel is overwritten by the dispatch, so the target is never cleared. When pipelined,
+        // the only barrier is here: it publishes last frame's trace, and nothing issued between this
+        // dispatch and the post-processing below has to wait for it.
+        bool pipelined = m_TracePipelined && m_TracedFrames > 0;
+        if (pipelined)
+            m_ComputeProgram->MemoryBarrier(IMAGE_ACCESS_BARRIER_BIT | TEXTURE_FETCH_BARRIER_BIT);
+
+        const Ref<Texture2D>& target = m_TraceTargets[m_TraceIndex];
 
         m_ComputeProgram->Bind();
-        UploadCameraUBO(cam);
-        UploadDiskUBO();
-        UploadObjectsUBO(m_Objects);
-        UploadSimulationUBO();
-        m_Texture->BindAsImage(0, false);
+        m_UniformRing->BeginFrame();
+        UploadFrame(frame);
+        target->BindAsImage(0, false);
         
-        if (m_HDRIEnvironment)
-            m_HDRIEnvironment->Bind(5);
+        if (frame.Environment)
+            frame.Environment->Bind(5);
         
         uint32_t groupsX = static_cast<uint32_t>(std::ceil(cw / 16.0f));
         uint32_t groupsY = static_cast<uint32_t>(std::ceil(ch / 16.0f));
         m_ComputeProgram->Dispatch(groupsX, groupsY, 1);
-        m_ComputeProgram->MemoryBarrier(IMAGE_ACCESS_BARRIER_BIT);
+
+        if (pipelined)
+            m_Texture = m_TraceTargets[1 - m_TraceIndex];
+        else
+        {
+            m_ComputeProgram->MemoryBarrier(IMAGE_ACCESS_BARRIER_BIT | TEXTURE_FETCH_BARRIER_BIT);
+            m_Texture = target;
+        }
+
+        m_TraceIndex = 1 - m_TraceIndex;
+        m_TracedFrames++;
+        m_UniformRing->EndFrame();
+    }
+
+    void Engine::PresentLatestTrace()
+    {
+        // Pipelined, the newest trace has not been published yet; no later dispatch will do it
+        const Ref<Texture2D>& latest = m_TraceTargets[1 - m_TraceIndex];
+        if (m_Texture == latest)
+            return;
+
+        m_ComputeProgram->MemoryBarrier(IMAGE_ACCESS_BARRIER_BIT | TEXTURE_FETCH_BARRIER_BIT);
+        m_Texture = latest;
     }
 
-    void Engine::UploadCameraUBO(const Camera& cam)
+    void Engine::UploadFrame(const EngineFrame& frame)
     {
-        struct UBOData
+        if (frame.ObjectsChanged)
         {
-            glm::vec3 pos;     float _pad0;
-            glm::vec3 right;   float _pad1;
-            glm::vec3 up;      float _pad2;
-            glm::vec3 forward; float _pad3;
-            float tanHalfFov;
-            float aspect;
-            bool  moving;
-            int   _pad4;
-        } data;
+            if (!frame.Objects.empty())
+                m_ObjectBuffer->SetData(frame.Objects.data(), static_cast<uint32_t>(frame.Objects.size() * sizeof(EngineFrame::GPUObject)));
+            if (!frame.Nodes.empty())
+                m_BVHBuffer->SetData(frame.Nodes.data(), static_cast<uint32_t>(frame.Nodes.size() * sizeof(BVHNode)));
+        }
+
+        m_ObjectBuffer->Bind(0);
+        m_BVHBuffer->Bind(1);
+
+        UploadUniformBlock(1, &frame.CameraData,     sizeof(frame.CameraData));
+        UploadUniformBlock(2, frame.DiskData,        sizeof(frame.DiskData));
+        UploadUniformBlock(3, &frame.ObjectsData,    sizeof(frame.ObjectsData));
+        UploadUniformBlock(4, &frame.SimulationData, sizeof(frame.SimulationData));
+    }
+
+    void Engine::UploadUniformBlock(uint32_t binding, const void* data, uint32_t size)
+    {
+        auto& block = m_UniformBlocks[binding];
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+
+        bool unchanged = block.Data.size() == size && 
+                         std::memcmp(block.Data.data(), bytes, size) == 0;
+        if (unchanged && m_UniformRing->IsResident(block.Allocation))
+            return;
+
+        if (!unchanged)
+            block.Data.assign(bytes, bytes + size);
+
+        block.Allocation = m_UniformRing->Upload(bytes, size);
+        m_UniformRing->BindRange(binding, block.Allocation);
+    }
+
+    void Engine::BuildCameraBlock(EngineFrame& frame, const Camera& cam, float aspect) const
+    {
+        auto& data = frame.CameraData;
 
         glm::vec3 fwd   = glm::normalize(cam.GetOrbitalTarget() - cam.GetOrbitalPosition());
         glm::vec3 up    = glm::vec3(0, 1, 0);
@@ -176,39 +289,71 @@ namespace Donut
         data.up         = up;
         data.forward    = fwd;
         data.tanHalfFov = static_cast<float>(tan(glm::radians(60.0f * 0.5f)));
-        data.aspect     = static_cast<float>(GetComputeWidth()) / static_cast<float>(m_ComputeHeight);
-        data.moving     = cam.IsDragging() || cam.IsPanning();
-
-        m_CameraUBO->SetData(&data, sizeof(UBOData));
-        m_CameraUBO->Bind(1);
+        data.aspect     = aspect;
+        data.moving     = (cam.IsDragging() || cam.IsPanning()) ? 1 : 0;
     }
 
-    void Engine::UploadObjectsUBO(const std::vector<ObjectData>& objs)
+    void Engine::BuildObjectsBlock(EngineFrame& frame)
     {
-        struct UBOData
+        ApplyPhysicsSnapshot();
+
+        if (m_ObjectBVH.GetPrimitiveCount() != m_Objects.size())
+            RebuildObjectBVH();
+
+        const auto& indices = m_ObjectBVH.GetIndices();
+        const auto& nodes   = m_ObjectBVH.GetNodes();
+
+        if (m_BuiltObjectsRevision != m_ObjectsRevision)
         {
-            int numObjects;
-            float _pad0, _pad1, _pad2;
-            glm::vec4 posRadius[16];
-            glm::vec4 color[16];
-            float mass[16];
-        } data;
+            // Objects are stored in BVH leaf order so leaves address a contiguous range
+            frame.Objects.resize(indices.size());
+            for (size_t i = 0; i < indices.size(); ++i)
+            {
+                const ObjectData& obj = m_Objects[indices[i]];
+                frame.Objects[i] = { obj.m_PosRadius, obj.m_Color };
+
+                float reach = glm::length(glm::vec3(obj.m_PosRadius) - m_SagA.m_Position) + obj.m_PosRadius.w;
+                m_ObjectsReach = i == 0 ? reach : std::max(m_ObjectsReach, reach);
+            }
 
-        size_t count = std::min(objs.size(), size_t(16));
-        data.numObjects = static_cast<int>(count);
+            frame.Nodes          = nodes;
+            frame.ObjectsChanged = true;
+            m_BuiltObjectsRevision = m_ObjectsRevision;
+        }
+
+        frame.ObjectsData.numObjects   = static_cast<int>(indices.size());
+        frame.ObjectsData.numNodes     = static_cast<int>(nodes.size());
+        frame.ObjectsData.objectsReach = m_ObjectsReach;
+    }
+
+    void Engine::GatherObjectBounds()
+    {
+        m_ObjectBounds.resize(m_Objects.size());
+        for (size_t i = 0; i < m_Objects.size(); ++i)
+            m_ObjectBounds[i] = m_Objects[i].m_PosRadius;
+    }
 
-        for (size_t i = 0; i < count; ++i)
+    void Engine::RebuildObjectBVH()
+    {
+        GatherObjectBounds();
+        m_ObjectBVH.Build(m_ObjectBounds);
+        m_ObjectsRevision++;
+    }
+
+    void Engine::RefitObjectBVH()
+    {
+        if (m_ObjectBVH.GetPrimitiveCount() != m_Objects.size())
         {
-            data.posRadius[i] = objs[i].m_PosRadius;
-            data.color[i] = objs[i].m_Color;
-            data.mass[i] = objs[i].m_Mass;
+            RebuildObjectBVH();
+            return;
         }
 
-        m_ObjectsUBO->SetData(&data, sizeof(data));
-        m_ObjectsUBO->Bind(3);
+        GatherObjectBounds();
+        m_ObjectBVH.Refit(m_ObjectBounds);
+        m_ObjectsRevision++;
     }
 
-    void Engine::UploadDiskUBO()
+    void Engine::BuildDiskBlock(EngineFrame& frame) const
     {
         float r1 = static_cast<float>(m_SagA.m_Rs * 2.2);
         float r2 = static_cast<float>(m_SagA.m_Rs * 5.2);
@@ -216,60 +361,75 @@ namespace Donut
         float thickness = static_cast<float>(m_SagA.m_Rs * m_DiskThickness);
         float diskData[5] = { r1, r2, num, thickness, m_DiskDensity };
 
-        m_DiskUBO->SetData(diskData, sizeof(diskData));
-        m_DiskUBO->Bind(2);
+        std::memcpy(frame.DiskData, diskData, sizeof(diskData));
     }
 
-    void Engine::UploadSimulationUBO()
+    void Engine::BuildSimulationBlock(EngineFrame& frame) const
     {
-        struct UBOData
-        {
-            int maxStepsMoving;
-            int maxStepsStatic;
-            float earlyExitDistance;
-            float time;
-        } data;
+        auto& data = frame.SimulationData;
 
         data.maxStepsMoving    = m_MaxStepsMoving;
         data.maxStepsStatic    = m_MaxStepsStatic;
         data.earlyExitDistance = m_EarlyExitDistance;
-        data.time              = static_cast<float>(glfwGetTime()) * m_RotationSpeed;
-
-        m_SimulationUBO->SetData(&data, sizeof(data));
-        m_SimulationUBO->Bind(4);
+        data.time              = static_cast<float>(m_Time) * m_RotationSpeed;
     }
 
     void Engine::UpdatePhysics(float deltaTime)
     {
-        for (auto& obj : m_Objects)
+        m_Time += deltaTime;
+        m_Physics.SetRunning(m_Gravity);
+        if (!m_LockstepPhysics || !m_Gravity)
+            return;
+
+        const double tick = 1.0 / m_Physics.GetTickRate();
+        uint32_t steps = 0;
+        for (m_PhysicsLag += deltaTime; m_PhysicsLag >= tick; m_PhysicsLag -= tick)
+            steps++;
+
+        if (steps > 0)
+            m_Physics.StepNow(steps);
+    }
+
+    void Engine::SetLockstepPhysics(bool lockstep)
+    {
+        m_LockstepPhysics = lockstep;
+        m_PhysicsLag      = 0.0;
+        if (lockstep)
+            m_Physics.Stop();
+        else
+            m_Physics.Start();
+    }
+
+    void Engine::SyncBodies()
+    {
+        m_Physics.Reset(m_Objects);
+    }
+
+    void Engine::ApplyPhysicsSnapshot()
+    {
+        m_Physics.AcquireSnapshot();
+        if (!m_Gravity)
+            return;
+
+        // Render one physics tick behind and blend the two latest states
+        const PhysicsSnapshot& snapshot = m_Physics.GetSnapshot();
+        if (snapshot.Generation != m_Physics.GetGeneration() || snapshot.Objects.size() != m_Objects.size())
+            return;
+
+        double alpha = 1.0;
+        if (snapshot.StepDuration > 0.0)
+            alpha = std::clamp((PhysicsThread::Now() - snapshot.Time) / snapshot.StepDuration, 0.0, 1.0);
+
+        for (size_t i = 0; i < m_Objects.size(); ++i)
         {
-            for (auto& obj2 : m_Objects)
-            {
-                if (&obj == &obj2) continue;
-                float dx = obj2.m_PosRadius.x - obj.m_PosRadius.x;
-                float dy = obj2.m_PosRadius.y - obj.m_PosRadius.y;
-                float dz = obj2.m_PosRadius.z - obj.m_PosRadius.z;
-                float distance = sqrt(dx * dx + dy * dy + dz * dz);
-                if (distance > 0)
-                {
-                    std::vector<double> direction = {dx / distance, dy / distance, dz / distance};
-                    double Gforce = (G * obj.m_Mass * obj2.m_Mass) / (distance * distance);
-                    double acc1 = Gforce / obj.m_Mass;
-                    std::vector<double> acc = {direction[0] * acc1, direction[1] * acc1, direction[2] * acc1};
-                    
-                    if (m_Gravity)
-                    {
-                        obj.m_Velocity.x += static_cast<float>(acc[0]);
-                        obj.m_Velocity.y += static_cast<float>(acc[1]);
-                        obj.m_Velocity.z += static_cast<float>(acc[2]);
-
-                        obj.m_PosRadius.x += static_cast<float>(obj.m_Velocity.x);
-                        obj.m_PosRadius.y += static_cast<float>(obj.m_Velocity.y);
-                        obj.m_PosRadius.z += static_cast<float>(obj.m_Velocity.z);
-                    }
-                }
-            }
+            glm::vec3 position = glm::mix(snapshot.PreviousPositions[i], glm::vec3(snapshot.Objects[i].m_PosRadius), static_cast<float>(alpha));
+            m_Objects[i].m_PosRadius.x = position.x;
+            m_Objects[i].m_PosRadius.y = position.y;
+            m_Objects[i].m_PosRadius.z = position.z;
+            m_Objects[i].m_Velocity    = snapshot.Objects[i].m_Velocity;
         }
+
+        RefitObjectBVH();
     }
 
     void Engine::RenderScene()
@@ -281,81 +441,94 @@ namespace Donut
         RenderCommand::DrawArrays(6);
     }
 
-    Ref<Shader> Engine::CreateComputeProgram(const char* path)
+    void Engine::LoadObjectsFromScene(const std::vector<Donut::Object>& objects)
     {
-        std::ifstream in(path);
-        if(!in.is_open())
-        {
-            std::cerr << "Failed to open compute shader: " << path << "\n";
-            return nullptr;
-        }
-        std::stringstream ss;
-        ss << in.rdbuf();
-        std::string srcStr = ss.str();
-        return Ref<Shader>(Shader::CreateCompute("ComputeShader", srcStr));
+        BeginLoadingObjects(objects.size());
+        for (const auto& obj : objects)
+            AddSceneObject(obj.m_Centre, obj.m_Radius, obj.m_Material.m_Color, obj.m_Mass, obj.m_Velocity);
+        
+        FinishLoadingObjects("WorldBuilder scene");
     }
-
-    std::pair<Ref<VertexArray>, Ref<Texture2D>> Engine::QuadVAO()
+    
+    void Engine::LoadObjectsFromSceneFile(const SceneFile& file)
+    {
+        // Reads the mapped blocks directly; no intermediate Object list is built
+        uint32_t count = file.GetObjectCount();
+        const glm::vec3*     positions  = file.GetPositions();
+        const float*         radii      = file.GetRadii();
+        const SceneMaterial* materials  = file.GetMaterials();
+        const float*         masses     = file.GetMasses();
+        const glm::vec3*     velocities = file.GetVelocities();
+        
+        BeginLoadingObjects(count);
+        for (uint32_t i = 0; i < count; ++i)
+            AddSceneObject(positions[i], radii[i], materials[i].Color, masses[i], velocities[i]);
+        
+        FinishLoadingObjects("scene file");
+    }
+    
+    bool Engine::LoadSceneFromPath(const std::string& path)
     {
-        float quadVertices[] = 
+        if (SceneSerializer::IsBinaryPath(path))
         {
-            // Positions   // TexCoords
-            -1.0f,  1.0f,  0.0f, 1.0f,
-            -1.0f, -1.0f,  0.0f, 0.0f,
-             1.0f, -1.0f,  1.0f, 0.0f,
-            -1.0f,  1.0f,  0.0f, 1.0f,
-             1.0f, -1.0f,  1.0f, 0.0f,
-             1.0f,  1.0f,  1.0f, 1.0f
-        };
-
-        auto vertexBuffer = Ref<VertexBuffer>(VertexBuffer::Create(quadVertices, static_cast<uint32_t>(sizeof(quadVertices))));
-        VertexBufferLayout layout;
-        layout.Push<float>(2); // Position (x, y)
-        layout.Push<float>(2); // TexCoord (u, v)
-        vertexBuffer->SetLayout(layout);
-
-        auto vertexArray = Ref<VertexArray>(VertexArray::Create());
-        vertexArray->AddVertexBuffer(vertexBuffer);
-        auto texture = Texture2D::Create(GetComputeWidth(), m_ComputeHeight);
+            SceneFile file;
+            if (!file.Open(path))
+                return false;
+            
+            LoadObjectsFromSceneFile(file);
+            return true;
+        }
         
-        return { vertexArray, texture };
+        Scene scene;
+        if (!SceneSerializer::Load(scene, path))
+            return false;
+        
+        LoadObjectsFromScene(scene.objs);
+        return true;
     }
     
-    void Engine::LoadObjectsFromScene(const std::vector<Donut::Object>& objects)
+    void Engine::BeginLoadingObjects(size_t count)
     {
         m_Objects.clear();
+        m_Objects.reserve(count + 1);
         m_Objects.push_back(
         { 
             glm::vec4(0.00f, 0.00f, 0.00f, m_SagA.m_Rs), 
             glm::vec4(0, 0, 0, 1), 
             static_cast<float>(m_SagA.m_Mass) 
         });
+    }
+    
+    void Engine::AddSceneObject(const glm::vec3& centre, float radius, const glm::vec3& color, float mass, const glm::vec3& velocity)
+    {
+        ObjectData engineObj;
         
-        for (const auto& obj : objects)
+        engineObj.m_PosRadius = glm::vec4(centre * SceneScaleFactor, radius * SceneScaleFactor);
+        engineObj.m_Color     = glm::vec4(color, 1.0f);
+        
+        if (mass <= 0.0f)
         {
-            ObjectData engineObj;
-            
-            float scaleFactor = 1e10f;
-            engineObj.m_PosRadius = glm::vec4
-            (
-                obj.m_Centre.x * scaleFactor,
-                obj.m_Centre.y * scaleFactor,
-                obj.m_Centre.z * scaleFactor,
-                obj.m_Radius * scaleFactor
-            );
-            
-            engineObj.m_Color = glm::vec4(obj.m_Material.m_Color, 1.0f);
-            
             float volume  = (4.0f / 3.0f) * 3.14159f * engineObj.m_PosRadius.w * engineObj.m_PosRadius.w * engineObj.m_PosRadius.w;
             float density = 1e12f;
-            engineObj.m_Mass     = volume * density;
-            engineObj.m_Velocity = glm::vec3(0.0f, 0.0f, 0.0f);
-            
-            m_Objects.push_back(engineObj);
+            mass = volume * density;
         }
         
-        DONUT_INFO("Loaded {} objects from WorldBuilder scene (scaled up by {})", objects.size(), 1e10f);
-        PrintObjectInfo();
+        engineObj.m_Mass     = mass;
+        engineObj.m_Velocity = velocity * SceneScaleFactor;
+        
+        m_Objects.push_back(engineObj);
+    }
+    
+    void Engine::FinishLoadingObjects(const char* source)
+    {
+        RebuildObjectBVH();
+        SyncBodies();
+
+        DONUT_INFO("Loaded {} objects from {} (scaled up by {})", m_Objects.size() - 1, source, SceneScaleFactor);
+        
+        // Debris scenes would flood the log
+        if (m_Objects.size() <= 64)
+            PrintObjectInfo();
     }
     
     void Engine::PrintObjectInfo() const
@@ -399,14 +572,6 @@ namespace Donut
             return;
         }
         
-        int originalWidth = m_Width;
-        int originalHeight = m_Height;
-        int originalComputeHeight = m_ComputeHeight;
-        
-        m_Width = width;
-        m_Height = height;
-        m_ComputeHeight = height;
-        
         int computeHeight = height;
         int computeWidth = (width * computeHeight) / height;
         
@@ -416,115 +581,108 @@ namespace Donut
             return;
         }
         
-        FramebufferSpecification fbSpec;
-        fbSpec.Width = width;
-        fbSpec.Height = height;
-        fbSpec.Attachments = { FramebufferTextureFormat::RGBA8 };
-        
-        auto highResFramebuffer = Framebuffer::Create(fbSpec);
-        if (!highResFramebuffer)
-        {
-            DONUT_ERROR("Failed to create high-resolution framebuffer");
-            return;
-        }
-        
-        highResFramebuffer->Bind();
-        
-        RenderCommand::SetViewport(0, 0, width, height);
-        RenderCommand::Clear();
-        
-        auto highResTexture = Texture2D::Create(computeWidth, computeHeight);
-        if (!highResTexture)
-        {
-            DONUT_ERROR("Failed to create high-resolution texture");
-            return;
-        }
+        // The frame is built at the export size, then the window's size is back for the next one
+        int originalWidth = m_Width;
+        int originalHeight = m_Height;
+        int originalComputeHeight = m_ComputeHeight;
         
-        highResTexture->SetData(nullptr, computeWidth * computeHeight * 4);
-        m_ComputeProgram->Bind();
+        m_Width = width;
+        m_Height = height;
+        m_ComputeHeight = computeHeight;
         
-        struct UBOData
-        {
-            glm::vec3 pos;     float _pad0;
-            glm::vec3 right;   float _pad1;
-            glm::vec3 up;      float _pad2;
-            glm::vec3 forward; float _pad3;
-            float tanHalfFov;
-            float aspect;
-            bool  moving;
-            int   _pad4;
-        } data;
-
-        glm::vec3 fwd   = glm::normalize(m_Camera.GetOrbitalTarget() - m_Camera.GetOrbitalPosition());
-        glm::vec3 up    = glm::vec3(0, 1, 0);
-        glm::vec3 right = glm::normalize(glm::cross(fwd, up));
-        up = glm::cross(right, fwd);
+        EngineFrame frame = BuildFrame(m_Camera);
 
-        data.pos        = m_Camera.GetOrbitalPosition();
-        data.right      = right;
-        data.up         = up;
-        data.forward    = fwd;
-        data.tanHalfFov = static_cast<float>(tan(glm::radians(60.0f * 0.5f)));
-        data.aspect     = static_cast<float>(computeWidth) / static_cast<float>(computeHeight);
-        data.moving     = m_Camera.IsDragging() || m_Camera.IsPanning();
-
-        m_CameraUBO->SetData(&data, sizeof(UBOData));
-        m_CameraUBO->Bind(1);
-        
-        UploadDiskUBO();
-        UploadObjectsUBO(m_Objects);
-        UploadSimulationUBO();
-        highResTexture->BindAsImage(0, false);
-        
-        uint32_t groupsX = static_cast<uint32_t>(std::ceil(computeWidth / 16.0f));
-        uint32_t groupsY = static_cast<uint32_t>(std::ceil(computeHeight / 16.0f));
-        m_ComputeProgram->Dispatch(groupsX, groupsY, 1);
-        m_ComputeProgram->MemoryBarrier(IMAGE_ACCESS_BARRIER_BIT);
-        
-        m_ShaderProgram->Bind();
-        m_QuadVAO->Bind();
-        
-        highResTexture->Bind(0);
-        m_ShaderProgram->SetInt("u_ScreenTexture", 0);
-        
-        RenderCommand::DisableDepthTest();
-        RenderCommand::DrawArrays(6);
-        RenderCommand::EnableDepthTest();
-        
-        std::vector<unsigned char> pixels(width * height * 4);
-        DONUT_INFO("Reading {} pixels from framebuffer...", width * height);
-        RenderCommand::ReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
-        
-        DONUT_INFO("Flipping image vertically...");
-        std::vector<unsigned char> flippedPixels(width * height * 4);
-        for (int y = 0; y < height; ++y)
-        {
-            for (int x = 0; x < width; ++x)
-            {
-                int srcIndex = (y * width + x) * 4;
-                int dstIndex = ((height - 1 - y) * width + x) * 4;
-                flippedPixels[dstIndex + 0] = pixels[srcIndex + 0]; // R
-                flippedPixels[dstIndex + 1] = pixels[srcIndex + 1]; // G
-                flippedPixels[dstIndex + 2] = pixels[srcIndex + 2]; // B
-                flippedPixels[dstIndex + 3] = pixels[srcIndex + 3]; // A
-            }
-        }
-        
-        DONUT_INFO("Saving PNG file: {}...", filename);
-        int result = stbi_write_png(filename.c_str(), width, height, 4, flippedPixels.data(), width * 4);
-        
-        if (result)
-            DONUT_INFO("Successfully exported high-resolution frame to: {}", filename);
-        else
-            DONUT_ERROR("Failed to export high-resolution frame to: {}", filename);
-        
-        highResFramebuffer->Unbind();
+        // An object change consumed here was never traced on screen, so the next interactive
+        // frame must not reuse the last trace; no real frame matches a default one
+        if (frame.ObjectsChanged)
+            m_LastTraced = EngineFrame();
         
         m_Width         = originalWidth;
         m_Height        = originalHeight;
         m_ComputeHeight = originalComputeHeight;
         
-        RenderCommand::SetViewport(0, 0, originalWidth, originalHeight);
+        RenderThread::Execute([&]()
+        {
+            FramebufferSpecification fbSpec;
+            fbSpec.Width = width;
+            fbSpec.Height = height;
+            fbSpec.Attachments = { FramebufferTextureFormat::RGBA8 };
+            
+            auto highResFramebuffer = Framebuffer::Create(fbSpec);
+            if (!highResFramebuffer)
+            {
+                DONUT_ERROR("Failed to create high-resolution framebuffer");
+                return;
+            }
+            
+            highResFramebuffer->Bind();
+            
+            RenderCommand::SetViewport(0, 0, width, height);
+            RenderCommand::Clear();
+            
+            auto highResTexture = Texture2D::Create(computeWidth, computeHeight);
+            if (!highResTexture)
+            {
+                DONUT_ERROR("Failed to create high-resolution texture");
+                highResFramebuffer->Unbind();
+                return;
+            }
+            
+            // Every texel is overwritten by the dispatch, so the texture is not cleared first
+            m_ComputeProgram->Bind();
+            
+            m_UniformRing->BeginFrame();
+            UploadFrame(frame);
+            highResTexture->BindAsImage(0, false);
+            
+            if (frame.Environment)
+                frame.Environment->Bind(5);
+            
+            uint32_t groupsX = static_cast<uint32_t>(std::ceil(computeWidth / 16.0f));
+            uint32_t groupsY = static_cast<uint32_t>(std::ceil(computeHeight / 16.0f));
+            m_ComputeProgram->Dispatch(groupsX, groupsY, 1);
+            m_ComputeProgram->MemoryBarrier(IMAGE_ACCESS_BARRIER_BIT);
+            m_UniformRing->EndFrame();
+            
+            m_ShaderProgram->Bind();
+            m_QuadVAO->Bind();
+            
+            highResTexture->Bind(0);
+            m_ShaderProgram->SetInt("u_ScreenTexture", 0);
+            
+            RenderCommand::DisableDepthTest();
+            RenderCommand::DrawArrays(6);
+            RenderCommand::EnableDepthTest();
+            
+            std::vector<unsigned char> pixels(width * height * 4);
+            DONUT_INFO("Reading {} pixels from framebuffer...", width * height);
+            RenderCommand::ReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+            
+            // Flipping and PNG encoding happen on a worker so the frame is not held up
+            JobSystem::Run([pixels = std::move(pixels), filename, width, height]()
+            {
+                std::vector<unsigned char> flippedPixels(width * height * 4);
+                for (int y = 0; y < height; ++y)
+                {
+                    const unsigned char* src = pixels.data() + y * width * 4;
+                    unsigned char*       dst = flippedPixels.data() + (height - 1 - y) * width * 4;
+                    std::memcpy(dst, src, width * 4);
+                }
+
+                int result = stbi_write_png(filename.c_str(), width, height, 4, flippedPixels.data(), width * 4);
+
+                JobSystem::RunOnMainThread([result, filename]()
+                {
+                    if (result)
+                        DONUT_INFO("Successfully exported high-resolution frame to: {}", filename);
+                    else
+                        DONUT_ERROR("Failed to export high-resolution frame to: {}", filename);
+                });
+            });
+            
+            highResFramebuffer->Unbind();
+            RenderCommand::SetViewport(0, 0, originalWidth, originalHeight);
+        });
     }
     
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <vector>
 #include <numbers>
 #include <iostream>
@@ -10,12 +11,15 @@
 
 #include "Core/Camera.h"
 #include "Object.h"
+#include "BVH.h"
+#include "PhysicsThread.h"
 
 #include "Rendering/Renderer.h"
 #include "Rendering/Shader.h"
 #include "Rendering/VertexArray.h"
 #include "Rendering/Texture.h"
-#include "Rendering/UniformBuffer.h"
+#include "Rendering/UniformRingBuffer.h"
+#include "Rendering/StorageBuffer.h"
 #include "Rendering/TextureManager.h"
 
 #include <GLFW/glfw3.h>
@@ -51,32 +55,99 @@ namespace Donut
         }
     };
 
-    struct ObjectData
+    class SceneFile;
+
+    // The part of a frame the render thread needs from the simulation, copied by
+    // BuildFrame() so the main thread can move on to the next frame meanwhile
+    struct EngineFrame
     {
-        glm::vec4 m_PosRadius;
-        glm::vec4 m_Color;
-        float     m_Mass;
-        glm::vec3 m_Velocity = glm::vec3(0.0f, 0.0f, 0.0f);
+        // Uniform blocks of Geodesic.glsl
+        struct CameraBlock
+        {
+            glm::vec3 pos;     float _pad0;
+            glm::vec3 right;   float _pad1;
+            glm::vec3 up;      float _pad2;
+            glm::vec3 forward; float _pad3;
+            float tanHalfFov;
+            float aspect;
+            int   moving;
+            int   _pad4;
+        };
+
+        struct ObjectsBlock
+        {
+            int   numObjects;
+            int   numNodes;
+            float objectsReach;
+            int   _pad0;
+        };
+
+        struct SimulationBlock
+        {
+            int   maxStepsMoving;
+            int   maxStepsStatic;
+            float earlyExitDistance;
+            float time;
+        };
+
+        struct GPUObject
+        {
+            glm::vec4 m_PosRadius;
+            glm::vec4 m_Color;
+        };
+
+        CameraBlock     CameraData{};
+        float           DiskData[5] = {};
+        ObjectsBlock    ObjectsData{};
+        SimulationBlock SimulationData{};
+
+        // Only filled when the objects changed since the previous frame was built;
+        // otherwise the storage buffers already hold them
+        bool                   ObjectsChanged = false;
+        std::vector<GPUObject> Objects;
+        std::vector<BVHNode>   Nodes;
+
+        Ref<CubemapTexture> Environment;
+
+        int   Width         = 0;
+        int   Height        = 0;
+        int   ComputeWidth  = 0;
+        int   ComputeHeight = 0;
+        float BlurStrength  = 0.0f;
+        float GlowIntensity = 0.0f;
+        bool  Pipelined     = true;
+
+        // False when nothing the trace depends on changed since the previous frame was
+        // built, so the render thread presents the last trace again instead of dispatching
+        bool  Retrace       = true;
     };
 
     class Engine
     {
     public:
+        // Editor units to metres for scenes handed over from the WorldBuilder or a scene file
+        static constexpr float SceneScaleFactor = 1e10f;
+
         Engine();
         ~Engine() = default;
 
-        void DrawFullScreenQuad();
-        void DrawBlurPass();
-        void DispatchCompute(const Camera& cam);
-        void UploadCameraUBO(const Camera& cam);
-        void UploadObjectsUBO(const std::vector<ObjectData>& objs);
-        void UploadDiskUBO();
-        void UploadSimulationUBO();
+        // Main thread: copies what the trace of one frame depends on. Interactive frames may
+        // reuse the last trace when nothing changed; headless and export frames always trace.
+        EngineFrame BuildFrame(const Camera& cam, bool reuseUnchangedTrace = false);
+
+        // Render thread: everything below only reads the frame and the GPU-side members
+        void DispatchCompute(const EngineFrame& frame);
+        void DrawBlurPass(const EngineFrame& frame);
+        void DrawFullScreenQuad(const EngineFrame& frame);
         void RenderScene();
+
         void UpdatePhysics(float deltaTime);
-        void UpdateWindowDimensions();
         void SetWindowDimensions(int width, int height);
 
+        // Stops the physics thread and steps the bodies from UpdatePhysics instead, so the
+        // simulated state depends only on the delta times passed in, never on the wall clock
+        void SetLockstepPhysics(bool lockstep);
+
         int GetWidth()  const { return m_Width;  }
         int GetHeight() const { return m_Height; }
 
@@ -88,11 +159,20 @@ namespace Donut
         void  UpdatePerformance(float deltaTime);
         void  SetTargetFPS(int fps)        { m_TargetFPS = fps;                             }
         int   GetTargetFPS()         const { return m_TargetFPS;                            }
+        void  SetPhysicsRate(int hz)       { m_Physics.SetTickRate(hz);                     }
+        int   GetPhysicsRate()       const { return m_Physics.GetTickRate();                }
         float GetCurrentFPS()        const { return m_CurrentFPS;                           }
         void  SetComputeHeight(int height) { m_ComputeHeight = height;                      }
         int   GetComputeHeight()     const { return m_ComputeHeight;                        }
         int   GetComputeWidth()      const { return (m_Width * m_ComputeHeight) / m_Height; }
-        void  UpdateComputeDimensions();
+
+        // Presents the previous frame's trace so this frame's dispatch can overlap the blur; adds a frame of latency
+        void  SetPipelinedCompute(bool pipelined) { m_PipelinedCompute = pipelined; }
+        bool  IsPipelinedCompute()          const { return m_PipelinedCompute; }
+
+        // Interactive frames built since startup that needed a new trace, and that reused the last one
+        uint64_t GetIssuedDispatches()  const { return m_IssuedDispatches;  }
+        uint64_t GetSkippedDispatches() const { return m_SkippedDispatches; }
         
         int   GetMaxStepsMoving()    const { return m_MaxStepsMoving; }
         int   GetMaxStepsStatic()    const { return m_MaxStepsStatic; }
@@ -117,25 +197,68 @@ namespace Donut
         void  SetGlowIntensity(float intensity) { m_GlowIntensity = intensity; }
         
         void LoadObjectsFromScene(const std::vector<Donut::Object>& objects);
+        void LoadObjectsFromSceneFile(const SceneFile& file);
+        bool LoadSceneFromPath(const std::string& path);
         void ExportHighResFrame(const std::string& filename, int width = 4096, int height = 3072);
         void PrintObjectInfo() const;
-        
-        void SetHDRIEnvironment(Ref<CubemapTexture> hdri) { m_HDRIEnvironment = hdri; }
-        Ref<CubemapTexture> GetHDRIEnvironment()    const { return m_HDRIEnvironment; }
     private:
-        Ref<Shader> CreateComputeProgram(const char* path);
-        std::pair<Ref<VertexArray>, Ref<Texture2D>> QuadVAO();
+        struct UniformBlockCache
+        {
+            std::vector<uint8_t>          Data;
+            UniformRingBuffer::Allocation Allocation;
+        };
+
+        void BuildCameraBlock(EngineFrame& frame, const Camera& cam, float aspect) const;
+        void BuildDiskBlock(EngineFrame& frame) const;
+        void BuildObjectsBlock(EngineFrame& frame);
+        void BuildSimulationBlock(EngineFrame& frame) const;
+        bool TraceInputsChanged(const EngineFrame& frame);
+
+        void ResizeTraceTargets(uint32_t width, uint32_t height);
+        void PresentLatestTrace();
+        void UploadFrame(const EngineFrame& frame);
+        void UploadUniformBlock(uint32_t binding, const void* data, uint32_t size);
+
+        void BeginLoadingObjects(size_t count);
+        void AddSceneObject(const glm::vec3& centre, float radius, const glm::vec3& color, float mass, const glm::vec3& velocity);
+        void FinishLoadingObjects(const char* source);
+
+        void SyncBodies();
+        void ApplyPhysicsSnapshot();
+        void GatherObjectBounds();
+        void RebuildObjectBVH();
+        void RefitObjectBVH();
+
     private:
+        // Created once and only read afterwards
         Ref<VertexArray>   m_QuadVAO;
-        Ref<Texture2D>     m_Texture;
-        Ref<CubemapTexture> m_HDRIEnvironment;
         Ref<Shader>        m_ShaderProgram;
         Ref<Shader>        m_ComputeProgram;
         Ref<Shader>        m_BlurShader;
-        Ref<UniformBuffer> m_CameraUBO;
-        Ref<UniformBuffer> m_DiskUBO;
-        Ref<UniformBuffer> m_ObjectsUBO;
-        Ref<UniformBuffer> m_SimulationUBO;
+
+        // GPU side, only touched by the render thread
+        Ref<Texture2D>     m_Texture; // Trace read by the blur and present passes
+
+        // The geodesic pass alternates between two targets, so the trace being written
+        // is never the one post-processing reads while pipelined
+        std::array<Ref<Texture2D>, 2> m_TraceTargets;
+        uint32_t           m_TraceIndex     = 0;
+        uint32_t           m_TracedFrames   = 0;
+        bool               m_TracePipelined = true;
+        Ref<UniformRingBuffer> m_UniformRing;
+        std::array<UniformBlockCache, 5> m_UniformBlocks;
+        Ref<StorageBuffer>     m_ObjectBuffer;
+        Ref<StorageBuffer>     m_BVHBuffer;
+
+        // Simulation side, owned by the main thread
+        bool               m_PipelinedCompute = true;
+
+        // Trace inputs of the last frame built. The environment is only compared, never
+        // kept alive, since dropping the last reference here would delete it off the render thread.
+        EngineFrame                   m_LastTraced;
+        std::weak_ptr<CubemapTexture> m_LastTracedEnvironment;
+        uint64_t                      m_IssuedDispatches  = 0;
+        uint64_t                      m_SkippedDispatches = 0;
 
         int   m_Width;
         int   m_Height;
@@ -147,10 +270,22 @@ namespace Donut
         float m_LastFrameTime = 0.0f;
         int   m_ComputeHeight = 150;
 
+        // Animation clock advanced by UpdatePhysics, so a fixed step gives reproducible frames
+        double m_Time = 0.0;
+
         std::vector<ObjectData> m_Objects;
         BlackHole               m_SagA;
         Camera                  m_Camera;
         bool                    m_Gravity = false;
+
+        PhysicsThread           m_Physics;
+        bool                    m_LockstepPhysics = false;
+        double                  m_PhysicsLag      = 0.0; // Lockstep time not yet covered by a tick
+        BVH                     m_ObjectBVH;
+        std::vector<glm::vec4>  m_ObjectBounds;
+        uint64_t                m_ObjectsRevision      = 0;
+        uint64_t                m_BuiltObjectsRevision = ~0ull;
+        float                   m_ObjectsReach         = 0.0f;
         
         int   m_MaxStepsMoving    = 60000;
         int   m_MaxStepsStatic    = 30000;
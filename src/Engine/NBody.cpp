@@ -0,0 +1,416 @@
+#include "NBody.h"
+
+#include <cmath>
+#include <algorithm>
+
+#include "Core/JobSystem.h"
+
+namespace Donut
+{
+    static constexpr double   GravitationalConstant  = 6.67430e-11;
+    static constexpr size_t   SimdLanes              = 4;
+    static constexpr uint32_t MaxOctreeDepth         = 32;
+    static constexpr size_t   ParallelBuildThreshold = 8192;
+    static constexpr size_t   MinBodiesPerTask       = 256;
+
+    static uint32_t ChunkSize(size_t count)
+    {
+        size_t workers = std::max<uint32_t>(1, JobSystem::GetWorkerCount());
+        return static_cast<uint32_t>(std::max(MinBodiesPerTask, count / (workers * 4)));
+    }
+
+    static glm::dvec3 OctantCentre(const glm::dvec3& centre, double halfSize, uint32_t octant)
+    {
+        double q = halfSize * 0.5;
+        return centre + glm::dvec3((octant & 1) ? q : -q, 
+                                   (octant & 2) ? q : -q, 
+                                   (octant & 4) ? q : -q);
+    }
+
+    void NBodySystem::Clear()
+    {
+        for (auto* array : { &m_PosX, &m_PosY, &m_PosZ, &m_VelX, &m_VelY, &m_VelZ, 
+                             &m_AccX, &m_AccY, &m_AccZ, &m_Mass, &m_Movable })
+            array->clear();
+
+        m_Order.clear();
+        m_OrderScratch.clear();
+        m_Octree.clear();
+
+        m_AccelerationsValid = false;
+    }
+
+    void NBodySystem::Reserve(size_t count)
+    {
+        for (auto* array : { &m_PosX, &m_PosY, &m_PosZ, &m_VelX, &m_VelY, &m_VelZ, 
+                             &m_AccX, &m_AccY, &m_AccZ, &m_Mass, &m_Movable })
+            array->reserve(count);
+
+        m_Order.reserve(count);
+        m_OrderScratch.reserve(count);
+    }
+
+    void NBodySystem::AddBody(const glm::dvec3& position, const glm::dvec3& velocity, double mass, bool movable)
+    {
+        m_PosX.push_back(position.x);
+        m_PosY.push_back(position.y);
+        m_PosZ.push_back(position.z);
+        m_VelX.push_back(velocity.x);
+        m_VelY.push_back(velocity.y);
+        m_VelZ.push_back(velocity.z);
+        m_AccX.push_back(0.0);
+        m_AccY.push_back(0.0);
+        m_AccZ.push_back(0.0);
+        m_Mass.push_back(mass);
+        m_Movable.push_back(movable ? 1.0 : 0.0);
+        m_Order.push_back(static_cast<uint32_t>(m_Order.size()));
+        m_OrderScratch.push_back(0);
+
+        m_AccelerationsValid = false;
+    }
+
+    void NBodySystem::Step(double h)
+    {
+        const size_t count = m_Mass.size();
+        if (count == 0)
+            return;
+
+        if (!m_AccelerationsValid)
+            ComputeAccelerations();
+
+        const double halfH = 0.5 * h;
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            const double kick = halfH * m_Movable[i];
+            m_VelX[i] += m_AccX[i] * kick;
+            m_VelY[i] += m_AccY[i] * kick;
+            m_VelZ[i] += m_AccZ[i] * kick;
+
+            const double drift = h * m_Movable[i];
+            m_PosX[i] += m_VelX[i] * drift;
+            m_PosY[i] += m_VelY[i] * drift;
+            m_PosZ[i] += m_VelZ[i] * drift;
+        }
+
+        ComputeAccelerations();
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            const double kick = halfH * m_Movable[i];
+            m_VelX[i] += m_AccX[i] * kick;
+            m_VelY[i] += m_AccY[i] * kick;
+            m_VelZ[i] += m_AccZ[i] * kick;
+        }
+    }
+
+    void NBodySystem::ComputeAccelerations()
+    {
+        const size_t count = m_Mass.size();
+
+        if (count < m_DirectThreshold)
+        {
+            JobSystem::ParallelFor(static_cast<uint32_t>(count), ChunkSize(count), 
+                [this](uint32_t begin, uint32_t end) { ComputeAccelerationsDirect(begin, end); });
+        }
+        else
+        {
+            BuildOctree();
+            JobSystem::ParallelFor(static_cast<uint32_t>(count), ChunkSize(count), 
+                [this](uint32_t begin, uint32_t end) { ComputeAccelerationsOctree(begin, end); });
+        }
+
+        m_AccelerationsValid = true;
+    }
+
+    void NBodySystem::ComputeAccelerationsDirect(size_t begin, size_t end)
+    {
+        const size_t  count    = m_Mass.size();
+        const size_t  simdEnd  = count - count % SimdLanes;
+        const double  eps2     = m_Softening * m_Softening;
+        const double* px       = m_PosX.data();
+        const double* py       = m_PosY.data();
+        const double* pz       = m_PosZ.data();
+        const double* mass     = m_Mass.data();
+
+        for (size_t i = begin; i < end; ++i)
+        {
+            const double xi = px[i], yi = py[i], zi = pz[i];
+
+            // Independent per-lane partial sums keep the inner loop free of a
+            // serial dependency so it vectorises without fast-math reassociation.
+            // The self term vanishes because its displacement is zero.
+            double ax[SimdLanes] = {}, ay[SimdLanes] = {}, az[SimdLanes] = {};
+            for (size_t j = 0; j < simdEnd; j += SimdLanes)
+            {
+                for (size_t l = 0; l < SimdLanes; ++l)
+                {
+                    const double dx    = px[j + l] - xi;
+                    const double dy    = py[j + l] - yi;
+                    const double dz    = pz[j + l] - zi;
+                    const double r2    = dx * dx + dy * dy + dz * dz + eps2;
+                    const double invR  = 1.0 / std::sqrt(r2);
+                    const double scale = mass[j + l] * invR * invR * invR;
+                    ax[l] += dx * scale;
+                    ay[l] += dy * scale;
+                    az[l] += dz * scale;
+                }
+            }
+
+            for (size_t j = simdEnd; j < count; ++j)
+            {
+                const double dx    = px[j] - xi;
+                const double dy    = py[j] - yi;
+                const double dz    = pz[j] - zi;
+                const double r2    = dx * dx + dy * dy + dz * dz + eps2;
+                const double invR  = 1.0 / std::sqrt(r2);
+                const double scale = mass[j] * invR * invR * invR;
+                ax[0] += dx * scale;
+                ay[0] += dy * scale;
+                az[0] += dz * scale;
+            }
+
+            m_AccX[i] = GravitationalConstant * ((ax[0] + ax[1]) + (ax[2] + ax[3]));
+            m_AccY[i] = GravitationalConstant * ((ay[0] + ay[1]) + (ay[2] + ay[3]));
+            m_AccZ[i] = GravitationalConstant * ((az[0] + az[1]) + (az[2] + az[3]));
+        }
+    }
+
+    void NBodySystem::ComputeAccelerationsOctree(size_t begin, size_t end)
+    {
+        const double eps2   = m_Softening * m_Softening;
+        const double theta2 = m_OpeningAngle * m_OpeningAngle;
+
+        std::array<uint32_t, MaxOctreeDepth * 7 + 1> stack;
+
+        for (size_t i = begin; i < end; ++i)
+        {
+            const double xi = m_PosX[i], yi = m_PosY[i], zi = m_PosZ[i];
+            double ax = 0.0, ay = 0.0, az = 0.0;
+
+            uint32_t sp = 0;
+            stack[sp++] = 0;
+            while (sp > 0)
+            {
+                const OctreeNode& node = m_Octree[stack[--sp]];
+
+                if (node.Leaf)
+                {
+                    for (uint32_t k = node.First; k < node.First + node.Count; ++k)
+                    {
+                        const uint32_t j     = m_Order[k];
+                        const double   dx    = m_PosX[j] - xi;
+                        const double   dy    = m_PosY[j] - yi;
+                        const double   dz    = m_PosZ[j] - zi;
+                        const double   r2    = dx * dx + dy * dy + dz * dz + eps2;
+                        const double   invR  = 1.0 / std::sqrt(r2);
+                        const double   scale = m_Mass[j] * invR * invR * invR;
+                        ax += dx * scale;
+                        ay += dy * scale;
+                        az += dz * scale;
+                    }
+                    continue;
+                }
+
+                const double dx = node.ComX - xi;
+                const double dy = node.ComY - yi;
+                const double dz = node.ComZ - zi;
+                const double d2 = dx * dx + dy * dy + dz * dz;
+
+                if (node.Size * node.Size < theta2 * d2)
+                {
+                    const double invR  = 1.0 / std::sqrt(d2 + eps2);
+                    const double scale = node.Mass * invR * invR * invR;
+                    ax += dx * scale;
+                    ay += dy * scale;
+                    az += dz * scale;
+                    continue;
+                }
+
+                for (uint32_t c = 0; c < node.Count; ++c)
+                    stack[sp++] = node.First + c;
+            }
+
+            m_AccX[i] = GravitationalConstant * ax;
+            m_AccY[i] = GravitationalConstant * ay;
+            m_AccZ[i] = GravitationalConstant * az;
+        }
+    }
+
+    void NBodySystem::BuildOctree()
+    {
+        const size_t count = m_Mass.size();
+        m_Octree.clear();
+        if (count == 0)
+            return;
+
+        glm::dvec3 boundsMin(m_PosX[0], m_PosY[0], m_PosZ[0]);
+        glm::dvec3 boundsMax = boundsMin;
+        for (size_t i = 1; i < count; ++i)
+        {
+            glm::dvec3 p(m_PosX[i], m_PosY[i], m_PosZ[i]);
+            boundsMin = glm::min(boundsMin, p);
+            boundsMax = glm::max(boundsMax, p);
+        }
+
+        glm::dvec3 extent   = boundsMax - boundsMin;
+        glm::dvec3 centre   = (boundsMin + boundsMax) * 0.5;
+        double     halfSize = std::max({ extent.x, extent.y, extent.z, m_Softening }) * 0.5 * 1.0001;
+
+        m_Octree.resize(1);
+        if (count < ParallelBuildThreshold)
+        {
+            BuildOctreeNode(m_Octree, 0, 0, static_cast<uint32_t>(count), centre, halfSize, 0);
+            return;
+        }
+
+        // Split the root here, then build each octant's subtree on its own task into its own pool
+        std::array<uint32_t, 9> offsets;
+        uint32_t childCount = PartitionOctants(0, static_cast<uint32_t>(count), centre, offsets);
+
+        JobSystem::ParallelFor(8, 1, [&](uint32_t begin, uint32_t end)
+        {
+            for (uint32_t octant = begin; octant < end; ++octant)
+            {
+                auto& pool = m_OctantPools[octant];
+                pool.clear();
+
+                uint32_t octantCount = offsets[octant + 1] - offsets[octant];
+                if (octantCount == 0)
+                    continue;
+
+                pool.resize(1);
+                BuildOctreeNode(pool, 0, offsets[octant], octantCount, 
+                                OctantCentre(centre, halfSize, octant), halfSize * 0.5, 1);
+            }
+        });
+
+        // Stitch the pools together: octant roots become the root's contiguous
+        // children, and the rest of each pool follows with its links rebased
+        m_Octree.resize(1 + childCount);
+        uint32_t slot = 1;
+        uint32_t base = 1 + childCount;
+
+        OctreeNode& root = m_Octree[0];
+        root = { 0.0, 0.0, 0.0, 0.0, halfSize * 2.0, 1, childCount, false };
+
+        for (auto& pool : m_OctantPools)
+        {
+            if (pool.empty())
+                continue;
+
+            for (size_t j = 0; j < pool.size(); ++j)
+            {
+                OctreeNode node = pool[j];
+                if (!node.Leaf)
+                    node.First = base + node.First - 1;
+
+                if (j == 0)
+                    m_Octree[slot] = node;
+                else
+                    m_Octree.push_back(node);
+            }
+
+            const OctreeNode& child = m_Octree[slot];
+            m_Octree[0].Mass += child.Mass;
+            m_Octree[0].ComX += child.ComX * child.Mass;
+            m_Octree[0].ComY += child.ComY * child.Mass;
+            m_Octree[0].ComZ += child.ComZ * child.Mass;
+
+            base += static_cast<uint32_t>(pool.size()) - 1;
+            slot++;
+        }
+
+        OctreeNode& merged = m_Octree[0];
+        if (merged.Mass > 0.0)
+        {
+            merged.ComX /= merged.Mass;
+            merged.ComY /= merged.Mass;
+            merged.ComZ /= merged.Mass;
+        }
+        else
+        {
+            merged.ComX = centre.x;
+            merged.ComY = centre.y;
+            merged.ComZ = centre.z;
+        }
+    }
+
+    void NBodySystem::BuildOctreeNode(std::vector<OctreeNode>& pool, uint32_t nodeIndex, uint32_t first, uint32_t count, 
+                                      const glm::dvec3& centre, double halfSize, uint32_t depth)
+    {
+        double mass = 0.0;
+        glm::dvec3 weighted(0.0);
+
+        if (count <= OctreeLeafSize || depth >= MaxOctreeDepth)
+        {
+            for (uint32_t k = first; k < first + count; ++k)
+            {
+                uint32_t j = m_Order[k];
+                mass     += m_Mass[j];
+                weighted += glm::dvec3(m_PosX[j], m_PosY[j], m_PosZ[j]) * m_Mass[j];
+            }
+
+            glm::dvec3 com = mass > 0.0 ? weighted / mass : centre;
+            pool[nodeIndex] = { com.x, com.y, com.z, mass, halfSize * 2.0, first, count, true };
+            return;
+        }
+
+        std::array<uint32_t, 9> offsets;
+        uint32_t childCount = PartitionOctants(first, count, centre, offsets);
+        uint32_t firstChild = static_cast<uint32_t>(pool.size());
+        pool.resize(pool.size() + childCount);
+
+        uint32_t child = firstChild;
+        for (uint32_t octant = 0; octant < 8; ++octant)
+        {
+            uint32_t octantCount = offsets[octant + 1] - offsets[octant];
+            if (octantCount == 0)
+                continue;
+
+            BuildOctreeNode(pool, child, offsets[octant], octantCount, 
+                            OctantCentre(centre, halfSize, octant), halfSize * 0.5, depth + 1);
+
+            mass     += pool[child].Mass;
+            weighted += glm::dvec3(pool[child].ComX, pool[child].ComY, pool[child].ComZ) * pool[child].Mass;
+            child++;
+        }
+
+        glm::dvec3 com = mass > 0.0 ? weighted / mass : centre;
+        pool[nodeIndex] = { com.x, com.y, com.z, mass, halfSize * 2.0, firstChild, childCount, false };
+    }
+
+    uint32_t NBodySystem::PartitionOctants(uint32_t first, uint32_t count, const glm::dvec3& centre, 
+                                           std::array<uint32_t, 9>& offsets)
+    {
+        auto octantOf = [&](uint32_t j)
+        {
+            return (m_PosX[j] >= centre.x ? 1u : 0u) | 
+                   (m_PosY[j] >= centre.y ? 2u : 0u) | 
+                   (m_PosZ[j] >= centre.z ? 4u : 0u);
+        };
+
+        std::array<uint32_t, 8> counts = {};
+        for (uint32_t k = first; k < first + count; ++k)
+            counts[octantOf(m_Order[k])]++;
+
+        uint32_t nonEmpty = 0;
+        offsets[0] = first;
+        for (uint32_t octant = 0; octant < 8; ++octant)
+        {
+            offsets[octant + 1] = offsets[octant] + counts[octant];
+            nonEmpty += counts[octant] > 0 ? 1 : 0;
+        }
+
+        std::array<uint32_t, 8> cursor;
+        std::copy(offsets.begin(), offsets.begin() + 8, cursor.begin());
+        for (uint32_t k = first; k < first + count; ++k)
+        {
+            uint32_t j = m_Order[k];
+            m_OrderScratch[cursor[octantOf(j)]++] = j;
+        }
+
+        std::copy(m_OrderScratch.begin() + first, m_OrderScratch.begin() + first + count, m_Order.begin() + first);
+        return nonEmpty;
+    }
+};
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+namespace Donut
+{
+    // Gravitational N-body integrator over a structure-of-arrays body store.
+    // Step() integrates one kick-drift-kick leapfrog step; PhysicsThread calls it
+    // at a fixed rate, so orbits do not depend on frame rate.
+    // Below m_DirectThreshold bodies forces are summed directly; above it a
+    // Barnes-Hut octree is rebuilt every step from pooled node storage.
+    class NBodySystem
+    {
+    public:
+        static constexpr uint32_t OctreeLeafSize = 8;
+
+        void Clear();
+        void Reserve(size_t count);
+        void AddBody(const glm::dvec3& position, const glm::dvec3& velocity, double mass, bool movable = true);
+
+        void Step(double h);
+
+        // Forces at the current positions, read back through GetAcceleration(). The ranged
+        // direct sum runs on the calling thread, e.g. as a reference for a sample of bodies.
+        void ComputeAccelerations();
+        void ComputeAccelerationsDirect(size_t begin, size_t end);
+
+        glm::dvec3 GetPosition(size_t i) const { return { m_PosX[i], m_PosY[i], m_PosZ[i] }; }
+        glm::dvec3 GetVelocity(size_t i) const { return { m_VelX[i], m_VelY[i], m_VelZ[i] }; }
+        glm::dvec3 GetAcceleration(size_t i) const { return { m_AccX[i], m_AccY[i], m_AccZ[i] }; }
+        size_t     GetBodyCount()        const { return m_Mass.size(); }
+
+        void   SetFixedTimeStep(double step) { m_FixedTimeStep = step;  }
+        double GetFixedTimeStep()      const { return m_FixedTimeStep;  }
+        void   SetTimeScale(double scale)    { m_TimeScale = scale;     }
+        double GetTimeScale()          const { return m_TimeScale;      }
+
+        // Barnes-Hut opening angle: a cell of size s at distance d is treated as a point mass when s/d < theta
+        void   SetOpeningAngle(double theta)          { m_OpeningAngle = theta;       }
+        double GetOpeningAngle()                const { return m_OpeningAngle;        }
+        void   SetDirectThreshold(size_t bodyCount)   { m_DirectThreshold = bodyCount; }
+        size_t GetDirectThreshold()             const { return m_DirectThreshold;     }
+    private:
+        struct OctreeNode
+        {
+            double   ComX, ComY, ComZ;
+            double   Mass;
+            double   Size;
+            uint32_t First; // First child node, or first entry in m_Order for leaves
+            uint32_t Count; // Child count, or body count for leaves
+            bool     Leaf;
+        };
+
+        void ComputeAccelerationsOctree(size_t begin, size_t end);
+
+        void BuildOctree();
+        void BuildOctreeNode(std::vector<OctreeNode>& pool, uint32_t nodeIndex, uint32_t first, uint32_t count, 
+                             const glm::dvec3& centre, double halfSize, uint32_t depth);
+        uint32_t PartitionOctants(uint32_t first, uint32_t count, const glm::dvec3& centre, 
+                                  std::array<uint32_t, 9>& offsets);
+    private:
+        std::vector<double> m_PosX, m_PosY, m_PosZ;
+        std::vector<double> m_VelX, m_VelY, m_VelZ;
+        std::vector<double> m_AccX, m_AccY, m_AccZ;
+        std::vector<double> m_Mass;
+        std::vector<double> m_Movable; // 1.0 for dynamic bodies, 0.0 for pinned ones
+
+        std::vector<OctreeNode>                m_Octree;
+        std::array<std::vector<OctreeNode>, 8> m_OctantPools;
+        std::vector<uint32_t>                  m_Order;
+        std::vector<uint32_t>                  m_OrderScratch;
+
+        bool     m_AccelerationsValid = false;
+        double   m_FixedTimeStep      = 1.0 / 60.0; // Real seconds per step
+        double   m_TimeScale          = 60.0;       // Simulated seconds per real second
+        double   m_Softening          = 1e7;        // Metres
+        double   m_OpeningAngle       = 0.5;
+        size_t   m_DirectThreshold    = 1024;
+    };
+};
@@ -35,6 +35,10 @@ namespace Donut
         glm::vec3 m_Centre;
         float     m_Radius;
         Material  m_Material;
+
+        // Only simulation scenes set these; a mass of zero is derived from the radius
+        float     m_Mass     = 0.0f;
+        glm::vec3 m_Velocity = glm::vec3(0.0f, 0.0f, 0.0f);
     
         Object() : m_Centre(0.0f, 0.0f, 0.0f), m_Radius(1.0f), m_Material() { }
         Object(glm::vec3 c, float r, Material m) 
@@ -42,7 +46,7 @@ namespace Donut
               m_Radius(r), 
               m_Material(m) { }
     
-        bool Intersect(Ray &ray, float &t)
+        bool Intersect(const Ray &ray, float &t) const
         {
             glm::vec3 oc = ray.m_Origin - m_Centre;
             float a = glm::dot(ray.m_Direction, ray.m_Direction); 
@@ -65,9 +69,17 @@ namespace Donut
             return true;
         }
     
-        glm::vec3 GetNormal(glm::vec3 &point) const
+        glm::vec3 GetNormal(const glm::vec3& point) const
         {
             return glm::normalize(point - m_Centre);
         }
     };
+
+    struct ObjectData
+    {
+        glm::vec4 m_PosRadius;
+        glm::vec4 m_Color;
+        float     m_Mass;
+        glm::vec3 m_Velocity = glm::vec3(0.0f, 0.0f, 0.0f);
+    };
 };
@@ -0,0 +1,138 @@
+#include "PhysicsThread.h"
+
+#include <chrono>
+#include <algorithm>
+
+#include "Core/Log.h"
+
+namespace Donut
+{
+    static constexpr uint32_t MaxCatchUpSteps = 8;
+
+    PhysicsThread::~PhysicsThread()
+    {
+        Stop();
+    }
+
+    void PhysicsThread::Start()
+    {
+        if (m_Thread.joinable())
+            return;
+
+        m_StopRequested = false;
+        m_Thread = std::thread(&PhysicsThread::Run, this);
+        DONUT_INFO("Physics thread started at {} Hz", GetTickRate());
+    }
+
+    void PhysicsThread::Stop()
+    {
+        if (!m_Thread.joinable())
+            return;
+
+        m_StopRequested = true;
+        m_Thread.join();
+    }
+
+    void PhysicsThread::Reset(const std::vector<ObjectData>& objects)
+    {
+        std::lock_guard<std::mutex> lock(m_StateMutex);
+
+        m_Objects = objects;
+        m_Bodies.Clear();
+        m_Bodies.Reserve(objects.size());
+        for (size_t i = 0; i < objects.size(); ++i)
+        {
+            const ObjectData& obj = objects[i];
+            m_Bodies.AddBody(glm::dvec3(glm::vec3(obj.m_PosRadius)), glm::dvec3(obj.m_Velocity), obj.m_Mass, i != 0);
+        }
+
+        m_LastPublished.resize(objects.size());
+        for (size_t i = 0; i < objects.size(); ++i)
+            m_LastPublished[i] = glm::vec3(objects[i].m_PosRadius);
+
+        m_Generation.fetch_add(1, std::memory_order_release);
+        Publish(Now(), 1.0 / GetTickRate());
+    }
+
+    void PhysicsThread::SetTickRate(int hz)
+    {
+        m_TickRate.store(std::max(1, hz), std::memory_order_relaxed);
+    }
+
+    double PhysicsThread::Now()
+    {
+        using namespace std::chrono;
+        return duration<double>(steady_clock::now().time_since_epoch()).count();
+    }
+
+    void PhysicsThread::Run()
+    {
+        using namespace std::chrono;
+
+        auto nextTick = steady_clock::now();
+        while (!m_StopRequested.load(std::memory_order_relaxed))
+        {
+            const int    tickRate = GetTickRate();
+            const auto   period   = duration_cast<steady_clock::duration>(duration<double>(1.0 / tickRate));
+            const auto   now      = steady_clock::now();
+
+            if (now < nextTick)
+            {
+                std::this_thread::sleep_until(nextTick);
+                continue;
+            }
+
+            uint32_t steps = 0;
+            while (nextTick <= now && steps < MaxCatchUpSteps)
+            {
+                nextTick += period;
+                steps++;
+            }
+
+            // Fell too far behind; resynchronise instead of spiralling
+            if (nextTick <= now)
+                nextTick = now + period;
+
+            if (!IsRunning())
+                continue;
+
+            std::lock_guard<std::mutex> lock(m_StateMutex);
+            StepLocked(steps, tickRate);
+            Publish(Now(), static_cast<double>(steps) / tickRate);
+        }
+    }
+
+    void PhysicsThread::StepNow(uint32_t steps)
+    {
+        std::lock_guard<std::mutex> lock(m_StateMutex);
+        StepLocked(steps, GetTickRate());
+        Publish(Now(), 0.0);
+    }
+
+    void PhysicsThread::StepLocked(uint32_t steps, int tickRate)
+    {
+        m_Bodies.SetFixedTimeStep(1.0 / tickRate);
+        for (uint32_t i = 0; i < steps; ++i)
+            m_Bodies.Step(m_Bodies.GetFixedTimeStep() * m_Bodies.GetTimeScale());
+    }
+
+    void PhysicsThread::Publish(double time, double stepDuration)
+    {
+        PhysicsSnapshot& snapshot = m_Snapshots.GetBack();
+        snapshot.Objects           = m_Objects;
+        snapshot.PreviousPositions = m_LastPublished;
+        snapshot.Time              = time;
+        snapshot.StepDuration      = stepDuration;
+        snapshot.Generation        = m_Generation.load(std::memory_order_relaxed);
+
+        for (size_t i = 0; i < snapshot.Objects.size() && i < m_Bodies.GetBodyCount(); ++i)
+        {
+            glm::vec3 position = glm::vec3(m_Bodies.GetPosition(i));
+            snapshot.Objects[i].m_PosRadius = glm::vec4(position, snapshot.Objects[i].m_PosRadius.w);
+            snapshot.Objects[i].m_Velocity  = glm::vec3(m_Bodies.GetVelocity(i));
+            m_LastPublished[i]              = position;
+        }
+
+        m_Snapshots.Publish();
+    }
+};
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Object.h"
+#include "NBody.h"
+#include "Core/TripleBuffer.h"
+
+namespace Donut
+{
+    struct PhysicsSnapshot
+    {
+        std::vector<ObjectData> Objects;           // State at Time
+        std::vector<glm::vec3>  PreviousPositions; // State one publish earlier
+        double                  Time         = 0.0;
+        double                  StepDuration = 0.0;
+        uint64_t                Generation   = 0;
+    };
+
+    // Steps an NBodySystem at a fixed rate on its own thread and publishes
+    // snapshots through a triple buffer, so building a frame never waits on it.
+    class PhysicsThread
+    {
+    public:
+        PhysicsThread() = default;
+        ~PhysicsThread();
+
+        void Start();
+        void Stop();
+
+        // Replaces the simulated bodies; the first object is pinned in place
+        void Reset(const std::vector<ObjectData>& objects);
+
+        void SetRunning(bool running) { m_Running.store(running, std::memory_order_relaxed); }
+        bool IsRunning()        const { return m_Running.load(std::memory_order_relaxed); }
+
+        void SetTickRate(int hz);
+        int  GetTickRate()      const { return m_TickRate.load(std::memory_order_relaxed); }
+
+        // Runs ticks on the calling thread instead of the timer, for when the thread is stopped.
+        // The snapshot is published with no step duration, so frames show it without blending.
+        void StepNow(uint32_t steps);
+
+        // Reader side, used while building a frame: swaps in the newest snapshot if one was published
+        bool                   AcquireSnapshot() { return m_Snapshots.Acquire(); }
+        const PhysicsSnapshot& GetSnapshot() const { return m_Snapshots.GetFront(); }
+        uint64_t               GetGeneration() const { return m_Generation.load(std::memory_order_acquire); }
+
+        static double Now();
+    private:
+        void Run();
+        void StepLocked(uint32_t steps, int tickRate);
+        void Publish(double time, double stepDuration);
+    private:
+        std::thread      m_Thread;
+        std::mutex       m_StateMutex;
+        std::atomic_bool m_StopRequested = false;
+        std::atomic_bool m_Running       = false;
+        std::atomic_int  m_TickRate      = 60;
+
+        NBodySystem                   m_Bodies;
+        std::vector<ObjectData>       m_Objects;
+        std::vector<glm::vec3>        m_LastPublished;
+        std::atomic<uint64_t>         m_Generation = 0;
+        TripleBuffer<PhysicsSnapshot> m_Snapshots;
+    };
+};
@@ -0,0 +1,231 @@
+#include "PreviewRenderer.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "stb_image_write.h"
+
+#include "Core/Log.h"
+#include "Core/JobSystem.h"
+#include "Core/RenderThread.h"
+
+namespace Donut
+{
+    PreviewRenderer::~PreviewRenderer()
+    {
+        Cancel();
+    }
+
+    void PreviewRenderer::Start(Scene scene, const glm::mat4& view, const glm::mat4& projection, uint32_t width, uint32_t height)
+    {
+        Cancel();
+
+        if (width == 0 || height == 0)
+            return;
+
+        if (!m_Texture || width != m_Width || height != m_Height)
+        {
+            RenderThread::Execute([&]() { m_Texture = Texture2D::Create(width, height); });
+            m_Width  = width;
+            m_Height = height;
+        }
+
+        auto frame = CreateRef<Frame>();
+        frame->Source = std::move(scene);
+        frame->Source.UpdateBVH();
+        frame->InverseViewProjection = glm::inverse(projection * view);
+        frame->Width     = width;
+        frame->Height    = height;
+        frame->TileOrder = GetTileOrder(width, height);
+        frame->Pixels.resize(static_cast<size_t>(width) * height * 4);
+        m_Frame = frame;
+
+        // Jobs own the frame, so cancelling only has to flag it and let them drain
+        for (uint32_t tile : frame->TileOrder)
+        {
+            JobSystem::Run([frame, tile]()
+            {
+                if (frame->Cancelled.load(std::memory_order_relaxed))
+                    return;
+
+                TraceTile(frame->Source, frame->InverseViewProjection, frame->Width, frame->Height, tile, frame->Pixels.data());
+
+                std::lock_guard<std::mutex> lock(frame->FinishedMutex);
+                frame->FinishedTiles.push_back(tile);
+            });
+        }
+    }
+
+    void PreviewRenderer::Cancel()
+    {
+        if (!m_Frame)
+            return;
+
+        m_Frame->Cancelled = true;
+        m_Frame.reset();
+    }
+
+    RenderCommandFn PreviewRenderer::Update()
+    {
+        if (!m_Frame || !m_Texture)
+            return {};
+
+        std::vector<uint32_t> finished;
+        {
+            std::lock_guard<std::mutex> lock(m_Frame->FinishedMutex);
+            finished.swap(m_Frame->FinishedTiles);
+        }
+
+        if (finished.empty())
+            return {};
+
+        m_Frame->TilesUploaded += static_cast<uint32_t>(finished.size());
+
+        // Finished tiles are never written again, and the command keeps the frame's pixels alive
+        return [frame = m_Frame, texture = m_Texture, finished = std::move(finished)]()
+        {
+            uint32_t tilesX = (frame->Width + TileSize - 1) / TileSize;
+            for (uint32_t tile : finished)
+            {
+                uint32_t x0 = (tile % tilesX) * TileSize;
+                uint32_t y0 = (tile / tilesX) * TileSize;
+                uint32_t tileWidth  = std::min(TileSize, frame->Width  - x0);
+                uint32_t tileHeight = std::min(TileSize, frame->Height - y0);
+
+                const uint8_t* data = frame->Pixels.data() + (static_cast<size_t>(y0) * frame->Width + x0) * 4;
+                texture->SetSubData(data, x0, y0, tileWidth, tileHeight, frame->Width);
+            }
+        };
+    }
+
+    bool PreviewRenderer::IsComplete() const
+    {
+        return m_Frame && m_Frame->TilesUploaded == m_Frame->TileOrder.size();
+    }
+
+    float PreviewRenderer::GetProgress() const
+    {
+        if (!m_Frame || m_Frame->TileOrder.empty())
+            return 0.0f;
+
+        return static_cast<float>(m_Frame->TilesUploaded) / static_cast<float>(m_Frame->TileOrder.size());
+    }
+
+    const std::vector<uint8_t>& PreviewRenderer::GetPixels() const
+    {
+        static const std::vector<uint8_t> empty;
+        return IsComplete() ? m_Frame->Pixels : empty;
+    }
+
+    void PreviewRenderer::Render(const Scene& scene, const glm::mat4& view, const glm::mat4& projection,
+                                 uint32_t width, uint32_t height, std::vector<uint8_t>& pixels)
+    {
+        pixels.assign(static_cast<size_t>(width) * height * 4, 0);
+        if (width == 0 || height == 0)
+            return;
+
+        glm::mat4 inverseViewProjection = glm::inverse(projection * view);
+        JobSystem::ParallelFor(GetTileCount(width, height), 1, [&](uint32_t begin, uint32_t end)
+        {
+            for (uint32_t tile = begin; tile < end; ++tile)
+                TraceTile(scene, inverseViewProjection, width, height, tile, pixels.data());
+        });
+    }
+
+    bool PreviewRenderer::SaveImage(const std::string& path, const std::vector<uint8_t>& pixels, uint32_t width, uint32_t height)
+    {
+        size_t rowSize = static_cast<size_t>(width) * 4;
+        if (width == 0 || height == 0 || pixels.size() != rowSize * height)
+        {
+            DONUT_ERROR("No preview image to save to: {}", path);
+            return false;
+        }
+
+        std::vector<uint8_t> flipped(pixels.size());
+        for (uint32_t y = 0; y < height; ++y)
+            std::memcpy(flipped.data() + (height - 1 - y) * rowSize, pixels.data() + y * rowSize, rowSize);
+
+        if (!stbi_write_png(path.c_str(), width, height, 4, flipped.data(), static_cast<int>(rowSize)))
+        {
+            DONUT_ERROR("Failed to write preview image: {}", path);
+            return false;
+        }
+
+        DONUT_INFO("Saved preview image: {} ({}x{})", path, width, height);
+        return true;
+    }
+
+    Ray PreviewRenderer::GetPixelRay(const glm::mat4& inverseViewProjection, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+    {
+        float ndcX = (2.0f * (static_cast<float>(x) + 0.5f)) / static_cast<float>(width)  - 1.0f;
+        float ndcY = (2.0f * (static_cast<float>(y) + 0.5f)) / static_cast<float>(height) - 1.0f;
+
+        glm::vec4 rayStart = inverseViewProjection * glm::vec4(ndcX, ndcY, -1.0f, 1.0f);
+        glm::vec4 rayEnd   = inverseViewProjection * glm::vec4(ndcX, ndcY,  0.0f, 1.0f);
+        rayStart /= rayStart.w;
+        rayEnd   /= rayEnd.w;
+
+        return Ray(glm::vec3(rayStart), glm::vec3(rayEnd - rayStart));
+    }
+
+    uint32_t PreviewRenderer::GetTileCount(uint32_t width, uint32_t height)
+    {
+        return ((width + TileSize - 1) / TileSize) * ((height + TileSize - 1) / TileSize);
+    }
+
+    std::vector<uint32_t> PreviewRenderer::GetTileOrder(uint32_t width, uint32_t height)
+    {
+        uint32_t tilesX = (width + TileSize - 1) / TileSize;
+
+        std::vector<uint32_t> order(GetTileCount(width, height));
+        for (uint32_t i = 0; i < order.size(); ++i)
+            order[i] = i;
+
+        // Centre tiles first, since that is where the camera is usually looking
+        auto distance = [&](uint32_t tile)
+        {
+            float dx = ((tile % tilesX) + 0.5f) * TileSize - 0.5f * width;
+            float dy = ((tile / tilesX) + 0.5f) * TileSize - 0.5f * height;
+            return dx * dx + dy * dy;
+        };
+        std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return distance(a) < distance(b); });
+
+        return order;
+    }
+
+    void PreviewRenderer::TraceTile(const Scene& scene, const glm::mat4& inverseViewProjection,
+                                    uint32_t width, uint32_t height, uint32_t tile, uint8_t* pixels)
+    {
+        uint32_t tilesX = (width + TileSize - 1) / TileSize;
+        uint32_t x0 = (tile % tilesX) * TileSize;
+        uint32_t y0 = (tile / tilesX) * TileSize;
+        uint32_t x1 = std::min(x0 + TileSize, width);
+        uint32_t y1 = std::min(y0 + TileSize, height);
+
+        // Neighbouring pixels along a row form one packet; a ragged tile edge leaves lanes inactive
+        for (uint32_t y = y0; y < y1; ++y)
+        {
+            for (uint32_t x = x0; x < x1; x += RayPacket::Width)
+            {
+                RayPacket packet;
+                uint32_t  lanes = std::min(RayPacket::Width, x1 - x);
+                for (uint32_t l = 0; l < lanes; ++l)
+                    packet.Set(l, GetPixelRay(inverseViewProjection, x + l, y, width, height));
+
+                glm::vec3 colors[RayPacket::Width];
+                scene.Trace(packet, colors);
+
+                for (uint32_t l = 0; l < lanes; ++l)
+                {
+                    glm::vec3 color = glm::clamp(colors[l], 0.0f, 1.0f);
+
+                    uint8_t* pixel = pixels + (static_cast<size_t>(y) * width + x + l) * 4;
+                    pixel[0] = static_cast<uint8_t>(color.r * 255.0f + 0.5f);
+                    pixel[1] = static_cast<uint8_t>(color.g * 255.0f + 0.5f);
+                    pixel[2] = static_cast<uint8_t>(color.b * 255.0f + 0.5f);
+                    pixel[3] = 255;
+                }
+            }
+        }
+    }
+};
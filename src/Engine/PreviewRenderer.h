@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Scene.h"
+#include "Core/FramePacket.h"
+#include "Core/Memory.h"
+#include "Rendering/Texture.h"
+
+namespace Donut
+{
+    // Ray traces a Scene on the job system one tile at a time. Finished tiles are
+    // streamed into a texture by the commands Update() returns, so a preview fills
+    // in progressively and the same code produces reference images without a GPU.
+    class PreviewRenderer
+    {
+    public:
+        static constexpr uint32_t TileSize = 32;
+
+        PreviewRenderer() = default;
+        ~PreviewRenderer();
+
+        // Cancels any frame in flight and starts tracing a copy of the scene. Only a
+        // size change waits for the render thread, to reallocate the texture.
+        void Start(Scene scene, const glm::mat4& view, const glm::mat4& projection, uint32_t width, uint32_t height);
+        void Cancel();
+
+        // Main-thread side: a command uploading the tiles finished since the last call,
+        // to submit ahead of any draw that samples the texture; empty when there are none
+        RenderCommandFn Update();
+
+        bool     IsActive()    const { return m_Frame != nullptr; }
+        bool     IsComplete()  const;
+        float    GetProgress() const;
+        uint32_t GetWidth()    const { return m_Width;  }
+        uint32_t GetHeight()   const { return m_Height; }
+
+        const Ref<Texture2D>& GetTexture() const { return m_Texture; }
+
+        // RGBA8 with the bottom row first; empty until the frame is complete
+        const std::vector<uint8_t>& GetPixels() const;
+
+        // Blocks until every tile has been traced; the scene's BVH must be up to date
+        static void Render(const Scene& scene, const glm::mat4& view, const glm::mat4& projection,
+                           uint32_t width, uint32_t height, std::vector<uint8_t>& pixels);
+
+        static bool SaveImage(const std::string& path, const std::vector<uint8_t>& pixels, uint32_t width, uint32_t height);
+
+        // Ray through the centre of pixel (x, y), with row 0 at the bottom of the image
+        static Ray GetPixelRay(const glm::mat4& inverseViewProjection, uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+    private:
+        struct Frame
+        {
+            Scene                 Source;
+            glm::mat4             InverseViewProjection;
+            uint32_t              Width  = 0;
+            uint32_t              Height = 0;
+            std::vector<uint8_t>  Pixels;
+            std::vector<uint32_t> TileOrder;
+
+            std::atomic_bool      Cancelled     = false;
+            uint32_t              TilesUploaded = 0;
+
+            std::mutex            FinishedMutex;
+            std::vector<uint32_t> FinishedTiles;
+        };
+
+        static uint32_t GetTileCount(uint32_t width, uint32_t height);
+        static std::vector<uint32_t> GetTileOrder(uint32_t width, uint32_t height);
+        static void TraceTile(const Scene& scene, const glm::mat4& inverseViewProjection,
+                              uint32_t width, uint32_t height, uint32_t tile, uint8_t* pixels);
+    private:
+        Ref<Frame>     m_Frame;
+        Ref<Texture2D> m_Texture;
+        uint32_t       m_Width  = 0;
+        uint32_t       m_Height = 0;
+    };
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+#include "Object.h"
+
+namespace Donut
+{
+    // Structure-of-arrays bundle of rays traced together through the BVH. Lanes
+    // with MaxT <= 0 are inactive, which is how partial packets are expressed.
+    struct RayPacket
+    {
+        static constexpr uint32_t Width = 4;
+
+        float OriginX[Width] = {}, OriginY[Width] = {}, OriginZ[Width] = {};
+        float DirX[Width]    = {}, DirY[Width]    = {}, DirZ[Width]    = {};
+        float MaxT[Width]    = {};
+
+        void Set(uint32_t lane, const Ray& ray, float maxT = std::numeric_limits<float>::infinity())
+        {
+            OriginX[lane] = ray.m_Origin.x;
+            OriginY[lane] = ray.m_Origin.y;
+            OriginZ[lane] = ray.m_Origin.z;
+            DirX[lane]    = ray.m_Direction.x;
+            DirY[lane]    = ray.m_Direction.y;
+            DirZ[lane]    = ray.m_Direction.z;
+            MaxT[lane]    = maxT;
+        }
+
+        bool IsActive(uint32_t lane) const { return MaxT[lane] > 0.0f; }
+    };
+
+    struct PacketHit
+    {
+        float T[RayPacket::Width];
+        int   Index[RayPacket::Width]; // -1 for misses and inactive lanes
+    };
+};
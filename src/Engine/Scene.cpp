@@ -0,0 +1,387 @@
+#include "Scene.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Donut
+{
+    namespace
+    {
+        constexpr float    Infinity     = std::numeric_limits<float>::infinity();
+        constexpr uint32_t MaxStackSize = 64;
+
+        const glm::vec3 BackgroundColor(0.0f, 0.0f, 0.1f);
+
+        // Nearest non-negative root, or infinity on a miss. Written branch-free over
+        // plain floats so the fixed-width lane loops below vectorise; for the unit
+        // directions Ray always carries this is the same solve as Object::Intersect.
+        inline float IntersectSphere(float ox, float oy, float oz, float dx, float dy, float dz,
+                                     float cx, float cy, float cz, float radius2)
+        {
+            const float ocx = ox - cx;
+            const float ocy = oy - cy;
+            const float ocz = oz - cz;
+
+            const float b            = ocx * dx + ocy * dy + ocz * dz;
+            const float c            = ocx * ocx + ocy * ocy + ocz * ocz - radius2;
+            const float discriminant = b * b - c;
+            const float root         = std::sqrt(std::max(discriminant, 0.0f));
+
+            const float nearT = -b - root;
+            const float farT  = -b + root;
+            const float t     = nearT >= 0.0f ? nearT : farT;
+            return (discriminant >= 0.0f && t >= 0.0f) ? t : Infinity;
+        }
+
+        inline bool IntersectBox(const BVHNode& node, float ox, float oy, float oz,
+                                 float invX, float invY, float invZ, float maxT)
+        {
+            const float tx0 = (node.m_Min.x - ox) * invX, tx1 = (node.m_Max.x - ox) * invX;
+            const float ty0 = (node.m_Min.y - oy) * invY, ty1 = (node.m_Max.y - oy) * invY;
+            const float tz0 = (node.m_Min.z - oz) * invZ, tz1 = (node.m_Max.z - oz) * invZ;
+
+            const float enter = std::max(std::max(std::min(tx0, tx1), std::min(ty0, ty1)), std::max(std::min(tz0, tz1), 0.0f));
+            const float exit  = std::min(std::min(std::max(tx0, tx1), std::max(ty0, ty1)), std::max(tz0, tz1));
+            return enter <= exit && enter < maxT;
+        }
+    }
+
+    void Scene::UpdateBVH()
+    {
+        bool rebuild = m_Spheres.size() != objs.size();
+
+        m_Spheres.resize(objs.size());
+        for (size_t i = 0; i < objs.size(); ++i)
+            m_Spheres[i] = glm::vec4(objs[i].m_Centre, objs[i].m_Radius);
+
+        if (rebuild)
+            m_BVH.Build(m_Spheres);
+        else
+            m_BVH.Refit(m_Spheres);
+
+        const auto& indices = m_BVH.GetIndices();
+        size_t paddedCount  = indices.size() + SphereLanes - 1;
+        m_SphereX.assign(paddedCount, 0.0f);
+        m_SphereY.assign(paddedCount, 0.0f);
+        m_SphereZ.assign(paddedCount, 0.0f);
+        m_SphereRadius2.assign(paddedCount, 0.0f);
+
+        for (size_t i = 0; i < indices.size(); ++i)
+        {
+            const glm::vec4& sphere = m_Spheres[indices[i]];
+            m_SphereX[i]       = sphere.x;
+            m_SphereY[i]       = sphere.y;
+            m_SphereZ[i]       = sphere.z;
+            m_SphereRadius2[i] = sphere.w * sphere.w;
+        }
+    }
+
+    bool Scene::Intersect(const Ray& ray, float& t, int& index) const
+    {
+        const auto& nodes   = m_BVH.GetNodes();
+        const auto& indices = m_BVH.GetIndices();
+        if (nodes.empty() || m_Spheres.size() != objs.size())
+            return false;
+
+        const glm::vec3 o      = ray.m_Origin;
+        const glm::vec3 d      = ray.m_Direction;
+        const glm::vec3 invDir = 1.0f / d;
+
+        float closest = Infinity;
+        index = -1;
+
+        uint32_t stack[MaxStackSize];
+        uint32_t stackSize = 0;
+        stack[stackSize++] = 0;
+
+        while (stackSize > 0)
+        {
+            const BVHNode& node = nodes[stack[--stackSize]];
+            if (!IntersectBox(node, o.x, o.y, o.z, invDir.x, invDir.y, invDir.z, closest))
+                continue;
+
+            if (node.IsLeaf())
+            {
+                // One ray against every sphere of the leaf at once; lanes past m_Count are discarded
+                const uint32_t first = static_cast<uint32_t>(node.m_LeftFirst);
+                float hits[SphereLanes];
+                for (uint32_t l = 0; l < SphereLanes; ++l)
+                    hits[l] = IntersectSphere(o.x, o.y, o.z, d.x, d.y, d.z,
+                                              m_SphereX[first + l], m_SphereY[first + l], m_SphereZ[first + l], m_SphereRadius2[first + l]);
+
+                for (int32_t l = 0; l < node.m_Count; ++l)
+                {
+                    if (hits[l] < closest)
+                    {
+                        closest = hits[l];
+                        index   = static_cast<int>(indices[first + l]);
+                    }
+                }
+                continue;
+            }
+
+            // Median splits keep the depth near log2(n), well inside the stack
+            stack[stackSize++] = static_cast<uint32_t>(node.m_LeftFirst) + 1;
+            stack[stackSize++] = static_cast<uint32_t>(node.m_LeftFirst);
+        }
+
+        if (index < 0)
+            return false;
+
+        t = closest;
+        return true;
+    }
+
+    bool Scene::Occluded(const Ray& ray, float maxT) const
+    {
+        const auto& nodes = m_BVH.GetNodes();
+        if (nodes.empty() || m_Spheres.size() != objs.size())
+            return false;
+
+        const glm::vec3 o      = ray.m_Origin;
+        const glm::vec3 d      = ray.m_Direction;
+        const glm::vec3 invDir = 1.0f / d;
+
+        uint32_t stack[MaxStackSize];
+        uint32_t stackSize = 0;
+        stack[stackSize++] = 0;
+
+        while (stackSize > 0)
+        {
+            const BVHNode& node = nodes[stack[--stackSize]];
+            if (!IntersectBox(node, o.x, o.y, o.z, invDir.x, invDir.y, invDir.z, maxT))
+                continue;
+
+            if (node.IsLeaf())
+            {
+                const uint32_t first = static_cast<uint32_t>(node.m_LeftFirst);
+                float hits[SphereLanes];
+                for (uint32_t l = 0; l < SphereLanes; ++l)
+                    hits[l] = IntersectSphere(o.x, o.y, o.z, d.x, d.y, d.z,
+                                              m_SphereX[first + l], m_SphereY[first + l], m_SphereZ[first + l], m_SphereRadius2[first + l]);
+
+                for (int32_t l = 0; l < node.m_Count; ++l)
+                {
+                    if (hits[l] < maxT)
+                        return true;
+                }
+                continue;
+            }
+
+            stack[stackSize++] = static_cast<uint32_t>(node.m_LeftFirst) + 1;
+            stack[stackSize++] = static_cast<uint32_t>(node.m_LeftFirst);
+        }
+
+        return false;
+    }
+
+    void Scene::Intersect(const RayPacket& packet, PacketHit& hit) const
+    {
+        constexpr uint32_t Width = RayPacket::Width;
+
+        float closest[Width];
+        for (uint32_t l = 0; l < Width; ++l)
+        {
+            closest[l]   = packet.IsActive(l) ? packet.MaxT[l] : 0.0f;
+            hit.T[l]     = Infinity;
+            hit.Index[l] = -1;
+        }
+
+        const auto& nodes   = m_BVH.GetNodes();
+        const auto& indices = m_BVH.GetIndices();
+        if (nodes.empty() || m_Spheres.size() != objs.size())
+            return;
+
+        float invX[Width], invY[Width], invZ[Width];
+        for (uint32_t l = 0; l < Width; ++l)
+        {
+            invX[l] = 1.0f / packet.DirX[l];
+            invY[l] = 1.0f / packet.DirY[l];
+            invZ[l] = 1.0f / packet.DirZ[l];
+        }
+
+        uint32_t stack[MaxStackSize];
+        uint32_t stackSize = 0;
+        stack[stackSize++] = 0;
+
+        while (stackSize > 0)
+        {
+            const BVHNode& node = nodes[stack[--stackSize]];
+
+            // The whole packet descends as long as any lane still overlaps the node
+            bool anyHit = false;
+            for (uint32_t l = 0; l < Width; ++l)
+                anyHit |= IntersectBox(node, packet.OriginX[l], packet.OriginY[l], packet.OriginZ[l], invX[l], invY[l], invZ[l], closest[l]);
+            if (!anyHit)
+                continue;
+
+            if (node.IsLeaf())
+            {
+                for (int32_t p = 0; p < node.m_Count; ++p)
+                {
+                    const uint32_t prim        = static_cast<uint32_t>(node.m_LeftFirst + p);
+                    const int      objectIndex = static_cast<int>(indices[prim]);
+
+                    for (uint32_t l = 0; l < Width; ++l)
+                    {
+                        const float t = IntersectSphere(packet.OriginX[l], packet.OriginY[l], packet.OriginZ[l],
+                                                        packet.DirX[l], packet.DirY[l], packet.DirZ[l],
+                                                        m_SphereX[prim], m_SphereY[prim], m_SphereZ[prim], m_SphereRadius2[prim]);
+                        const bool closer = t < closest[l];
+                        closest[l]   = closer ? t           : closest[l];
+                        hit.Index[l] = closer ? objectIndex : hit.Index[l];
+                    }
+                }
+                continue;
+            }
+
+            stack[stackSize++] = static_cast<uint32_t>(node.m_LeftFirst) + 1;
+            stack[stackSize++] = static_cast<uint32_t>(node.m_LeftFirst);
+        }
+
+        for (uint32_t l = 0; l < Width; ++l)
+        {
+            if (hit.Index[l] >= 0)
+                hit.T[l] = closest[l];
+        }
+    }
+
+    void Scene::Occluded(const RayPacket& packet, bool occluded[RayPacket::Width]) const
+    {
+        constexpr uint32_t Width = RayPacket::Width;
+
+        // Lanes that are done, occluded or inactive, test against a zero range and drop out of every box
+        float    maxT[Width];
+        uint32_t pending = 0;
+        for (uint32_t l = 0; l < Width; ++l)
+        {
+            occluded[l] = false;
+            maxT[l]     = packet.IsActive(l) ? packet.MaxT[l] : 0.0f;
+            pending    += packet.IsActive(l) ? 1 : 0;
+        }
+
+        const auto& nodes = m_BVH.GetNodes();
+        if (pending == 0 || nodes.empty() || m_Spheres.size() != objs.size())
+            return;
+
+        float invX[Width], invY[Width], invZ[Width];
+        for (uint32_t l = 0; l < Width; ++l)
+        {
+            invX[l] = 1.0f / packet.DirX[l];
+            invY[l] = 1.0f / packet.DirY[l];
+            invZ[l] = 1.0f / packet.DirZ[l];
+        }
+
+        uint32_t stack[MaxStackSize];
+        uint32_t stackSize = 0;
+        stack[stackSize++] = 0;
+
+        while (stackSize > 0)
+        {
+            const BVHNode& node = nodes[stack[--stackSize]];
+
+            bool anyHit = false;
+            for (uint32_t l = 0; l < Width; ++l)
+                anyHit |= IntersectBox(node, packet.OriginX[l], packet.OriginY[l], packet.OriginZ[l], invX[l], invY[l], invZ[l], maxT[l]);
+            if (!anyHit)
+                continue;
+
+            if (node.IsLeaf())
+            {
+                for (int32_t p = 0; p < node.m_Count; ++p)
+                {
+                    const uint32_t prim = static_cast<uint32_t>(node.m_LeftFirst + p);
+
+                    for (uint32_t l = 0; l < Width; ++l)
+                    {
+                        const float t = IntersectSphere(packet.OriginX[l], packet.OriginY[l], packet.OriginZ[l],
+                                                        packet.DirX[l], packet.DirY[l], packet.DirZ[l],
+                                                        m_SphereX[prim], m_SphereY[prim], m_SphereZ[prim], m_SphereRadius2[prim]);
+                        if (t < maxT[l])
+                        {
+                            occluded[l] = true;
+                            maxT[l]     = 0.0f;
+                            pending--;
+                        }
+                    }
+                }
+
+                if (pending == 0)
+                    return;
+                continue;
+            }
+
+            stack[stackSize++] = static_cast<uint32_t>(node.m_LeftFirst) + 1;
+            stack[stackSize++] = static_cast<uint32_t>(node.m_LeftFirst);
+        }
+    }
+
+    glm::vec3 Scene::Trace(const Ray& ray) const
+    {
+        float t;
+        int   index;
+        if (!Intersect(ray, t, index))
+            return BackgroundColor;
+
+        const Object& hitObj   = objs[index];
+        glm::vec3     hitPoint = ray.m_Origin + ray.m_Direction * t;
+
+        float lightDistance;
+        Ray   shadowRay = GetShadowRay(hitObj, hitPoint, lightDistance);
+        return Shade(hitObj, hitPoint, Occluded(shadowRay, lightDistance));
+    }
+
+    void Scene::Trace(const RayPacket& packet, glm::vec3 colors[RayPacket::Width]) const
+    {
+        PacketHit hit;
+        Intersect(packet, hit);
+
+        RayPacket shadowPacket;
+        glm::vec3 hitPoints[RayPacket::Width];
+        for (uint32_t l = 0; l < RayPacket::Width; ++l)
+        {
+            if (hit.Index[l] < 0)
+                continue;
+
+            glm::vec3 origin(packet.OriginX[l], packet.OriginY[l], packet.OriginZ[l]);
+            glm::vec3 direction(packet.DirX[l], packet.DirY[l], packet.DirZ[l]);
+            hitPoints[l] = origin + direction * hit.T[l];
+
+            float lightDistance;
+            Ray   shadowRay = GetShadowRay(objs[hit.Index[l]], hitPoints[l], lightDistance);
+            shadowPacket.Set(l, shadowRay, lightDistance);
+        }
+
+        bool occluded[RayPacket::Width];
+        Occluded(shadowPacket, occluded);
+
+        for (uint32_t l = 0; l < RayPacket::Width; ++l)
+            colors[l] = hit.Index[l] < 0 ? BackgroundColor : Shade(objs[hit.Index[l]], hitPoints[l], occluded[l]);
+    }
+
+    Ray Scene::GetShadowRay(const Object& obj, const glm::vec3& hitPoint, float& lightDistance) const
+    {
+        glm::vec3 normal = obj.GetNormal(hitPoint);
+        glm::vec3 origin = hitPoint + normal * 0.001f;
+
+        // Only blockers between the surface and the light count
+        lightDistance = glm::length(m_LightPos - origin);
+        return Ray(origin, m_LightPos - origin);
+    }
+
+    glm::vec3 Scene::Shade(const Object& obj, const glm::vec3& hitPoint, bool inShadow) const
+    {
+        glm::vec3 normal   = obj.GetNormal(hitPoint);
+        glm::vec3 lightDir = glm::normalize(m_LightPos - hitPoint);
+
+        float diff = std::max(glm::dot(normal, lightDir), 0.0f);
+
+        glm::vec3 color   = obj.m_Material.m_Color;
+        float     ambient = 0.1f;
+
+        if (inShadow)
+            return color * ambient;
+        return color * (ambient + diff * 0.9f);
+    }
+};
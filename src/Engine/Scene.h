@@ -1,9 +1,10 @@
 #pragma once
 
 #include <vector>
-#include <limits>
 
 #include "Object.h"
+#include "BVH.h"
+#include "RayPacket.h"
 
 namespace Donut
 {
@@ -15,55 +16,41 @@ namespace Donut
 
         Scene() 
             : m_LightPos(5.0f, 5.0f, 5.0f) { }
-    
-        glm::vec3 Trace(Ray &ray)
-        {
-            float closest = std::numeric_limits<float>::infinity();
-            const Object* hitObj = nullptr;
-    
-            for(auto& obj : objs)
-            {
-                float t;
 
-                if(obj.Intersect(ray, t))
-                    if(t < closest) 
-                    {
-                        closest = t;
-                        hitObj = &obj;
-                    }
-            }
-            
-            if(hitObj)
-            {
-                glm::vec3 hitPoint = ray.m_Origin + ray.m_Direction * closest;
-                glm::vec3 normal = hitObj->GetNormal(hitPoint);
-                glm::vec3 lightDir = glm::normalize(m_LightPos - hitPoint);
-    
-                float diff = std::max(glm::dot(normal, lightDir), 0.0f);
-    
-                Ray shadowRay(hitPoint + normal * 0.001f, lightDir);
-                bool inShadow = false;
-                
-                for(auto& obj : objs) 
-                {
-                    float t;
+        // Rebuilds the BVH when objects were added or removed and refits it otherwise;
+        // call once per frame after edits and before Intersect()
+        void UpdateBVH();
 
-                    if(obj.Intersect(shadowRay, t)) 
-                    {
-                        inShadow = true;
-                        break;
-                    }
-                }
-    
-                glm::vec3 color = hitObj->m_Material.m_Color;
-                float ambient = 0.1f;
-    
-                if (inShadow) 
-                    return color * ambient;
-                return color * (ambient + diff * 0.9f);
-            }
+        // Closest hit in front of the ray origin, or false if nothing is hit
+        bool Intersect(const Ray& ray, float& t, int& index) const;
+
+        // True as soon as anything is hit closer than maxT, without searching for the closest hit
+        bool Occluded(const Ray& ray, float maxT) const;
+
+        // Packet versions of the above; coherent rays share one traversal of the BVH
+        void Intersect(const RayPacket& packet, PacketHit& hit) const;
+        void Occluded(const RayPacket& packet, bool occluded[RayPacket::Width]) const;
+
+        const BVH& GetBVH() const { return m_BVH; }
     
-            return glm::vec3(0.0f, 0.0f, 0.1f); 
-        }
+        // Diffuse shading with one hard shadow ray towards m_LightPos; both rays go through the BVH
+        glm::vec3 Trace(const Ray& ray) const;
+        void      Trace(const RayPacket& packet, glm::vec3 colors[RayPacket::Width]) const;
+    private:
+        glm::vec3 Shade(const Object& obj, const glm::vec3& hitPoint, bool inShadow) const;
+        Ray       GetShadowRay(const Object& obj, const glm::vec3& hitPoint, float& lightDistance) const;
+    private:
+        // BVH leaves never hold more than MaxLeafSize spheres, so one pass of the lane loops tests a whole leaf
+        static constexpr uint32_t SphereLanes = BVH::MaxLeafSize;
+
+        BVH                    m_BVH;
+        std::vector<glm::vec4> m_Spheres;
+
+        // Spheres in BVH primitive order, so every leaf is a contiguous run in each array;
+        // padded by SphereLanes - 1 entries so a full lane load never reads past the end
+        std::vector<float> m_SphereX;
+        std::vector<float> m_SphereY;
+        std::vector<float> m_SphereZ;
+        std::vector<float> m_SphereRadius2;
     };
 };
\ No newline at end of file
@@ -0,0 +1,140 @@
+#include "SceneFile.h"
+
+#include "Core/Log.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace Donut
+{
+    namespace
+    {
+        constexpr char     SceneMagic[4] = { 'D', 'S', 'C', 'N' };
+        constexpr uint64_t BlockAlignment = 16;
+
+        uint64_t AlignBlock(uint64_t offset)
+        {
+            return (offset + BlockAlignment - 1) & ~(BlockAlignment - 1);
+        }
+
+        bool BlockFits(uint64_t offset, uint64_t elementSize, uint32_t count, uint64_t fileSize)
+        {
+            return offset % BlockAlignment == 0 && offset <= fileSize && elementSize * count <= fileSize - offset;
+        }
+    }
+
+    bool SceneFile::Open(const std::string& path)
+    {
+        Close();
+
+        if (!m_File.Open(path))
+        {
+            DONUT_ERROR("Failed to map scene file: {}", path);
+            return false;
+        }
+
+        if (m_File.GetSize() < sizeof(SceneFileHeader))
+        {
+            DONUT_ERROR("Scene file is truncated: {}", path);
+            m_File.Close();
+            return false;
+        }
+
+        const auto* header = reinterpret_cast<const SceneFileHeader*>(m_File.GetData());
+        if (std::memcmp(header->Magic, SceneMagic, sizeof(SceneMagic)) != 0 || header->Version != FormatVersion || header->Flags != 0)
+        {
+            DONUT_ERROR("Unsupported scene file: {} (version {})", path, header->Version);
+            m_File.Close();
+            return false;
+        }
+
+        uint64_t size  = m_File.GetSize();
+        uint32_t count = header->ObjectCount;
+        if (header->FileSize != size ||
+            !BlockFits(header->PositionsOffset,  sizeof(glm::vec3),     count, size) ||
+            !BlockFits(header->RadiiOffset,      sizeof(float),         count, size) ||
+            !BlockFits(header->MaterialsOffset,  sizeof(SceneMaterial), count, size) ||
+            !BlockFits(header->MassesOffset,     sizeof(float),         count, size) ||
+            !BlockFits(header->VelocitiesOffset, sizeof(glm::vec3),     count, size))
+        {
+            DONUT_ERROR("Scene file is corrupt: {}", path);
+            m_File.Close();
+            return false;
+        }
+
+        m_Header = header;
+        return true;
+    }
+
+    void SceneFile::Close()
+    {
+        m_Header = nullptr;
+        m_File.Close();
+    }
+
+    bool SceneFile::Write(const std::string& path, const std::vector<Object>& objects,
+                          const std::vector<float>& masses, const std::vector<glm::vec3>& velocities)
+    {
+        uint32_t count = static_cast<uint32_t>(objects.size());
+
+        SceneFileHeader header = {};
+        std::memcpy(header.Magic, SceneMagic, sizeof(SceneMagic));
+        header.Version          = FormatVersion;
+        header.ObjectCount      = count;
+        header.PositionsOffset  = AlignBlock(sizeof(SceneFileHeader));
+        header.RadiiOffset      = AlignBlock(header.PositionsOffset  + sizeof(glm::vec3)     * count);
+        header.MaterialsOffset  = AlignBlock(header.RadiiOffset      + sizeof(float)         * count);
+        header.MassesOffset     = AlignBlock(header.MaterialsOffset  + sizeof(SceneMaterial) * count);
+        header.VelocitiesOffset = AlignBlock(header.MassesOffset     + sizeof(float)         * count);
+        header.FileSize         = header.VelocitiesOffset + sizeof(glm::vec3) * count;
+
+        std::vector<uint8_t> data(header.FileSize, 0);
+        std::memcpy(data.data(), &header, sizeof(header));
+
+        auto* positions = reinterpret_cast<glm::vec3*>(data.data() + header.PositionsOffset);
+        auto* radii     = reinterpret_cast<float*>(data.data() + header.RadiiOffset);
+        auto* materials = reinterpret_cast<SceneMaterial*>(data.data() + header.MaterialsOffset);
+        auto* massData  = reinterpret_cast<float*>(data.data() + header.MassesOffset);
+        auto* velocity  = reinterpret_cast<glm::vec3*>(data.data() + header.VelocitiesOffset);
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const Object& obj = objects[i];
+            positions[i] = obj.m_Centre;
+            radii[i]     = obj.m_Radius;
+            materials[i] = { obj.m_Material.m_Color, obj.m_Material.m_Specular, obj.m_Material.m_Emission };
+            massData[i]  = i < masses.size()     ? masses[i]     : 0.0f;
+            velocity[i]  = i < velocities.size() ? velocities[i] : glm::vec3(0.0f);
+        }
+
+        // Written next to the target and renamed, so a mapped copy of the old file is never truncated
+        std::string tempPath = path + ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            if (!file.is_open())
+            {
+                DONUT_ERROR("Failed to write scene file: {}", path);
+                return false;
+            }
+
+            file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+            if (!file.good())
+            {
+                DONUT_ERROR("Failed to write scene file: {}", path);
+                return false;
+            }
+        }
+
+        std::error_code error;
+        std::filesystem::rename(tempPath, path, error);
+        if (error)
+        {
+            DONUT_ERROR("Failed to replace scene file {}: {}", path, error.message());
+            std::filesystem::remove(tempPath, error);
+            return false;
+        }
+
+        return true;
+    }
+};
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Core/MappedFile.h"
+#include "Engine/Object.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace Donut
+{
+    struct SceneFileHeader
+    {
+        char     Magic[4];
+        uint32_t Version;
+        uint32_t Flags;       // Reserved, must be zero in version 1
+        uint32_t ObjectCount;
+        uint64_t PositionsOffset;
+        uint64_t RadiiOffset;
+        uint64_t MaterialsOffset;
+        uint64_t MassesOffset;
+        uint64_t VelocitiesOffset;
+        uint64_t FileSize;
+    };
+    static_assert(sizeof(SceneFileHeader) == 64, "SceneFileHeader layout is part of the file format");
+
+    struct SceneMaterial
+    {
+        glm::vec3 Color;
+        float     Specular;
+        float     Emission;
+    };
+    static_assert(sizeof(SceneMaterial) == 20, "SceneMaterial layout is part of the file format");
+
+    // Binary scene (.dscene): a header followed by one 16-byte aligned block per
+    // attribute, each holding ObjectCount tightly packed values. Positions, radii and
+    // velocities are in editor units; a mass of zero means "derive it from the radius".
+    // The accessors point straight into the mapping and stay valid until Close().
+    class SceneFile
+    {
+    public:
+        static constexpr uint32_t FormatVersion = 1;
+        static constexpr const char* Extension  = ".dscene";
+
+        bool Open(const std::string& path);
+        void Close();
+
+        bool     IsOpen()         const { return m_Header != nullptr; }
+        uint32_t GetObjectCount() const { return m_Header ? m_Header->ObjectCount : 0; }
+
+        const glm::vec3*     GetPositions()  const { return GetBlock<glm::vec3>(m_Header->PositionsOffset);      }
+        const float*         GetRadii()      const { return GetBlock<float>(m_Header->RadiiOffset);              }
+        const SceneMaterial* GetMaterials()  const { return GetBlock<SceneMaterial>(m_Header->MaterialsOffset);  }
+        const float*         GetMasses()     const { return GetBlock<float>(m_Header->MassesOffset);             }
+        const glm::vec3*     GetVelocities() const { return GetBlock<glm::vec3>(m_Header->VelocitiesOffset);     }
+
+        // masses and velocities may be empty, in which case zeros are written
+        static bool Write(const std::string& path, const std::vector<Object>& objects,
+                          const std::vector<float>& masses = {}, const std::vector<glm::vec3>& velocities = {});
+    private:
+        template<typename T>
+        const T* GetBlock(uint64_t offset) const
+        {
+            return reinterpret_cast<const T*>(m_File.GetData() + offset);
+        }
+    private:
+        MappedFile             m_File;
+        const SceneFileHeader* m_Header = nullptr;
+    };
+};
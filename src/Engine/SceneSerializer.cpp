@@ -0,0 +1,214 @@
+#include "SceneSerializer.h"
+#include "SceneFile.h"
+
+#include "Core/Log.h"
+
+#include <nlohmann/json.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+namespace Donut
+{
+    namespace
+    {
+        struct SceneRecords
+        {
+            std::vector<Object>    Objects;
+            std::vector<float>     Masses;
+            std::vector<glm::vec3> Velocities;
+        };
+
+        bool ReadJSON(const std::string& path, SceneRecords& records)
+        {
+            std::ifstream file(path);
+            if (!file.is_open())
+                return false;
+
+            nlohmann::json sceneData = nlohmann::json::parse(file, nullptr, false);
+            if (sceneData.is_discarded())
+            {
+                DONUT_ERROR("Scene file is not valid JSON: {}", path);
+                return false;
+            }
+
+            if (!sceneData.contains("objects"))
+                return true;
+
+            // The file may come from anywhere, so every field goes through at() and a
+            // missing or mistyped one rejects the whole scene instead of crashing
+            auto readVec3 = [](const nlohmann::json& array)
+            {
+                return glm::vec3(array.at(0).get<float>(), array.at(1).get<float>(), array.at(2).get<float>());
+            };
+
+            SceneRecords loaded;
+            try
+            {
+                const nlohmann::json& objects = sceneData.at("objects");
+                if (!objects.is_array())
+                    throw std::runtime_error("\"objects\" is not an array");
+
+                for (const auto& sphereData : objects)
+                {
+                    glm::vec3 position = readVec3(sphereData.at("position"));
+                    glm::vec3 color    = readVec3(sphereData.at("color"));
+                    
+                    float radius   = sphereData.at("radius").get<float>();
+                    float specular = sphereData.at("specular").get<float>();
+                    float emission = sphereData.at("emission").get<float>();
+
+                    glm::vec3 velocity(0.0f);
+                    if (sphereData.contains("velocity"))
+                        velocity = readVec3(sphereData.at("velocity"));
+                    
+                    loaded.Objects.emplace_back(position, radius, Material(color, specular, emission));
+                    loaded.Masses.push_back(sphereData.value("mass", 0.0f));
+                    loaded.Velocities.push_back(velocity);
+                }
+            }
+            catch (const std::exception& e)
+            {
+                DONUT_ERROR("Malformed scene file {}: {}", path, e.what());
+                return false;
+            }
+
+            records = std::move(loaded);
+            return true;
+        }
+
+        bool WriteJSON(const std::string& path, const SceneRecords& records)
+        {
+            nlohmann::json sceneData;
+            sceneData["objects"] = nlohmann::json::array();
+
+            for (size_t i = 0; i < records.Objects.size(); ++i)
+            {
+                const Object& obj = records.Objects[i];
+
+                nlohmann::json sphereData;
+                sphereData["position"] = { obj.m_Centre.x, obj.m_Centre.y, obj.m_Centre.z };
+                sphereData["color"]    = { obj.m_Material.m_Color.x, obj.m_Material.m_Color.y, obj.m_Material.m_Color.z };
+                sphereData["radius"]   = obj.m_Radius;
+                sphereData["specular"] = obj.m_Material.m_Specular;
+                sphereData["emission"] = obj.m_Material.m_Emission;
+
+                // Only simulation scenes carry these; editor scenes stay as they were
+                if (i < records.Masses.size() && records.Masses[i] != 0.0f)
+                    sphereData["mass"] = records.Masses[i];
+                if (i < records.Velocities.size() && records.Velocities[i] != glm::vec3(0.0f))
+                    sphereData["velocity"] = { records.Velocities[i].x, records.Velocities[i].y, records.Velocities[i].z };
+
+                sceneData["objects"].push_back(sphereData);
+            }
+
+            std::ofstream file(path);
+            if (!file.is_open())
+                return false;
+
+            file << sceneData.dump(4);
+            return file.good();
+        }
+
+        bool ReadBinary(const std::string& path, SceneRecords& records)
+        {
+            SceneFile sceneFile;
+            if (!sceneFile.Open(path))
+                return false;
+
+            uint32_t count = sceneFile.GetObjectCount();
+            const glm::vec3*     positions  = sceneFile.GetPositions();
+            const float*         radii      = sceneFile.GetRadii();
+            const SceneMaterial* materials  = sceneFile.GetMaterials();
+            const float*         masses     = sceneFile.GetMasses();
+            const glm::vec3*     velocities = sceneFile.GetVelocities();
+
+            records.Objects.reserve(count);
+            for (uint32_t i = 0; i < count; ++i)
+                records.Objects.emplace_back(positions[i], radii[i], Material(materials[i].Color, materials[i].Specular, materials[i].Emission));
+
+            records.Masses.assign(masses, masses + count);
+            records.Velocities.assign(velocities, velocities + count);
+            return true;
+        }
+
+        bool Read(const std::string& path, SceneRecords& records)
+        {
+            return SceneSerializer::IsBinaryPath(path) ? ReadBinary(path, records) : ReadJSON(path, records);
+        }
+
+        bool Write(const std::string& path, const SceneRecords& records)
+        {
+            if (SceneSerializer::IsBinaryPath(path))
+                return SceneFile::Write(path, records.Objects, records.Masses, records.Velocities);
+            return WriteJSON(path, records);
+        }
+    }
+
+    bool SceneSerializer::IsBinaryPath(const std::string& path)
+    {
+        return std::filesystem::path(path).extension() == SceneFile::Extension;
+    }
+
+    bool SceneSerializer::Save(const Scene& scene, const std::string& path)
+    {
+        SceneRecords records;
+        records.Objects = scene.objs;
+        records.Masses.reserve(scene.objs.size());
+        records.Velocities.reserve(scene.objs.size());
+        for (const Object& obj : scene.objs)
+        {
+            records.Masses.push_back(obj.m_Mass);
+            records.Velocities.push_back(obj.m_Velocity);
+        }
+
+        if (!Write(path, records))
+        {
+            DONUT_ERROR("Failed to save scene to {}", path);
+            return false;
+        }
+
+        DONUT_INFO("Scene saved to {} ({} objects)", path, scene.objs.size());
+        return true;
+    }
+
+    bool SceneSerializer::Load(Scene& scene, const std::string& path)
+    {
+        SceneRecords records;
+        if (!Read(path, records))
+        {
+            DONUT_ERROR("Failed to load scene from {}", path);
+            return false;
+        }
+
+        for (size_t i = 0; i < records.Objects.size(); ++i)
+        {
+            records.Objects[i].m_Mass     = records.Masses[i];
+            records.Objects[i].m_Velocity = records.Velocities[i];
+        }
+
+        scene.objs = std::move(records.Objects);
+        DONUT_INFO("Scene loaded from {} ({} objects)", path, scene.objs.size());
+        return true;
+    }
+
+    bool SceneSerializer::Convert(const std::string& inputPath, const std::string& outputPath)
+    {
+        SceneRecords records;
+        if (!Read(inputPath, records))
+        {
+            DONUT_ERROR("Failed to read scene {}", inputPath);
+            return false;
+        }
+
+        if (!Write(outputPath, records))
+        {
+            DONUT_ERROR("Failed to write scene {}", outputPath);
+            return false;
+        }
+
+        DONUT_INFO("Converted {} to {} ({} objects)", inputPath, outputPath, records.Objects.size());
+        return true;
+    }
+};
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Engine/Scene.h"
+
+#include <string>
+
+namespace Donut
+{
+    // Reads and writes scenes as JSON or as binary .dscene files, chosen by extension.
+    // Each object's mass and velocity are kept in both formats.
+    class SceneSerializer
+    {
+    public:
+        static constexpr const char* DefaultPath = "Scene.json";
+
+        static bool IsBinaryPath(const std::string& path);
+
+        static bool Save(const Scene& scene, const std::string& path);
+        static bool Load(Scene& scene, const std::string& path);
+
+        // Converts between the two formats
+        static bool Convert(const std::string& inputPath, const std::string& outputPath);
+    };
+};
@@ -228,6 +228,16 @@ namespace Donut
         return pixelData;
     }
 
+    void OpenGLFramebuffer::ReadColorAttachment(uint32_t attachmentIndex, std::vector<uint8_t>& pixels)
+    {
+        pixels.resize(static_cast<size_t>(m_Specification.Width) * m_Specification.Height * 4);
+        glNamedFramebufferReadBuffer(m_RendererID, GL_COLOR_ATTACHMENT0 + attachmentIndex);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, m_RendererID);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glReadPixels(0, 0, m_Specification.Width, m_Specification.Height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    }
+
     void OpenGLFramebuffer::ClearAttachment(uint32_t attachmentIndex, int value)
     {
         auto& spec = m_ColorAttachmentSpecifications[attachmentIndex];
@@ -17,6 +17,7 @@ namespace Donut
 
         virtual void Resize(uint32_t width, uint32_t height)          override;
         virtual int ReadPixel(uint32_t attachmentIndex, int x, int y) override;
+        virtual void ReadColorAttachment(uint32_t attachmentIndex, std::vector<uint8_t>& pixels) override;
 
         virtual void ClearAttachment(uint32_t attachmentIndex, int value) override;
         virtual uint32_t GetColorAttachmentRendererID(uint32_t index = 0) const override { return m_ColorAttachments[index]; }
@@ -27,6 +27,9 @@ namespace Donut
         glEnable(GL_CULL_FACE);
         glCullFace(GL_BACK);
         glFrontFace(GL_CCW);
+
+        // Filter across cube face edges so mip levels of environment maps don't show seams
+        glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
     }
 
     void OpenGLRendererAPI::SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
@@ -84,6 +87,12 @@ namespace Donut
         glBindTexture(GL_TEXTURE_2D, 0);
     }
 
+    void OpenGLRendererAPI::DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t instanceCount, uint32_t indexCount)
+    {
+        uint32_t count = indexCount ? indexCount : vertexArray->GetIndexBuffer()->GetCount();
+        glDrawElementsInstanced(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr, instanceCount);
+    }
+
     void OpenGLRendererAPI::DrawArrays(uint32_t vertexCount, uint32_t first)
     {
         glDrawArrays(GL_TRIANGLES, first, vertexCount);
@@ -112,4 +121,9 @@ namespace Donut
     {
         glReadPixels(x, y, width, height, format, type, pixels);
     }
+
+    void OpenGLRendererAPI::Present()
+    {
+        // Draws already land in the window's framebuffer
+    }
 };
@@ -26,6 +26,9 @@ namespace Donut
 
         virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, 
                                  uint32_t indexCount = 0)         override;
+        virtual void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray,
+                                          uint32_t instanceCount,
+                                          uint32_t indexCount = 0) override;
         
         virtual void DrawArrays(uint32_t vertexCount, 
                                 uint32_t first = 0)               override;
@@ -40,5 +43,6 @@ namespace Donut
                                 uint32_t width,  uint32_t height, 
                                 uint32_t format, uint32_t type, 
                                 void* pixels)                     override;
+        virtual void Present()                                    override;
     };
 };
@@ -0,0 +1,38 @@
+#include "OpenGLStorageBuffer.h"
+
+namespace Donut
+{
+    OpenGLStorageBuffer::OpenGLStorageBuffer(uint32_t size, uint32_t binding)
+        : m_Size(size), m_Binding(binding)
+    {
+        glCreateBuffers(1, &m_RendererID);
+        glNamedBufferData(m_RendererID, size, nullptr, GL_DYNAMIC_DRAW);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, m_RendererID);
+    }
+
+    OpenGLStorageBuffer::~OpenGLStorageBuffer()
+    {
+        glDeleteBuffers(1, &m_RendererID);
+    }
+
+    void OpenGLStorageBuffer::SetData(const void* data, uint32_t size, uint32_t offset)
+    {
+        if (offset + size > m_Size)
+            Resize(offset + size);
+
+        glNamedBufferSubData(m_RendererID, offset, size, data);
+    }
+
+    void OpenGLStorageBuffer::Resize(uint32_t size)
+    {
+        m_Size = size;
+        glNamedBufferData(m_RendererID, size, nullptr, GL_DYNAMIC_DRAW);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, m_Binding, m_RendererID);
+    }
+
+    void OpenGLStorageBuffer::Bind(uint32_t binding)
+    {
+        m_Binding = binding;
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, m_RendererID);
+    }
+};
@@ -1,6 +1,7 @@
 #include "OpenGLTexture.h"
 
 #include "Rendering/Shader.h"
+#include "Rendering/AssetRegistry.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
@@ -8,6 +9,9 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include <algorithm>
+#include <cstring>
+
 namespace Donut
 {
     OpenGLTexture2D::OpenGLTexture2D(uint32_t width, uint32_t height)
@@ -66,6 +70,19 @@ namespace Donut
         glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, m_DataFormat, GL_UNSIGNED_BYTE, data);
     }
 
+    void OpenGLTexture2D::SetSubData(const void* data, uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint32_t rowLength)
+    {
+        if (x + width > m_Width || y + height > m_Height)
+        {
+            DONUT_ERROR("Sub-image exceeds the texture bounds!");
+            return;
+        }
+
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, static_cast<GLint>(rowLength));
+        glTextureSubImage2D(m_RendererID, 0, x, y, width, height, m_DataFormat, GL_UNSIGNED_BYTE, data);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    }
+
     void OpenGLTexture2D::Bind(uint32_t slot) const
     {
         glBindTextureUnit(slot, m_RendererID);
@@ -83,14 +100,7 @@ namespace Donut
         m_InternalFormat = GL_RGB16F;
         m_DataFormat     = GL_RGB;
 
-        glCreateTextures(GL_TEXTURE_CUBE_MAP, 1, &m_RendererID);
-        glTextureStorage2D(m_RendererID, 1, m_InternalFormat, m_Width, m_Height);
-
-        glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+        CreateStorage();
     }
 
     OpenGLCubemapTexture::OpenGLCubemapTexture(const std::string& path)
@@ -101,21 +111,79 @@ namespace Donut
         m_InternalFormat = GL_RGB16F;
         m_DataFormat     = GL_RGB;
 
+        CreateStorage();
+
+        LoadHDRI(path);
+    }
+
+    OpenGLCubemapTexture::OpenGLCubemapTexture(const CubemapData& data)
+        : m_Width(data.FaceSize), m_Height(data.FaceSize)
+    {
+        m_InternalFormat = GL_RGB9_E5;
+        m_DataFormat     = GL_RGB;
+
+        CreateStorage();
+
+        // Every level arrives in the texture's own format, so this is a straight copy with no conversion pass
+        const uint32_t* texels = data.Texels;
+        uint32_t levels = std::min(data.MipCount, m_MipCount);
+        for (uint32_t level = 0; level < levels; ++level)
+        {
+            uint32_t size = std::max(m_Width >> level, 1u);
+            glTextureSubImage3D(m_RendererID, level, 0, 0, 0, size, size, 6, GL_RGB, GL_UNSIGNED_INT_5_9_9_9_REV, texels);
+            texels += static_cast<size_t>(size) * size * 6;
+        }
+    }
+
+    OpenGLCubemapTexture::~OpenGLCubemapTexture()
+    {
+        ReleaseUploadResources();
+        glDeleteTextures(1, &m_RendererID);
+    }
+
+    void OpenGLCubemapTexture::CreateStorage()
+    {
+        m_MipCount = 1;
+        while ((std::max(m_Width, m_Height) >> m_MipCount) > 0)
+            m_MipCount++;
+
         glCreateTextures(GL_TEXTURE_CUBE_MAP, 1, &m_RendererID);
-        glTextureStorage2D(m_RendererID, 1, m_InternalFormat, m_Width, m_Height);
+        glTextureStorage2D(m_RendererID, m_MipCount, m_InternalFormat, m_Width, m_Height);
 
-        glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
         glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
         glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
         glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
         glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+    }
 
-        LoadHDRI(path);
+    uint64_t OpenGLCubemapTexture::GetMemorySize() const
+    {
+        // Drivers pad three-channel half floats out to four channels
+        uint64_t bytesPerTexel = (m_InternalFormat == GL_RGB9_E5) ? 4 : 8;
+
+        uint64_t total = 0;
+        for (uint32_t level = 0; level < m_MipCount; ++level)
+        {
+            uint64_t size = std::max(m_Width >> level, 1u);
+            total += size * size * 6 * bytesPerTexel;
+        }
+
+        return total;
     }
 
-    OpenGLCubemapTexture::~OpenGLCubemapTexture()
+    bool OpenGLCubemapTexture::ReadPixels(uint32_t level, std::vector<float>& rgb) const
     {
-        glDeleteTextures(1, &m_RendererID);
+        if (level >= m_MipCount)
+            return false;
+
+        uint32_t size = std::max(m_Width >> level, 1u);
+        rgb.resize(static_cast<size_t>(size) * size * 6 * 3);
+
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glGetTextureImage(m_RendererID, level, GL_RGB, GL_FLOAT, static_cast<GLsizei>(rgb.size() * sizeof(float)), rgb.data());
+        glPixelStorei(GL_PACK_ALIGNMENT, 4);
+        return true;
     }
 
     void OpenGLCubemapTexture::LoadHDRI(const std::string& path)
@@ -142,14 +210,114 @@ namespace Donut
             return;
         }
 
-        ConvertEquirectangularToCubemap(hdrData, width, height);
+        uint32_t hdrTexture;
+        glGenTextures(1, &hdrTexture);
+        glBindTexture(GL_TEXTURE_2D, hdrTexture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, width, height, 0, GL_RGB, GL_FLOAT, hdrData);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
         stbi_image_free(hdrData);
+
+        ConvertEquirectangularToCubemap(hdrTexture);
+        glDeleteTextures(1, &hdrTexture);
         
         DONUT_INFO("Successfully loaded HDRI: {} ({}x{})", path, width, height);
     }
 
-    void OpenGLCubemapTexture::ConvertEquirectangularToCubemap(float* hdrData, int width, int height)
+    void OpenGLCubemapTexture::BeginUpload(const Ref<HDRIImage>& image)
+    {
+        ReleaseUploadResources();
+        if (!image || image->Width == 0 || image->Height == 0)
+            return;
+
+        m_Path        = image->Path;
+        m_UploadImage = image;
+
+        glCreateTextures(GL_TEXTURE_2D, 1, &m_StagingTexture);
+        glTextureStorage2D(m_StagingTexture, 1, GL_RGBA16F, image->Width, image->Height);
+        glTextureParameteri(m_StagingTexture, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTextureParameteri(m_StagingTexture, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTextureParameteri(m_StagingTexture, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTextureParameteri(m_StagingTexture, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+        glCreateBuffers(1, &m_UploadPBO);
+    }
+
+    bool OpenGLCubemapTexture::ContinueUpload(uint32_t byteBudget)
+    {
+        if (!m_UploadImage)
+            return true;
+
+        const HDRIImage& image = *m_UploadImage;
+        uint32_t rowBytes = image.Width * 4 * sizeof(uint16_t);
+
+        if (m_UploadedRows < image.Height)
+        {
+            uint32_t rows  = std::clamp(byteBudget / rowBytes, 1u, image.Height - m_UploadedRows);
+            uint32_t bytes = rows * rowBytes;
+
+            if (bytes > m_UploadPBOSize)
+            {
+                glNamedBufferData(m_UploadPBO, bytes, nullptr, GL_STREAM_DRAW);
+                m_UploadPBOSize = bytes;
+            }
+
+            // Invalidating lets the driver hand out fresh storage while the previous slice is still being copied
+            void* mapped = glMapNamedBufferRange(m_UploadPBO, 0, bytes, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+            if (!mapped)
+            {
+                DONUT_ERROR("Failed to map upload buffer for HDRI: {}", m_Path);
+                ReleaseUploadResources();
+                return true;
+            }
+
+            std::memcpy(mapped, image.Pixels.data() + static_cast<size_t>(m_UploadedRows) * image.Width * 4, bytes);
+            glUnmapNamedBuffer(m_UploadPBO);
+
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_UploadPBO);
+            glTextureSubImage2D(m_StagingTexture, 0, 0, m_UploadedRows, image.Width, rows, GL_RGBA, GL_HALF_FLOAT, nullptr);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+            m_UploadedRows += rows;
+            return false;
+        }
+
+        ConvertEquirectangularToCubemap(m_StagingTexture);
+        ReleaseUploadResources();
+        return true;
+    }
+
+    float OpenGLCubemapTexture::GetUploadProgress() const
     {
+        if (!m_UploadImage)
+            return 1.0f;
+
+        return static_cast<float>(m_UploadedRows) / static_cast<float>(m_UploadImage->Height + 1);
+    }
+
+    void OpenGLCubemapTexture::ReleaseUploadResources()
+    {
+        if (m_StagingTexture)
+            glDeleteTextures(1, &m_StagingTexture);
+        if (m_UploadPBO)
+            glDeleteBuffers(1, &m_UploadPBO);
+
+        m_StagingTexture = 0;
+        m_UploadPBO      = 0;
+        m_UploadPBOSize  = 0;
+        m_UploadedRows   = 0;
+        m_UploadImage.reset();
+    }
+
+    void OpenGLCubemapTexture::ConvertEquirectangularToCubemap(uint32_t equirectTexture)
+    {
+        GLint previousViewport[4];
+        GLint previousFramebuffer;
+        glGetIntegerv(GL_VIEWPORT, previousViewport);
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousFramebuffer);
+
         uint32_t captureFBO, captureRBO;
         glGenFramebuffers(1, &captureFBO);
         glGenRenderbuffers(1, &captureRBO);
@@ -159,43 +327,20 @@ namespace Donut
         glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, m_Width, m_Height);
         glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, captureRBO);
 
-        uint32_t hdrTexture;
-        glGenTextures(1, &hdrTexture);
-        glBindTexture(GL_TEXTURE_2D, hdrTexture);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB16F, width, height, 0, GL_RGB, GL_FLOAT, hdrData);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-        auto equirectShader = Shader::Create("Assets/Shaders/EquirectToCubemap.glsl");
-        if (!equirectShader)
+        // Both are owned by the registry, so repeated conversions reuse the same program and cube
+        auto equirectShader = AssetRegistry::GetShader("Assets/Shaders/EquirectToCubemap.glsl");
+        auto cube           = AssetRegistry::GetSkyboxCube();
+        if (!equirectShader || !cube)
         {
             DONUT_ERROR("Failed to create equirectangular to cubemap shader");
+            glBindFramebuffer(GL_FRAMEBUFFER, previousFramebuffer);
+            glDeleteFramebuffers(1, &captureFBO);
+            glDeleteRenderbuffers(1, &captureRBO);
             return;
         }
         
         uint32_t shaderProgram = equirectShader->GetRendererID();
 
-        float vertices[] = 
-        {
-            -1.0f,  1.0f, -1.0f, -1.0f, -1.0f, -1.0f,  1.0f, -1.0f, -1.0f,  1.0f, -1.0f, -1.0f,  1.0f,  1.0f, -1.0f, -1.0f,  1.0f, -1.0f,
-            -1.0f, -1.0f,  1.0f, -1.0f, -1.0f, -1.0f, -1.0f,  1.0f, -1.0f, -1.0f,  1.0f, -1.0f, -1.0f,  1.0f,  1.0f, -1.0f, -1.0f,  1.0f,
-             1.0f, -1.0f, -1.0f,  1.0f, -1.0f,  1.0f,  1.0f,  1.0f,  1.0f,  1.0f,  1.0f,  1.0f,  1.0f,  1.0f, -1.0f,  1.0f, -1.0f, -1.0f,
-            -1.0f, -1.0f,  1.0f, -1.0f,  1.0f,  1.0f,  1.0f,  1.0f,  1.0f,  1.0f,  1.0f,  1.0f,  1.0f, -1.0f,  1.0f, -1.0f, -1.0f,  1.0f,
-            -1.0f,  1.0f, -1.0f,  1.0f,  1.0f, -1.0f,  1.0f,  1.0f,  1.0f,  1.0f,  1.0f,  1.0f, -1.0f,  1.0f,  1.0f, -1.0f,  1.0f, -1.0f,
-            -1.0f, -1.0f, -1.0f, -1.0f, -1.0f,  1.0f,  1.0f, -1.0f, -1.0f,  1.0f, -1.0f, -1.0f,  1.0f, -1.0f,  1.0f, -1.0f, -1.0f,  1.0f
-        };
-
-        uint32_t cubeVAO, cubeVBO;
-        glGenVertexArrays(1, &cubeVAO);
-        glGenBuffers(1, &cubeVBO);
-        glBindVertexArray(cubeVAO);
-        glBindBuffer(GL_ARRAY_BUFFER, cubeVBO);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
-
         glm::mat4 captureProjection = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 10.0f);
         glm::mat4 captureViews[] = 
         {
@@ -211,7 +356,7 @@ namespace Donut
         glUniform1i(glGetUniformLocation(shaderProgram, "u_EquirectangularMap"), 0);
         glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "u_Projection"), 1, GL_FALSE, &captureProjection[0][0]);
         glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, hdrTexture);
+        glBindTexture(GL_TEXTURE_2D, equirectTexture);
 
         glViewport(0, 0, m_Width, m_Height);
         glBindFramebuffer(GL_FRAMEBUFFER, captureFBO);
@@ -220,17 +365,17 @@ namespace Donut
             glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "u_View"), 1, GL_FALSE, &captureViews[i][0][0]);
             glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, m_RendererID, 0);
             glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-            glBindVertexArray(cubeVAO);
+            cube->Bind();
             glDrawArrays(GL_TRIANGLES, 0, 36);
         }
         glBindVertexArray(0);
+        glGenerateTextureMipmap(m_RendererID);
 
-        glDeleteVertexArrays(1, &cubeVAO);
-        glDeleteBuffers(1, &cubeVBO);
-        glDeleteProgram(shaderProgram);
-        glDeleteTextures(1, &hdrTexture);
         glDeleteFramebuffers(1, &captureFBO);
         glDeleteRenderbuffers(1, &captureRBO);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, previousFramebuffer);
+        glViewport(previousViewport[0], previousViewport[1], previousViewport[2], previousViewport[3]);
     }
 
     void OpenGLCubemapTexture::SetData(void* data, uint32_t size)
@@ -20,6 +20,8 @@ namespace Donut
         virtual uint32_t GetRendererID() const override { return m_RendererID; }
 
         virtual void SetData(void* data, uint32_t size)                          override;
+        virtual void SetSubData(const void* data, uint32_t x, uint32_t y,
+                                uint32_t width, uint32_t height, uint32_t rowLength = 0) override;
         virtual void Bind(uint32_t slot = 0)                               const override;
         virtual void BindAsImage(uint32_t slot = 0, bool readOnly = false) const override;
 
@@ -41,6 +43,7 @@ namespace Donut
     public:
         OpenGLCubemapTexture(uint32_t width, uint32_t height);
         OpenGLCubemapTexture(const std::string& path);
+        OpenGLCubemapTexture(const CubemapData& data);
         virtual ~OpenGLCubemapTexture();
 
         virtual uint32_t GetWidth()      const override { return m_Width; }
@@ -51,18 +54,35 @@ namespace Donut
         virtual void Bind(uint32_t slot = 0)                               const override;
         virtual void BindAsImage(uint32_t slot = 0, bool readOnly = false) const override;
 
+        virtual uint32_t GetMipCount()   const override { return m_MipCount; }
+        virtual uint64_t GetMemorySize() const override;
+        virtual bool     ReadPixels(uint32_t level, std::vector<float>& rgb) const override;
+
+        virtual void  BeginUpload(const Ref<HDRIImage>& image) override;
+        virtual bool  ContinueUpload(uint32_t byteBudget)      override;
+        virtual float GetUploadProgress() const                override;
+
         virtual bool operator==(const Texture& other) const override
         {
             return m_RendererID == other.GetRendererID();
         }
 
     private:
+        void CreateStorage();
         void LoadHDRI(const std::string& path);
-        void ConvertEquirectangularToCubemap(float* hdrData, int width, int height);
+        void ConvertEquirectangularToCubemap(uint32_t equirectTexture);
+        void ReleaseUploadResources();
 
         std::string m_Path;
         uint32_t    m_Width, m_Height;
+        uint32_t    m_MipCount = 1;
         uint32_t    m_RendererID;
         GLenum      m_InternalFormat, m_DataFormat;
+
+        Ref<HDRIImage> m_UploadImage;
+        uint32_t       m_StagingTexture = 0;
+        uint32_t       m_UploadPBO      = 0;
+        uint32_t       m_UploadPBOSize  = 0;
+        uint32_t       m_UploadedRows   = 0;
     };
 }
@@ -0,0 +1,109 @@
+#include "OpenGLUniformRingBuffer.h"
+#include "Core/Log.h"
+
+#include <cstring>
+
+namespace Donut
+{
+    static uint32_t AlignUp(uint32_t value, uint32_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    OpenGLUniformRingBuffer::OpenGLUniformRingBuffer(uint32_t frameSize, uint32_t framesInFlight)
+        : m_FramesInFlight(framesInFlight)
+    {
+        GLint alignment = 0;
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        if (alignment > 0)
+            m_Alignment = static_cast<uint32_t>(alignment);
+
+        m_FrameSize = AlignUp(frameSize, m_Alignment);
+        m_Fences.resize(m_FramesInFlight, nullptr);
+
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        GLsizeiptr totalSize = static_cast<GLsizeiptr>(m_FrameSize) * m_FramesInFlight;
+
+        glCreateBuffers(1, &m_RendererID);
+        glNamedBufferStorage(m_RendererID, totalSize, nullptr, flags);
+        m_MappedData = static_cast<uint8_t*>(glMapNamedBufferRange(m_RendererID, 0, totalSize, flags));
+
+        if (!m_MappedData)
+            DONUT_ERROR("Failed to persistently map uniform ring buffer ({} bytes)", totalSize);
+    }
+
+    OpenGLUniformRingBuffer::~OpenGLUniformRingBuffer()
+    {
+        for (GLsync fence : m_Fences)
+            if (fence)
+                glDeleteSync(fence);
+
+        if (m_MappedData)
+            glUnmapNamedBuffer(m_RendererID);
+        glDeleteBuffers(1, &m_RendererID);
+    }
+
+    void OpenGLUniformRingBuffer::BeginFrame()
+    {
+        m_FrameIndex++;
+        uint32_t segment = static_cast<uint32_t>(m_FrameIndex % m_FramesInFlight);
+
+        GLsync& fence = m_Fences[segment];
+        if (fence)
+        {
+            GLenum result = glClientWaitSync(fence, 0, 0);
+            while (result != GL_ALREADY_SIGNALED && 
+                   result != GL_CONDITION_SATISFIED && 
+                   result != GL_WAIT_FAILED)
+                result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+
+        m_Head = segment * m_FrameSize;
+    }
+
+    void OpenGLUniformRingBuffer::EndFrame()
+    {
+        uint32_t segment = static_cast<uint32_t>(m_FrameIndex % m_FramesInFlight);
+
+        GLsync& fence = m_Fences[segment];
+        if (fence)
+            glDeleteSync(fence);
+        fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+
+    UniformRingBuffer::Allocation OpenGLUniformRingBuffer::Upload(const void* data, uint32_t size)
+    {
+        uint32_t segmentEnd = (static_cast<uint32_t>(m_FrameIndex % m_FramesInFlight) + 1) * m_FrameSize;
+        if (!m_MappedData || m_Head + size > segmentEnd)
+        {
+            DONUT_ERROR("Uniform ring buffer segment exhausted ({} bytes requested)", size);
+            return {};
+        }
+
+        Allocation alloc;
+        alloc.Offset = m_Head;
+        alloc.Size   = size;
+        alloc.Frame  = m_FrameIndex;
+
+        std::memcpy(m_MappedData + m_Head, data, size);
+        m_Head = AlignUp(m_Head + size, m_Alignment);
+
+        return alloc;
+    }
+
+    void OpenGLUniformRingBuffer::BindRange(uint32_t binding, const Allocation& alloc)
+    {
+        if (alloc.Size == 0)
+            return;
+
+        glBindBufferRange(GL_UNIFORM_BUFFER, binding, m_RendererID, alloc.Offset, alloc.Size);
+    }
+
+    bool OpenGLUniformRingBuffer::IsResident(const Allocation& alloc) const
+    {
+        return alloc.Size > 0 && m_FrameIndex - alloc.Frame < m_FramesInFlight;
+    }
+};
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Rendering/UniformRingBuffer.h"
+#include <glad/glad.h>
+
+#include <vector>
+
+namespace Donut
+{
+    class OpenGLUniformRingBuffer : public UniformRingBuffer
+    {
+    public:
+        OpenGLUniformRingBuffer(uint32_t frameSize, uint32_t framesInFlight);
+        virtual ~OpenGLUniformRingBuffer();
+
+        virtual void BeginFrame() override;
+        virtual void EndFrame()   override;
+
+        virtual Allocation Upload(const void* data, uint32_t size)            override;
+        virtual void       BindRange(uint32_t binding, const Allocation& alloc) override;
+        virtual bool       IsResident(const Allocation& alloc)            const override;
+    private:
+        uint32_t m_RendererID     = 0;
+        uint8_t* m_MappedData     = nullptr;
+        uint32_t m_FrameSize      = 0;
+        uint32_t m_FramesInFlight = 0;
+        uint32_t m_Alignment      = 256;
+        uint32_t m_Head           = 0;
+        uint64_t m_FrameIndex     = 0;
+
+        std::vector<GLsync> m_Fences;
+    };
+};
@@ -41,6 +41,7 @@ namespace Donut
                 element.normalized ? GL_TRUE : GL_FALSE,
                 layout.GetStride(),
                 reinterpret_cast<const   void*>(static_cast<uintptr_t>(element.offset)));
+            glVertexAttribDivisor(m_VertexBufferIndex, layout.GetInstanceStepRate());
             m_VertexBufferIndex++;
         }
 
@@ -5,6 +5,13 @@
 
 namespace Donut 
 {
+    OpenGLVertexBuffer::OpenGLVertexBuffer(uint32_t size)
+    {
+        glCreateBuffers(1, &m_RendererID);
+        glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+        glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+    }
+
     OpenGLVertexBuffer::OpenGLVertexBuffer(const void* data, uint32_t size)
     {
         glCreateBuffers(1, &m_RendererID);
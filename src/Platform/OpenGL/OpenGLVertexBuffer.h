@@ -8,6 +8,7 @@ namespace Donut
         : public VertexBuffer 
     {
     public:
+        OpenGLVertexBuffer(uint32_t size);
         OpenGLVertexBuffer(const void* data, uint32_t size);
         virtual ~OpenGLVertexBuffer();
 
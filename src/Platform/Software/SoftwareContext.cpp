@@ -0,0 +1,80 @@
+#include "SoftwareContext.h"
+#include "SoftwareTexture.h"
+#include "SoftwareFramebuffer.h"
+
+namespace Donut
+{
+    SoftwareContext& SoftwareContext::Get()
+    {
+        static SoftwareContext context;
+        return context;
+    }
+
+    SoftwareImage& SoftwareContext::GetBackBuffer()
+    {
+        static SoftwareImage backBuffer;
+        return backBuffer;
+    }
+
+    SoftwareImage& SoftwareContext::GetRenderTarget()
+    {
+        if (Framebuffer)
+            return Framebuffer->GetColorImage();
+        return GetBackBuffer();
+    }
+
+    uint32_t SoftwareContext::RegisterImage(SoftwareImage* image)
+    {
+        uint32_t id = m_NextImageID++;
+        m_ImagesByID[id] = image;
+        return id;
+    }
+
+    SoftwareImage* SoftwareContext::FindImage(uint32_t id) const
+    {
+        auto it = m_ImagesByID.find(id);
+        return it != m_ImagesByID.end() ? it->second : nullptr;
+    }
+
+    void SoftwareContext::Release(const SoftwareImage* image)
+    {
+        std::erase_if(m_ImagesByID, [image](const auto& entry) { return entry.second == image; });
+        for (uint32_t i = 0; i < MaxBindings; ++i)
+        {
+            if (Textures[i] == image)
+                Textures[i] = nullptr;
+            if (Images[i] == image)
+                Images[i] = nullptr;
+        }
+    }
+
+    void SoftwareContext::Release(const SoftwareCubemapTexture* cubemap)
+    {
+        for (auto& binding : Cubemaps)
+            if (binding == cubemap)
+                binding = nullptr;
+    }
+
+    void SoftwareContext::Release(const std::vector<uint8_t>* buffer)
+    {
+        for (uint32_t i = 0; i < MaxBindings; ++i)
+        {
+            if (UniformBlocks[i].Buffer == buffer)
+                UniformBlocks[i] = {};
+            if (StorageBlocks[i].Buffer == buffer)
+                StorageBlocks[i] = {};
+        }
+    }
+
+    void SoftwareContext::Release(const SoftwareShader* shader)
+    {
+        if (Program == shader)
+            Program = nullptr;
+    }
+
+    void SoftwareContext::Release(const SoftwareFramebuffer* framebuffer)
+    {
+        if (Framebuffer == framebuffer)
+            Framebuffer = nullptr;
+    }
+};
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace Donut
+{
+    struct SoftwareImage;
+    class  SoftwareShader;
+    class  SoftwareFramebuffer;
+    class  SoftwareCubemapTexture;
+
+    struct SoftwareViewport
+    {
+        uint32_t X = 0, Y = 0;
+        uint32_t Width = 0, Height = 0;
+    };
+
+    // A range of a CPU buffer bound to a uniform or storage slot; kernels view it as the
+    // plain struct mirroring the GLSL block. Size zero binds whatever the buffer holds.
+    struct SoftwareBufferBinding
+    {
+        const std::vector<uint8_t>* Buffer = nullptr;
+        uint32_t                    Offset = 0;
+        uint32_t                    Size   = 0;
+
+        uint32_t GetSize() const
+        {
+            if (!Buffer || Offset >= Buffer->size())
+                return 0;
+            return Size ? Size : static_cast<uint32_t>(Buffer->size()) - Offset;
+        }
+
+        template<typename T>
+        const T* As() const { return GetSize() >= sizeof(T) ? reinterpret_cast<const T*>(Buffer->data() + Offset) : nullptr; }
+
+        template<typename T>
+        uint32_t GetCount() const { return GetSize() / sizeof(T); }
+    };
+
+    // Binding state of the software backend, the CPU stand-in for GL's binding points.
+    // Resources clear their own bindings when destroyed. Main thread only; kernels read
+    // it while the main thread is blocked in the dispatch.
+    struct SoftwareContext
+    {
+        static constexpr uint32_t MaxBindings = 16;
+
+        const SoftwareShader*         Program = nullptr;
+        SoftwareViewport              Viewport;
+        glm::vec4                     ClearColor   = glm::vec4(0.0f);
+        bool                          Blending     = false;
+
+        const SoftwareImage*          Textures[MaxBindings] = {};
+        const SoftwareCubemapTexture* Cubemaps[MaxBindings] = {};
+        SoftwareImage*                Images[MaxBindings]   = {};
+        SoftwareBufferBinding         UniformBlocks[MaxBindings];
+        SoftwareBufferBinding         StorageBlocks[MaxBindings];
+
+        // Colour attachment draws land in: the bound framebuffer's, else the back buffer
+        SoftwareImage& GetRenderTarget();
+        SoftwareImage& GetBackBuffer();
+        SoftwareFramebuffer* Framebuffer = nullptr;
+
+        // Renderer IDs let RenderCommand::BindTexture address CPU images
+        uint32_t       RegisterImage(SoftwareImage* image);
+        SoftwareImage* FindImage(uint32_t id) const;
+        void           Release(const SoftwareImage* image);
+        void           Release(const SoftwareCubemapTexture* cubemap);
+        void           Release(const std::vector<uint8_t>* buffer);
+        void           Release(const SoftwareShader* shader);
+        void           Release(const SoftwareFramebuffer* framebuffer);
+
+        static SoftwareContext& Get();
+    private:
+        std::unordered_map<uint32_t, SoftwareImage*> m_ImagesByID;
+        uint32_t                                     m_NextImageID = 1;
+    };
+};
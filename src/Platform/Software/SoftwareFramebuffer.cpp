@@ -0,0 +1,112 @@
+#include "SoftwareFramebuffer.h"
+#include "SoftwareContext.h"
+
+#include <algorithm>
+
+namespace Donut
+{
+    SoftwareFramebuffer::SoftwareFramebuffer(const FramebufferSpecification& spec)
+        : m_Specification(spec)
+    {
+        Invalidate();
+    }
+
+    SoftwareFramebuffer::~SoftwareFramebuffer()
+    {
+        Release();
+        SoftwareContext::Get().Release(this);
+    }
+
+    void SoftwareFramebuffer::Release()
+    {
+        for (auto& attachment : m_ColorAttachments)
+            SoftwareContext::Get().Release(&attachment.Image);
+        m_ColorAttachments.clear();
+    }
+
+    void SoftwareFramebuffer::Invalidate()
+    {
+        Release();
+
+        for (const auto& spec : m_Specification.Attachments.Attachments)
+        {
+            if (spec.TextureFormat == FramebufferTextureFormat::RGBA8 || spec.TextureFormat == FramebufferTextureFormat::RED_INTEGER)
+                m_ColorAttachments.emplace_back().Format = spec.TextureFormat;
+        }
+
+        if (m_ColorAttachments.empty())
+            m_ColorAttachments.emplace_back();
+
+        // Registered once the vector is final, so the image addresses stay valid
+        size_t pixelCount = static_cast<size_t>(m_Specification.Width) * m_Specification.Height;
+        for (auto& attachment : m_ColorAttachments)
+        {
+            if (attachment.Format == FramebufferTextureFormat::RGBA8)
+            {
+                attachment.Image.Resize(m_Specification.Width, m_Specification.Height);
+                attachment.RendererID = SoftwareContext::Get().RegisterImage(&attachment.Image);
+            }
+            else if (attachment.Format == FramebufferTextureFormat::RED_INTEGER)
+                attachment.Integers.assign(pixelCount, 0);
+        }
+    }
+
+    void SoftwareFramebuffer::Bind()
+    {
+        auto& context = SoftwareContext::Get();
+        context.Framebuffer = this;
+        context.Viewport    = { 0, 0, m_Specification.Width, m_Specification.Height };
+    }
+
+    void SoftwareFramebuffer::Unbind()
+    {
+        auto& context = SoftwareContext::Get();
+        if (context.Framebuffer == this)
+            context.Framebuffer = nullptr;
+    }
+
+    void SoftwareFramebuffer::Resize(uint32_t width, uint32_t height)
+    {
+        m_Specification.Width  = width;
+        m_Specification.Height = height;
+        Invalidate();
+    }
+
+    int SoftwareFramebuffer::ReadPixel(uint32_t attachmentIndex, int x, int y)
+    {
+        if (attachmentIndex >= m_ColorAttachments.size() || x < 0 || y < 0 ||
+            static_cast<uint32_t>(x) >= m_Specification.Width || static_cast<uint32_t>(y) >= m_Specification.Height)
+            return -1;
+
+        const auto& attachment = m_ColorAttachments[attachmentIndex];
+        if (attachment.Integers.empty())
+            return -1;
+
+        return attachment.Integers[static_cast<size_t>(y) * m_Specification.Width + x];
+    }
+
+    void SoftwareFramebuffer::ReadColorAttachment(uint32_t attachmentIndex, std::vector<uint8_t>& pixels)
+    {
+        if (attachmentIndex >= m_ColorAttachments.size())
+        {
+            pixels.clear();
+            return;
+        }
+
+        pixels = m_ColorAttachments[attachmentIndex].Image.Pixels;
+    }
+
+    void SoftwareFramebuffer::ClearAttachment(uint32_t attachmentIndex, int value)
+    {
+        if (attachmentIndex >= m_ColorAttachments.size())
+            return;
+
+        auto& integers = m_ColorAttachments[attachmentIndex].Integers;
+        std::fill(integers.begin(), integers.end(), value);
+    }
+
+    uint32_t SoftwareFramebuffer::GetColorAttachmentRendererID(uint32_t index) const
+    {
+        return index < m_ColorAttachments.size() ? m_ColorAttachments[index].RendererID : 0;
+    }
+};
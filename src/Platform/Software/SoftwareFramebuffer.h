@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Rendering/Framebuffer.h"
+#include "SoftwareTexture.h"
+
+#include <vector>
+
+namespace Donut
+{
+    class SoftwareFramebuffer : public Framebuffer
+    {
+    public:
+        SoftwareFramebuffer(const FramebufferSpecification& spec);
+        virtual ~SoftwareFramebuffer();
+
+        void Invalidate();
+
+        virtual void Bind()   override;
+        virtual void Unbind() override;
+
+        virtual void Resize(uint32_t width, uint32_t height) override;
+        virtual int  ReadPixel(uint32_t attachmentIndex, int x, int y) override;
+        virtual void ReadColorAttachment(uint32_t attachmentIndex, std::vector<uint8_t>& pixels) override;
+
+        virtual void ClearAttachment(uint32_t attachmentIndex, int value) override;
+        virtual uint32_t GetColorAttachmentRendererID(uint32_t index = 0) const override;
+
+        virtual const FramebufferSpecification& GetSpecification() const override { return m_Specification; }
+
+        // Draw target; empty unless the first colour attachment is RGBA8
+        SoftwareImage& GetColorImage() { return m_ColorAttachments[0].Image; }
+    private:
+        // Depth attachments are not kept: the software renderer only runs full-screen passes
+        struct ColorAttachment
+        {
+            FramebufferTextureFormat Format = FramebufferTextureFormat::None;
+            SoftwareImage            Image;
+            std::vector<int32_t>     Integers;
+            uint32_t                 RendererID = 0;
+        };
+
+        void Release();
+    private:
+        FramebufferSpecification     m_Specification;
+        std::vector<ColorAttachment> m_ColorAttachments;
+    };
+};
@@ -0,0 +1,711 @@
+#include "SoftwareKernels.h"
+#include "SoftwareContext.h"
+#include "SoftwareTexture.h"
+
+#include "Core/Log.h"
+#include "Core/JobSystem.h"
+#include "Engine/BVH.h"
+
+#include <algorithm>
+#include <cmath>
+
+// Line-for-line port of Assets/Shaders/Geodesic.glsl in single precision. Keep the
+// two in sync: the software renderer is the reference the GPU output is checked against.
+namespace Donut
+{
+    namespace
+    {
+        struct CameraBlock
+        {
+            glm::vec3 CamPos;     float Pad0;
+            glm::vec3 CamRight;   float Pad1;
+            glm::vec3 CamUp;      float Pad2;
+            glm::vec3 CamForward; float Pad3;
+            float     TanHalfFov;
+            float     Aspect;
+            int32_t   Moving;
+            int32_t   Pad4;
+        };
+
+        struct DiskBlock
+        {
+            float R1;
+            float R2;
+            float Num;
+            float Thickness;
+            float Density;
+        };
+
+        struct ObjectsBlock
+        {
+            int32_t NumObjects;
+            int32_t NumNodes;
+            float   ObjectsReach;
+            int32_t Pad0;
+        };
+
+        struct SimulationBlock
+        {
+            int32_t MaxStepsMoving;
+            int32_t MaxStepsStatic;
+            float   EarlyExitDistance;
+            float   Time;
+        };
+
+        struct SceneObject
+        {
+            glm::vec4 PosRadius;
+            glm::vec4 Color;
+        };
+
+        constexpr float SagA_rs  = 1.269e10f;
+        constexpr float D_LAMBDA = 1e7f;
+        constexpr float ESCAPE_R = 1e30f;
+
+        constexpr int   DEFAULT_MAX_STEPS_MOVING    = 12000;
+        constexpr int   DEFAULT_MAX_STEPS_STATIC    = 8000;
+        constexpr float DEFAULT_EARLY_EXIT_DISTANCE = 2e12f;
+
+        constexpr float MIN_STEP_SIZE = 1e6f;
+        constexpr float MAX_STEP_SIZE = 5e7f;
+
+        constexpr int BVH_STACK_SIZE = 32;
+
+        constexpr uint32_t TILE_SIZE = 16;
+
+        struct Ray
+        {
+            float x, y, z;
+            float r, theta, phi;
+            float dr, dtheta, dphi;
+            float E, L;
+        };
+
+        struct ObjectHit
+        {
+            glm::vec4 Color  = glm::vec4(0.0f);
+            glm::vec3 Center = glm::vec3(0.0f);
+            glm::vec3 Point  = glm::vec3(0.0f);
+            float     Radius = 0.0f;
+        };
+
+        float Fract(float x)
+        {
+            return x - std::floor(x);
+        }
+
+        glm::vec3 Fract(const glm::vec3& x)
+        {
+            return x - glm::floor(x);
+        }
+
+        float Mix(float a, float b, float t)
+        {
+            return a + (b - a) * t;
+        }
+
+        glm::vec3 Mix(const glm::vec3& a, const glm::vec3& b, float t)
+        {
+            return a + (b - a) * t;
+        }
+
+        glm::vec4 Mix(const glm::vec4& a, const glm::vec4& b, float t)
+        {
+            return a + (b - a) * t;
+        }
+
+        float Smoothstep(float edge0, float edge1, float x)
+        {
+            float t = std::clamp((x - edge0) / (edge1 - edge0), 0.0f, 1.0f);
+            return t * t * (3.0f - 2.0f * t);
+        }
+
+        float Hash(const glm::vec3& position)
+        {
+            glm::vec3 p = Fract(position * glm::vec3(0.1031f, 0.1030f, 0.0973f));
+            p += glm::dot(p, glm::vec3(p.y, p.x, p.z) + 33.33f);
+            return Fract((p.x + p.y) * p.z);
+        }
+
+        float Noise(const glm::vec3& x)
+        {
+            glm::vec3 i    = glm::floor(x);
+            glm::vec3 frac = Fract(x);
+
+            glm::vec3 u = frac * frac * (3.0f - 2.0f * frac);
+
+            float a = Hash(i);
+            float b = Hash(i + glm::vec3(1.0f, 0.0f, 0.0f));
+            float c = Hash(i + glm::vec3(0.0f, 1.0f, 0.0f));
+            float d = Hash(i + glm::vec3(1.0f, 1.0f, 0.0f));
+            float e = Hash(i + glm::vec3(0.0f, 0.0f, 1.0f));
+            float f = Hash(i + glm::vec3(1.0f, 0.0f, 1.0f));
+            float g = Hash(i + glm::vec3(0.0f, 1.0f, 1.0f));
+            float h = Hash(i + glm::vec3(1.0f, 1.0f, 1.0f));
+
+            return Mix(Mix(Mix(a, b, u.x), Mix(c, d, u.x), u.y),
+                       Mix(Mix(e, f, u.x), Mix(g, h, u.x), u.y), u.z);
+        }
+
+        float Fbm(glm::vec3 x, int octaves)
+        {
+            float v = 0.0f;
+            float a = 0.5f;
+            float f = 1.0f;
+            glm::vec3 shift(100.0f, 200.0f, 300.0f);
+
+            for (int i = 0; i < octaves; ++i)
+            {
+                v += a * Noise(x * f);
+                x = x * 2.0f + shift;
+                a *= 0.5f;
+                f *= 2.0f;
+            }
+            return v;
+        }
+
+        // Rotation about the disk axis, scaled into noise space
+        glm::vec3 RotateDisk(const glm::vec3& pos, float angle)
+        {
+            return glm::vec3(pos.x * std::cos(angle) - pos.z * std::sin(angle),
+                             pos.y,
+                             pos.x * std::sin(angle) + pos.z * std::cos(angle)) * 1e-10f;
+        }
+
+        class GeodesicKernel
+        {
+        public:
+            const CameraBlock*            Cam        = nullptr;
+            const DiskBlock*              Disk       = nullptr;
+            const ObjectsBlock*           Objects    = nullptr;
+            const SimulationBlock*        Simulation = nullptr;
+            const SceneObject*            ObjectData = nullptr;
+            const BVHNode*                Nodes      = nullptr;
+            int32_t                       NumNodes   = 0;
+            int32_t                       NumObjects = 0;
+            const SoftwareCubemapTexture* HDRI       = nullptr;
+            SoftwareImage*                Image      = nullptr;
+
+            void RunTile(uint32_t groupX, uint32_t groupY) const;
+        private:
+            float GetCloudDensity(const glm::vec3& pos) const;
+            glm::vec4 SampleDiskColor(const glm::vec3& pos) const;
+            bool IsInDiskVolume(const glm::vec3& pos) const;
+            bool InterceptObject(const glm::vec3& from, const glm::vec3& to, ObjectHit& hit) const;
+            glm::vec4 TracePixel(int px, int py, int width, int height, glm::vec3& escapeDirection, bool& escaped) const;
+            float EnvironmentLod(const glm::vec4* escapeDirections, uint32_t lx, uint32_t ly, const glm::vec3& direction) const;
+        };
+
+        float GeodesicKernel::GetCloudDensity(const glm::vec3& pos) const
+        {
+            float r_cyl  = std::sqrt(pos.x * pos.x + pos.z * pos.z);
+            float r_norm = (r_cyl - Disk->R1) / (Disk->R2 - Disk->R1);
+
+            if (r_norm < 0.0f || r_norm > 1.0f)
+                return 0.0f;
+
+            float h_norm           = std::abs(pos.y) / Disk->Thickness;
+            float vertical_falloff = std::exp(-h_norm * h_norm * 3.0f);
+            float radial_density   = 1.0f - r_norm * 0.5f;
+
+            float keplerian_speed = 1.0f / std::sqrt(r_norm + 0.1f);
+
+            float     rotation_angle = Simulation->Time * keplerian_speed * 0.5f;
+            glm::vec3 rotated_pos    = RotateDisk(pos, rotation_angle);
+
+            float large_turbulence = Fbm(rotated_pos * 1.2f, 5);
+            float medium_wisps     = Fbm(rotated_pos * 2.5f, 4);
+            float small_detail     = Fbm(rotated_pos * 6.0f, 3);
+            float fine_detail      = Fbm(rotated_pos * 10.0f, 2);
+
+            float noise_mask = large_turbulence * 0.4f +
+                               medium_wisps     * 0.3f +
+                               small_detail     * 0.2f +
+                               fine_detail      * 0.1f;
+
+            noise_mask = Smoothstep(0.25f, 0.75f, noise_mask);
+
+            float angle         = std::atan2(pos.z, pos.x);
+            float rotated_angle = angle + Simulation->Time * 0.5f;
+
+            float spiral_arms = std::sin(rotated_angle * 3.0f + r_norm * 15.0f) * 0.15f + 0.85f;
+
+            float orbital_angle   = angle + Simulation->Time * keplerian_speed * 0.8f;
+            float orbital_pattern = std::sin(orbital_angle * 2.0f + r_norm * 8.0f) * 0.2f + 0.8f;
+
+            float density = vertical_falloff * radial_density * noise_mask * spiral_arms * orbital_pattern;
+            return density * Disk->Density;
+        }
+
+        glm::vec4 GeodesicKernel::SampleDiskColor(const glm::vec3& pos) const
+        {
+            float r_cyl  = std::sqrt(pos.x * pos.x + pos.z * pos.z);
+            float r_norm = (r_cyl - Disk->R1) / (Disk->R2 - Disk->R1);
+
+            glm::vec3 innerColor(1.0f, 0.9f, 0.5f);
+            glm::vec3 midColor(1.0f, 0.6f, 0.2f);
+            glm::vec3 outerColor(0.9f, 0.3f, 0.1f);
+
+            glm::vec3 baseColor;
+            if (r_norm < 0.5f)
+                baseColor = Mix(innerColor, midColor, r_norm * 2.0f);
+            else
+                baseColor = Mix(midColor, outerColor, (r_norm - 0.5f) * 2.0f);
+
+            float keplerian_speed = 1.0f / std::sqrt(r_norm + 0.1f);
+
+            float     color_rotation_angle = Simulation->Time * keplerian_speed * 0.3f;
+            glm::vec3 rotated_color_pos    = RotateDisk(pos, color_rotation_angle);
+
+            float large_color    = Fbm(rotated_color_pos * 1.8f, 4);
+            float medium_color   = Fbm(rotated_color_pos * 4.0f, 3);
+            float small_color    = Fbm(rotated_color_pos * 8.0f, 2);
+            float colorVariation = (large_color * 0.5f + medium_color * 0.3f + small_color * 0.2f) * 0.6f;
+            baseColor = baseColor * (1.0f + colorVariation);
+
+            float density = GetCloudDensity(pos);
+
+            float     brightness_rotation_angle = Simulation->Time * keplerian_speed * 0.7f;
+            glm::vec3 rotated_brightness_pos    = RotateDisk(pos, brightness_rotation_angle);
+
+            float brightness_large  = Fbm(rotated_brightness_pos * 3.0f, 3);
+            float brightness_medium = Fbm(rotated_brightness_pos * 5.0f, 2);
+            float brightness_small  = Fbm(rotated_brightness_pos * 7.0f, 2);
+            float brightness_noise  = brightness_large * 0.6f + brightness_medium * 0.3f + brightness_small * 0.1f;
+
+            float baseBrightness = 1.0f + density * 1.5f;
+            float glowBrightness = brightness_noise * 0.8f;
+            float brightness     = baseBrightness + glowBrightness;
+
+            return glm::vec4(baseColor * brightness, density);
+        }
+
+        bool GeodesicKernel::IsInDiskVolume(const glm::vec3& pos) const
+        {
+            float r_cyl = std::sqrt(pos.x * pos.x + pos.z * pos.z);
+            return r_cyl >= Disk->R1 && r_cyl <= Disk->R2 && std::abs(pos.y) <= Disk->Thickness;
+        }
+
+        Ray InitRay(const glm::vec3& pos, const glm::vec3& dir)
+        {
+            Ray ray;
+            ray.x     = pos.x;
+            ray.y     = pos.y;
+            ray.z     = pos.z;
+            ray.r     = glm::length(pos);
+            ray.theta = std::acos(pos.z / ray.r);
+            ray.phi   = std::atan2(pos.y, pos.x);
+
+            float dx = dir.x;
+            float dy = dir.y;
+            float dz = dir.z;
+
+            ray.dr     = std::sin(ray.theta) * std::cos(ray.phi) * dx +
+                         std::sin(ray.theta) * std::sin(ray.phi) * dy +
+                         std::cos(ray.theta) * dz;
+
+            ray.dtheta = (std::cos(ray.theta) * std::cos(ray.phi) * dx +
+                          std::cos(ray.theta) * std::sin(ray.phi) * dy -
+                          std::sin(ray.theta) * dz) / ray.r;
+
+            ray.dphi   = (-std::sin(ray.phi) * dx + std::cos(ray.phi) * dy) /
+                         (ray.r * std::sin(ray.theta));
+
+            ray.L = ray.r * ray.r * std::sin(ray.theta) * ray.dphi;
+            float f     = 1.0f - SagA_rs / ray.r;
+            float dt_dL = std::sqrt((ray.dr * ray.dr) / f +
+                                    ray.r * ray.r * (ray.dtheta * ray.dtheta +
+                                    std::sin(ray.theta) * std::sin(ray.theta) *
+                                    ray.dphi * ray.dphi));
+            ray.E = f * dt_dL;
+
+            return ray;
+        }
+
+        bool SegmentHitsAABB(const glm::vec3& origin, const glm::vec3& invDir, float len, const glm::vec3& bmin, const glm::vec3& bmax)
+        {
+            glm::vec3 t0    = (bmin - origin) * invDir;
+            glm::vec3 t1    = (bmax - origin) * invDir;
+            glm::vec3 tNear = glm::min(t0, t1);
+            glm::vec3 tFar  = glm::max(t0, t1);
+
+            float enter = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+            float exit  = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, len));
+            return enter <= exit;
+        }
+
+        float SegmentSphere(const glm::vec3& origin, const glm::vec3& dir, float len, const glm::vec3& center, float radius)
+        {
+            glm::vec3 oc = origin - center;
+            float     c  = glm::dot(oc, oc) - radius * radius;
+            if (c <= 0.0f)
+                return 0.0f;
+
+            float b = glm::dot(oc, dir);
+            if (b > 0.0f)
+                return -1.0f;
+
+            float disc = b * b - c;
+            if (disc < 0.0f)
+                return -1.0f;
+
+            float t = -b - std::sqrt(disc);
+            return t <= len ? t : -1.0f;
+        }
+
+        bool GeodesicKernel::InterceptObject(const glm::vec3& from, const glm::vec3& to, ObjectHit& hit) const
+        {
+            if (NumNodes == 0)
+                return false;
+
+            glm::vec3 delta = to - from;
+            float     len   = glm::length(delta);
+            if (len <= 0.0f)
+                return false;
+
+            glm::vec3 dir    = delta / len;
+            glm::vec3 invDir = 1.0f / dir;
+
+            float closest  = len;
+            int   hitIndex = -1;
+
+            int stack[BVH_STACK_SIZE];
+            int sp = 0;
+            stack[sp++] = 0;
+
+            while (sp > 0)
+            {
+                int index = stack[--sp];
+                if (index < 0 || index >= NumNodes)
+                    continue;
+
+                const BVHNode& node = Nodes[index];
+                if (!SegmentHitsAABB(from, invDir, closest, node.m_Min, node.m_Max))
+                    continue;
+
+                if (node.m_Count > 0)
+                {
+                    int last = std::min(node.m_LeftFirst + node.m_Count, NumObjects);
+                    for (int i = node.m_LeftFirst; i < last; ++i)
+                    {
+                        float t = SegmentSphere(from, dir, closest, glm::vec3(ObjectData[i].PosRadius), ObjectData[i].PosRadius.w);
+                        if (t >= 0.0f)
+                        {
+                            closest  = t;
+                            hitIndex = i;
+                        }
+                    }
+                }
+                else if (sp + 2 <= BVH_STACK_SIZE)
+                {
+                    stack[sp++] = node.m_LeftFirst;
+                    stack[sp++] = node.m_LeftFirst + 1;
+                }
+            }
+
+            if (hitIndex < 0)
+                return false;
+
+            hit.Color  = ObjectData[hitIndex].Color;
+            hit.Point  = from + dir * closest;
+            hit.Center = glm::vec3(ObjectData[hitIndex].PosRadius);
+            hit.Radius = ObjectData[hitIndex].PosRadius.w;
+            return true;
+        }
+
+        void GeodesicRHS(const Ray& ray, glm::vec3& d1, glm::vec3& d2)
+        {
+            float r      = ray.r;
+            float theta  = ray.theta;
+            float dr     = ray.dr;
+            float dtheta = ray.dtheta;
+            float dphi   = ray.dphi;
+            float f      = 1.0f - SagA_rs / r;
+            float dt_dL  = ray.E / f;
+
+            d1 = glm::vec3(dr, dtheta, dphi);
+            d2.x = -(SagA_rs / (2.0f * r * r)) * f * dt_dL * dt_dL
+                   + (SagA_rs / (2.0f * r * r * f)) * dr * dr
+                   + r * (dtheta * dtheta + std::sin(theta) * std::sin(theta) * dphi * dphi);
+            d2.y = -2.0f * dr * dtheta / r + std::sin(theta) * std::cos(theta) * dphi * dphi;
+            d2.z = -2.0f * dr * dphi / r - 2.0f * std::cos(theta) / std::sin(theta) * dtheta * dphi;
+        }
+
+        void RK4Step(Ray& ray, float dL)
+        {
+            glm::vec3 k1a, k1b;
+            GeodesicRHS(ray, k1a, k1b);
+
+            ray.r      += dL * k1a.x;
+            ray.theta  += dL * k1a.y;
+            ray.phi    += dL * k1a.z;
+            ray.dr     += dL * k1b.x;
+            ray.dtheta += dL * k1b.y;
+            ray.dphi   += dL * k1b.z;
+
+            ray.x = ray.r * std::sin(ray.theta) * std::cos(ray.phi);
+            ray.y = ray.r * std::sin(ray.theta) * std::sin(ray.phi);
+            ray.z = ray.r * std::cos(ray.theta);
+        }
+
+        float CalculateAdaptiveStepSize(const Ray& ray, float baseStepSize)
+        {
+            float r_factor         = std::clamp(ray.r / (SagA_rs * 10.0f), 0.1f, 1.0f);
+            float curvature        = glm::length(glm::vec3(ray.dr, ray.dtheta * ray.r, ray.dphi * ray.r * std::sin(ray.theta)));
+            float curvature_factor = std::clamp(1e12f / (curvature + 1e6f), 0.1f, 2.0f);
+
+            return std::clamp(baseStepSize * r_factor * curvature_factor, MIN_STEP_SIZE, MAX_STEP_SIZE);
+        }
+
+        glm::vec4 GeodesicKernel::TracePixel(int px, int py, int width, int height, glm::vec3& escapeDirection, bool& escaped) const
+        {
+            escapeDirection = glm::vec3(0.0f);
+            escaped         = false;
+
+            float u = (2.0f * (px + 0.5f) / width - 1.0f) * Cam->Aspect * Cam->TanHalfFov;
+            float v = (1.0f - 2.0f * (py + 0.5f) / height) * Cam->TanHalfFov;
+            glm::vec3 dir = glm::normalize(u * Cam->CamRight - v * Cam->CamUp + Cam->CamForward);
+            Ray ray = InitRay(Cam->CamPos, dir);
+
+            glm::vec4 color(0.0f);
+            glm::vec3 prevPos(ray.x, ray.y, ray.z);
+            float     lambda = 0.0f;
+
+            bool      hitBlackHole = false;
+            bool      hitObject    = false;
+            ObjectHit hit;
+
+            glm::vec4 accumulatedColor(0.0f);
+            float     transmittance = 1.0f;
+
+            bool moving   = Cam->Moving != 0;
+            int  maxSteps = moving ? Simulation->MaxStepsMoving : Simulation->MaxStepsStatic;
+
+            if (maxSteps <= 0)
+                maxSteps = moving ? DEFAULT_MAX_STEPS_MOVING : DEFAULT_MAX_STEPS_STATIC;
+
+            float cameraDistance = glm::length(Cam->CamPos);
+            if (cameraDistance > 2e12f)
+                maxSteps = maxSteps / 2;
+            else if (cameraDistance > 1e12f)
+                maxSteps = static_cast<int>(maxSteps * 0.75f);
+
+            float initialEscapeVelocity = std::sqrt(2.0f * SagA_rs / ray.r);
+            if (ray.dr > initialEscapeVelocity * 0.95f &&
+                ray.r  > SagA_rs * 200.0f)
+                maxSteps = maxSteps / 2;
+
+            float currentStepSize = D_LAMBDA;
+            bool  objectsInReach  = Objects->NumObjects > 0;
+            float exitDistance    = Simulation->EarlyExitDistance > 0.0f ? Simulation->EarlyExitDistance : DEFAULT_EARLY_EXIT_DISTANCE;
+
+            for (int i = 0; i < maxSteps; ++i)
+            {
+                if (ray.r > exitDistance)
+                    break;
+                if (ray.r > ESCAPE_R)
+                    break;
+
+                if (ray.r <= SagA_rs)
+                {
+                    hitBlackHole = true;
+                    break;
+                }
+
+                currentStepSize = CalculateAdaptiveStepSize(ray, D_LAMBDA);
+
+                RK4Step(ray, currentStepSize);
+                lambda += currentStepSize;
+
+                glm::vec3 newPos(ray.x, ray.y, ray.z);
+
+                if (IsInDiskVolume(newPos))
+                {
+                    glm::vec4 diskSample = SampleDiskColor(newPos);
+                    float     density    = diskSample.a;
+                    glm::vec3 diskColor  = glm::vec3(diskSample);
+
+                    float stepLength = currentStepSize * 1e-8f;
+
+                    float absorption = density * stepLength * 0.8f;
+                    float scattering = density * stepLength * 1.5f;
+                    float extinction = absorption + scattering;
+
+                    float stepTransmittance = std::exp(-extinction);
+
+                    glm::vec3 emission = diskColor * density * stepLength * 4.0f * std::sqrt(Disk->Density);
+
+                    glm::vec3 glowColor       = Mix(diskColor, glm::vec3(1.0f, 0.8f, 0.6f), 0.3f);
+                    float     glowIntensity   = density * stepLength * 2.0f;
+                    glm::vec3 atmosphericGlow = glowColor * glowIntensity * 0.8f;
+
+                    glm::vec3 totalEmission = emission + atmosphericGlow;
+                    accumulatedColor += glm::vec4(totalEmission * transmittance, 0.0f);
+
+                    transmittance *= stepTransmittance;
+
+                    if (transmittance < 0.01f)
+                        break;
+                }
+
+                if (objectsInReach)
+                {
+                    if (InterceptObject(prevPos, newPos, hit))
+                    {
+                        hitObject = true;
+                        break;
+                    }
+
+                    if (ray.dr > 0.0f && ray.r > Objects->ObjectsReach && ray.r > SagA_rs * 1.5f)
+                        objectsInReach = false;
+                }
+
+                prevPos = newPos;
+
+                if (ray.dr > 0.0f && ray.r > SagA_rs * 100.0f && lambda > 2e8f)
+                    break;
+            }
+
+            accumulatedColor.a = 1.0f - transmittance;
+
+            if (hitBlackHole)
+                color = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+            else if (hitObject)
+            {
+                glm::vec3 N = glm::normalize(hit.Point - hit.Center);
+                glm::vec3 V = glm::normalize(Cam->CamPos - hit.Point);
+
+                float     ambient   = 0.1f;
+                float     diff      = std::max(glm::dot(N, V), 0.0f);
+                float     intensity = ambient + (1.0f - ambient) * diff;
+                glm::vec3 shaded    = glm::vec3(hit.Color) * intensity;
+
+                color = glm::vec4(shaded, hit.Color.a);
+                color = Mix(accumulatedColor, color, color.a);
+            }
+            else
+            {
+                escapeDirection = glm::normalize(glm::vec3(ray.x, ray.y, ray.z) - Cam->CamPos);
+                escaped         = true;
+                color           = accumulatedColor;
+            }
+
+            return color;
+        }
+
+        float NeighbourSpread(const glm::vec4* escapeDirections, int x, int y, const glm::vec3& direction)
+        {
+            if (x < 0 || y < 0 || x >= static_cast<int>(TILE_SIZE) || y >= static_cast<int>(TILE_SIZE))
+                return -1.0f;
+
+            const glm::vec4& neighbour = escapeDirections[y * TILE_SIZE + x];
+            if (neighbour.w == 0.0f)
+                return -1.0f;
+
+            return 2.0f * std::asin(std::clamp(0.5f * glm::length(direction - glm::vec3(neighbour)), 0.0f, 1.0f));
+        }
+
+        float GeodesicKernel::EnvironmentLod(const glm::vec4* escapeDirections, uint32_t lx, uint32_t ly, const glm::vec3& direction) const
+        {
+            int x = static_cast<int>(lx);
+            int y = static_cast<int>(ly);
+
+            float spreadX = std::max(NeighbourSpread(escapeDirections, x + 1, y, direction), NeighbourSpread(escapeDirections, x - 1, y, direction));
+            float spreadY = std::max(NeighbourSpread(escapeDirections, x, y + 1, direction), NeighbourSpread(escapeDirections, x, y - 1, direction));
+            float spread  = std::max(spreadX, spreadY);
+            if (spread <= 0.0f || !HDRI)
+                return 0.0f;
+
+            float texelAngle = 1.5707963f / static_cast<float>(HDRI->GetWidth());
+            return std::max(std::log2(spread / texelAngle), 0.0f);
+        }
+
+        void GeodesicKernel::RunTile(uint32_t groupX, uint32_t groupY) const
+        {
+            glm::vec4 escapeDirections[TILE_SIZE * TILE_SIZE];
+            glm::vec4 colors[TILE_SIZE * TILE_SIZE];
+
+            int width  = static_cast<int>(Image->Width);
+            int height = static_cast<int>(Image->Height);
+
+            for (uint32_t ly = 0; ly < TILE_SIZE; ++ly)
+            {
+                for (uint32_t lx = 0; lx < TILE_SIZE; ++lx)
+                {
+                    int  px     = static_cast<int>(groupX * TILE_SIZE + lx);
+                    int  py     = static_cast<int>(groupY * TILE_SIZE + ly);
+                    uint32_t local = ly * TILE_SIZE + lx;
+
+                    glm::vec3 escapeDirection(0.0f);
+                    bool      escaped = false;
+                    colors[local]     = glm::vec4(0.0f);
+
+                    if (px < width && py < height)
+                        colors[local] = TracePixel(px, py, width, height, escapeDirection, escaped);
+
+                    escapeDirections[local] = glm::vec4(escapeDirection, escaped ? 1.0f : 0.0f);
+                }
+            }
+
+            // The tile loop above stands in for barrier(): every direction is now known
+            for (uint32_t ly = 0; ly < TILE_SIZE; ++ly)
+            {
+                for (uint32_t lx = 0; lx < TILE_SIZE; ++lx)
+                {
+                    int px = static_cast<int>(groupX * TILE_SIZE + lx);
+                    int py = static_cast<int>(groupY * TILE_SIZE + ly);
+                    if (px >= width || py >= height)
+                        continue;
+
+                    uint32_t   local = ly * TILE_SIZE + lx;
+                    glm::vec4  color = colors[local];
+                    const auto& escape = escapeDirections[local];
+
+                    if (escape.w != 0.0f)
+                    {
+                        glm::vec3 direction(escape);
+                        glm::vec3 hdriColor = HDRI ? HDRI->Sample(direction, EnvironmentLod(escapeDirections, lx, ly, direction)) : glm::vec3(0.0f);
+                        color = glm::vec4(Mix(glm::vec3(color), hdriColor, 1.0f - color.a), 1.0f);
+                    }
+
+                    Image->Store(static_cast<uint32_t>(px), static_cast<uint32_t>(py), color);
+                }
+            }
+        }
+    }
+
+    void SoftwareKernels::Geodesic(SoftwareContext& context, uint32_t groupsX, uint32_t groupsY)
+    {
+        GeodesicKernel kernel;
+        kernel.Cam        = context.UniformBlocks[1].As<CameraBlock>();
+        kernel.Disk       = context.UniformBlocks[2].As<DiskBlock>();
+        kernel.Objects    = context.UniformBlocks[3].As<ObjectsBlock>();
+        kernel.Simulation = context.UniformBlocks[4].As<SimulationBlock>();
+        kernel.HDRI       = context.Cubemaps[5];
+        kernel.Image      = context.Images[0];
+
+        if (!kernel.Cam || !kernel.Disk || !kernel.Objects || !kernel.Simulation || !kernel.Image)
+        {
+            static bool s_Warned = false;
+            if (!s_Warned)
+                DONUT_WARN("Geodesic dispatch skipped: a uniform block or the output image is not bound");
+            s_Warned = true;
+            return;
+        }
+
+        // Storage buffers are sized generously, so only trust the counts the uniforms
+        // give as far as the bound ranges actually reach
+        const auto& objects = context.StorageBlocks[0];
+        const auto& nodes   = context.StorageBlocks[1];
+        kernel.ObjectData   = objects.As<SceneObject>();
+        kernel.Nodes        = nodes.As<BVHNode>();
+        kernel.NumObjects   = kernel.ObjectData ? std::min<int32_t>(kernel.Objects->NumObjects, objects.GetCount<SceneObject>()) : 0;
+        kernel.NumNodes     = kernel.Nodes      ? std::min<int32_t>(kernel.Objects->NumNodes,   nodes.GetCount<BVHNode>())       : 0;
+
+        JobSystem::ParallelFor(groupsX * groupsY, 1, [&kernel, groupsX](uint32_t begin, uint32_t end)
+        {
+            for (uint32_t group = begin; group < end; ++group)
+                kernel.RunTile(group % groupsX, group / groupsX);
+        });
+    }
+};
@@ -0,0 +1,9 @@
+#include "SoftwareIndexBuffer.h"
+
+namespace Donut
+{
+    SoftwareIndexBuffer::SoftwareIndexBuffer(const uint32_t* indices, uint32_t count)
+        : m_Indices(indices, indices + count)
+    {
+    }
+};
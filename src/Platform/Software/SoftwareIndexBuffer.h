@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Rendering/IndexBuffer.h"
+
+#include <vector>
+
+namespace Donut
+{
+    class SoftwareIndexBuffer
+        : public IndexBuffer 
+    {
+    public:
+        SoftwareIndexBuffer(const uint32_t* indices, uint32_t count);
+        virtual ~SoftwareIndexBuffer() = default;
+
+        virtual void Bind()         const override {}
+        virtual void Unbind()       const override {}
+        virtual uint32_t GetCount() const override { return static_cast<uint32_t>(m_Indices.size()); }
+
+    private:
+        std::vector<uint32_t> m_Indices;
+    };
+};
@@ -0,0 +1,187 @@
+#include "SoftwareKernels.h"
+#include "SoftwareContext.h"
+#include "SoftwareShader.h"
+#include "SoftwareTexture.h"
+
+#include "Core/JobSystem.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace Donut
+{
+    static constexpr uint32_t s_RowGrain = 16;
+
+    static float Smoothstep(float edge0, float edge1, float x)
+    {
+        float t = std::clamp((x - edge0) / (edge1 - edge0), 0.0f, 1.0f);
+        return t * t * (3.0f - 2.0f * t);
+    }
+
+    static int WrapRepeat(int i, uint32_t size)
+    {
+        int m = i % static_cast<int>(size);
+        return m < 0 ? m + static_cast<int>(size) : m;
+    }
+
+    // Viewport clipped to the render target, as GL's scissor-free rasteriser would
+    static SoftwareViewport ClipViewport(const SoftwareViewport& viewport, const SoftwareImage& target)
+    {
+        SoftwareViewport clipped = viewport;
+        clipped.X      = std::min(viewport.X, target.Width);
+        clipped.Y      = std::min(viewport.Y, target.Height);
+        clipped.Width  = std::min(viewport.Width,  target.Width  - clipped.X);
+        clipped.Height = std::min(viewport.Height, target.Height - clipped.Y);
+        return clipped;
+    }
+
+    // Output merger for an RGBA8 target: clamp, then SRC_ALPHA / ONE_MINUS_SRC_ALPHA
+    // blending on all four channels when enabled
+    static void WriteFragment(SoftwareImage& target, uint32_t x, uint32_t y, glm::vec4 color, bool blending)
+    {
+        color = glm::clamp(color, glm::vec4(0.0f), glm::vec4(1.0f));
+        if (blending)
+            color = color * color.a + target.Load(x, y) * (1.0f - color.a);
+        target.Store(x, y, color);
+    }
+
+    // Runs fn(u, v) for the centre of every pixel the fullscreen quad covers
+    template<typename Fn>
+    static void ShadeViewport(SoftwareContext& context, Fn&& fn)
+    {
+        SoftwareImage&   target   = context.GetRenderTarget();
+        SoftwareViewport viewport = ClipViewport(context.Viewport, target);
+        if (viewport.Width == 0 || viewport.Height == 0)
+            return;
+
+        bool  blending = context.Blending;
+        float invWidth  = 1.0f / static_cast<float>(context.Viewport.Width);
+        float invHeight = 1.0f / static_cast<float>(context.Viewport.Height);
+
+        JobSystem::ParallelFor(viewport.Height, s_RowGrain, [&](uint32_t begin, uint32_t end)
+        {
+            for (uint32_t row = begin; row < end; ++row)
+            {
+                float v = (static_cast<float>(row) + 0.5f) * invHeight;
+                for (uint32_t column = 0; column < viewport.Width; ++column)
+                {
+                    float u = (static_cast<float>(column) + 0.5f) * invWidth;
+                    WriteFragment(target, viewport.X + column, viewport.Y + row, fn(column, row, u, v), blending);
+                }
+            }
+        });
+    }
+
+    static const SoftwareImage* GetSampler(const SoftwareContext& context, const SoftwareShader& shader)
+    {
+        int slot = shader.GetInt("u_ScreenTexture", 0);
+        if (slot < 0 || slot >= static_cast<int>(SoftwareContext::MaxBindings))
+            return nullptr;
+
+        const SoftwareImage* texture = context.Textures[slot];
+        return texture && texture->Width > 0 && texture->Height > 0 ? texture : nullptr;
+    }
+
+    void SoftwareKernels::TexturedQuad(SoftwareContext& context, const SoftwareShader& shader)
+    {
+        const SoftwareImage* texture = GetSampler(context, shader);
+        if (!texture)
+            return;
+
+        ShadeViewport(context, [texture](uint32_t, uint32_t, float u, float v)
+        {
+            return texture->Sample(glm::vec2(u, v));
+        });
+    }
+
+    void SoftwareKernels::Blur(SoftwareContext& context, const SoftwareShader& shader)
+    {
+        const SoftwareImage* texture = GetSampler(context, shader);
+        if (!texture)
+            return;
+
+        constexpr int Radius = 8;
+
+        glm::vec2 resolution    = glm::vec2(shader.GetFloat4("u_Resolution", glm::vec4(1.0f)));
+        float     blurStrength  = shader.GetFloat4("u_BlurStrength").x;
+        float     glowIntensity = shader.GetFloat4("u_GlowIntensity").x;
+        glm::vec2 texelSize     = 1.0f / resolution;
+
+        // Blur.glsl takes 17x17 bilinear taps weighted by exp(-(x² + y²) / 128). Both the
+        // Gaussian and bilinear filtering factor into x and y, so the same sum is computed
+        // as a horizontal pass over every source row followed by a vertical pass.
+        float weights[2 * Radius + 1];
+        float weightSum = 0.0f;
+        for (int i = -Radius; i <= Radius; ++i)
+        {
+            weights[i + Radius] = std::exp(-static_cast<float>(i * i) / (2.0f * 8.0f * 8.0f));
+            weightSum += weights[i + Radius];
+        }
+        float normalisation = 1.0f / (weightSum * weightSum);
+
+        SoftwareImage&   target   = context.GetRenderTarget();
+        SoftwareViewport viewport = ClipViewport(context.Viewport, target);
+        if (viewport.Width == 0 || viewport.Height == 0)
+            return;
+
+        float invWidth  = 1.0f / static_cast<float>(context.Viewport.Width);
+        float invHeight = 1.0f / static_cast<float>(context.Viewport.Height);
+
+        // horizontal[row * viewport.Width + column]: source row filtered along x for each output column
+        std::vector<glm::vec4> horizontal(static_cast<size_t>(texture->Height) * viewport.Width);
+        JobSystem::ParallelFor(texture->Height, s_RowGrain, [&](uint32_t begin, uint32_t end)
+        {
+            for (uint32_t row = begin; row < end; ++row)
+            {
+                for (uint32_t column = 0; column < viewport.Width; ++column)
+                {
+                    float     u   = (static_cast<float>(column) + 0.5f) * invWidth;
+                    glm::vec4 sum = glm::vec4(0.0f);
+                    for (int x = -Radius; x <= Radius; ++x)
+                    {
+                        float sx = (u + x * texelSize.x * blurStrength) * texture->Width - 0.5f;
+                        float fx = std::floor(sx);
+                        float ax = sx - fx;
+                        uint32_t x0 = WrapRepeat(static_cast<int>(fx),     texture->Width);
+                        uint32_t x1 = WrapRepeat(static_cast<int>(fx) + 1, texture->Width);
+
+                        glm::vec4 tap = texture->Load(x0, row) * (1.0f - ax) + texture->Load(x1, row) * ax;
+                        sum += tap * weights[x + Radius];
+                    }
+                    horizontal[static_cast<size_t>(row) * viewport.Width + column] = sum;
+                }
+            }
+        });
+
+        ShadeViewport(context, [&](uint32_t column, uint32_t, float u, float v)
+        {
+            glm::vec4 blurredColor = glm::vec4(0.0f);
+            for (int y = -Radius; y <= Radius; ++y)
+            {
+                float sy = (v + y * texelSize.y * blurStrength) * texture->Height - 0.5f;
+                float fy = std::floor(sy);
+                float ay = sy - fy;
+                uint32_t y0 = WrapRepeat(static_cast<int>(fy),     texture->Height);
+                uint32_t y1 = WrapRepeat(static_cast<int>(fy) + 1, texture->Height);
+
+                glm::vec4 tap = horizontal[static_cast<size_t>(y0) * viewport.Width + column] * (1.0f - ay) +
+                                horizontal[static_cast<size_t>(y1) * viewport.Width + column] * ay;
+                blurredColor += tap * weights[y + Radius];
+            }
+            blurredColor *= normalisation;
+
+            glm::vec4 centerColor = texture->Sample(glm::vec2(u, v));
+
+            float brightness = (centerColor.r + centerColor.g + centerColor.b) / 3.0f;
+            float glowMask   = Smoothstep(0.05f, 0.3f, brightness);
+
+            glm::vec3 emissionColor = glm::vec3(1.0f, 0.8f, 0.6f);
+            glm::vec3 glowColor     = emissionColor * glowMask * glowIntensity * 2.0f;
+            glm::vec3 auraColor     = glm::vec3(blurredColor) * glowMask * glowIntensity * 0.8f;
+            glm::vec3 finalColor    = glm::vec3(centerColor) + glowColor + auraColor;
+
+            return glm::vec4(finalColor, centerColor.a);
+        });
+    }
+};
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Donut
+{
+    struct SoftwareContext;
+    class  SoftwareShader;
+
+    // C++ ports of the GLSL programs, reading their inputs from the context's bindings.
+    // Each kernel splits its work across the job system and returns once it is done.
+    class SoftwareKernels
+    {
+    public:
+        // Geodesic.glsl: one job per 16x16 work group, with the group's escape
+        // directions shared between its pixels exactly like the GPU's shared memory
+        static void Geodesic(SoftwareContext& context, uint32_t groupsX, uint32_t groupsY);
+
+        // Fullscreen fragment passes over the viewport of the current render target
+        static void Blur(SoftwareContext& context, const SoftwareShader& shader);
+        static void TexturedQuad(SoftwareContext& context, const SoftwareShader& shader);
+    };
+};
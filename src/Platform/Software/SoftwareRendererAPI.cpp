@@ -0,0 +1,188 @@
+#include "SoftwareRendererAPI.h"
+#include "SoftwareContext.h"
+#include "SoftwareShader.h"
+#include "SoftwareTexture.h"
+
+#include "Core/JobSystem.h"
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace Donut
+{
+    SoftwareRendererAPI::~SoftwareRendererAPI()
+    {
+        if (!m_CanPresent || !glfwGetCurrentContext())
+            return;
+
+        glDeleteFramebuffers(1, &m_PresentFramebuffer);
+        glDeleteTextures(1, &m_PresentTexture);
+    }
+
+    void SoftwareRendererAPI::Init()
+    {
+        auto& context = SoftwareContext::Get();
+        context.Blending = true;
+
+        // Headless runs have no context at all; a window only needs GL to show the frame
+        if (glfwGetCurrentContext())
+        {
+            if (gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+                m_CanPresent = true;
+            else
+                DONUT_ERROR("Failed to initialize GLAD, the software renderer cannot present!");
+        }
+
+        DONUT_INFO("Software renderer using {} worker threads", JobSystem::GetWorkerCount() + 1);
+    }
+
+    void SoftwareRendererAPI::SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+    {
+        auto& context = SoftwareContext::Get();
+        context.Viewport = { x, y, width, height };
+
+        // The default framebuffer follows the window, which is what sets the viewport on resize
+        if (!context.Framebuffer)
+        {
+            auto& backBuffer = context.GetBackBuffer();
+            if (backBuffer.Width != x + width || backBuffer.Height != y + height)
+                backBuffer.Resize(x + width, y + height);
+        }
+    }
+
+    void SoftwareRendererAPI::SetClearColor(const glm::vec4& color)
+    {
+        SoftwareContext::Get().ClearColor = color;
+    }
+
+    void SoftwareRendererAPI::Clear()
+    {
+        auto& context = SoftwareContext::Get();
+        context.GetRenderTarget().Fill(context.ClearColor);
+    }
+
+    void SoftwareRendererAPI::EnableDepthTest()
+    {
+    }
+
+    void SoftwareRendererAPI::DisableDepthTest()
+    {
+    }
+
+    void SoftwareRendererAPI::SetFaceCulling(bool enabled)
+    {
+    }
+
+    void SoftwareRendererAPI::EnableBlending()
+    {
+        SoftwareContext::Get().Blending = true;
+    }
+
+    void SoftwareRendererAPI::DisableBlending()
+    {
+        SoftwareContext::Get().Blending = false;
+    }
+
+    void SoftwareRendererAPI::DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount)
+    {
+        if (!m_WarnedMeshDraw)
+            DONUT_WARN("The software renderer does not rasterise meshes; indexed draws are skipped");
+        m_WarnedMeshDraw = true;
+    }
+
+    void SoftwareRendererAPI::DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t instanceCount, uint32_t indexCount)
+    {
+        DrawIndexed(vertexArray, indexCount);
+    }
+
+    void SoftwareRendererAPI::DrawArrays(uint32_t vertexCount, uint32_t first)
+    {
+        // Array draws are only used for the fullscreen quad, which the bound kernel covers
+        if (const SoftwareShader* program = SoftwareContext::Get().Program)
+            program->Draw();
+    }
+
+    void SoftwareRendererAPI::DrawLines(const Ref<VertexArray>& vertexArray, uint32_t indexCount)
+    {
+        DrawIndexed(vertexArray, indexCount);
+    }
+
+    void SoftwareRendererAPI::BindTexture(uint32_t textureID, uint32_t slot)
+    {
+        auto& context = SoftwareContext::Get();
+        if (slot < SoftwareContext::MaxBindings)
+            context.Textures[slot] = context.FindImage(textureID);
+    }
+
+    void SoftwareRendererAPI::BindImageTexture(uint32_t textureID, uint32_t slot, bool readOnly)
+    {
+        auto& context = SoftwareContext::Get();
+        if (slot < SoftwareContext::MaxBindings)
+            context.Images[slot] = context.FindImage(textureID);
+    }
+
+    void SoftwareRendererAPI::ReadPixels(uint32_t x, uint32_t y, uint32_t width, uint32_t height, 
+                                         uint32_t format, uint32_t type, void* pixels)
+    {
+        if (format != GL_RGBA || type != GL_UNSIGNED_BYTE)
+        {
+            DONUT_ERROR("Software ReadPixels only supports RGBA8");
+            return;
+        }
+
+        const auto& target = SoftwareContext::Get().GetRenderTarget();
+        uint8_t*    output = static_cast<uint8_t*>(pixels);
+        for (uint32_t row = 0; row < height; ++row)
+        {
+            uint8_t* destination = output + static_cast<size_t>(row) * width * 4;
+            if (y + row >= target.Height || x >= target.Width)
+            {
+                std::memset(destination, 0, static_cast<size_t>(width) * 4);
+                continue;
+            }
+
+            uint32_t copied = std::min(width, target.Width - x);
+            std::memcpy(destination, &target.Pixels[(static_cast<size_t>(y + row) * target.Width + x) * 4], static_cast<size_t>(copied) * 4);
+            std::memset(destination + static_cast<size_t>(copied) * 4, 0, static_cast<size_t>(width - copied) * 4);
+        }
+    }
+
+    void SoftwareRendererAPI::Present()
+    {
+        if (!m_CanPresent)
+            return;
+
+        const auto& backBuffer = SoftwareContext::Get().GetBackBuffer();
+        if (backBuffer.Width == 0 || backBuffer.Height == 0)
+            return;
+
+        if (backBuffer.Width != m_PresentWidth || backBuffer.Height != m_PresentHeight)
+        {
+            if (m_PresentTexture)
+            {
+                glDeleteFramebuffers(1, &m_PresentFramebuffer);
+                glDeleteTextures(1, &m_PresentTexture);
+            }
+
+            m_PresentWidth  = backBuffer.Width;
+            m_PresentHeight = backBuffer.Height;
+
+            glCreateTextures(GL_TEXTURE_2D, 1, &m_PresentTexture);
+            glTextureStorage2D(m_PresentTexture, 1, GL_RGBA8, m_PresentWidth, m_PresentHeight);
+            glCreateFramebuffers(1, &m_PresentFramebuffer);
+            glNamedFramebufferTexture(m_PresentFramebuffer, GL_COLOR_ATTACHMENT0, m_PresentTexture, 0);
+        }
+
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+        glTextureSubImage2D(m_PresentTexture, 0, 0, 0, m_PresentWidth, m_PresentHeight,
+                            GL_RGBA, GL_UNSIGNED_BYTE, backBuffer.Pixels.data());
+        glBlitNamedFramebuffer(m_PresentFramebuffer, 0, 
+                               0, 0, m_PresentWidth, m_PresentHeight,
+                               0, 0, m_PresentWidth, m_PresentHeight,
+                               GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    }
+};
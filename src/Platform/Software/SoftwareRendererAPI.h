@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Core/Memory.h"
+#include "Core/Log.h"
+
+#include "Rendering/Renderer.h"
+
+namespace Donut
+{
+    // Renders into CPU images through SoftwareContext. Fullscreen passes and compute
+    // dispatches run their C++ kernels; mesh draws are not rasterised. A window with
+    // a GL context is only used to show the back buffer in Present().
+    class SoftwareRendererAPI 
+        : public RendererAPI
+    {
+    public:
+        virtual ~SoftwareRendererAPI();
+
+        virtual void Init()                                       override;
+        virtual void SetViewport(uint32_t x,     uint32_t y, 
+                                 uint32_t width, uint32_t height) override;
+        virtual void SetClearColor(const glm::vec4& color)        override;
+        virtual void Clear()                                      override;
+        virtual void EnableDepthTest()                            override;
+        virtual void DisableDepthTest()                           override;
+        virtual void SetFaceCulling(bool enabled)                 override;
+        virtual void EnableBlending()                             override;
+        virtual void DisableBlending()                            override;
+
+        virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, 
+                                 uint32_t indexCount = 0)         override;
+        virtual void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray,
+                                          uint32_t instanceCount,
+                                          uint32_t indexCount = 0) override;
+        
+        virtual void DrawArrays(uint32_t vertexCount, 
+                                uint32_t first = 0)               override;
+        virtual void DrawLines(const Ref<VertexArray>& vertexArray, 
+                               uint32_t indexCount = 0)           override;
+        virtual void BindTexture(uint32_t textureID, 
+                                 uint32_t slot = 0)               override;
+        virtual void BindImageTexture(uint32_t textureID, 
+                                      uint32_t slot = 0, 
+                                      bool readOnly = false)      override;
+        virtual void ReadPixels(uint32_t x, uint32_t y, 
+                                uint32_t width,  uint32_t height, 
+                                uint32_t format, uint32_t type, 
+                                void* pixels)                     override;
+        virtual void Present()                                    override;
+    private:
+        bool     m_CanPresent          = false;
+        bool     m_WarnedMeshDraw      = false;
+        uint32_t m_PresentTexture      = 0;
+        uint32_t m_PresentFramebuffer  = 0;
+        uint32_t m_PresentWidth        = 0;
+        uint32_t m_PresentHeight       = 0;
+    };
+};
@@ -0,0 +1,151 @@
+#include "SoftwareShader.h"
+#include "SoftwareContext.h"
+#include "SoftwareKernels.h"
+
+#include "Core/Log.h"
+
+namespace Donut
+{
+    static std::string GetFileStem(const std::string& filepath)
+    {
+        auto lastSlash = filepath.find_last_of("/\\");
+        lastSlash = lastSlash == std::string::npos ? 0 : lastSlash + 1;
+        auto lastDot = filepath.rfind('.');
+        auto count = lastDot == std::string::npos || lastDot < lastSlash ? filepath.size() - lastSlash : lastDot - lastSlash;
+        return filepath.substr(lastSlash, count);
+    }
+
+    SoftwareShader::SoftwareShader(const std::string& filepath)
+        : m_Name(GetFileStem(filepath))
+    {
+        ResolveKernel();
+    }
+
+    SoftwareShader::SoftwareShader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc)
+        : m_Name(name)
+    {
+        ResolveKernel();
+    }
+
+    SoftwareShader::SoftwareShader(const std::string& name, const std::string& computeSrc)
+        : m_Name(name)
+    {
+        ResolveKernel();
+    }
+
+    SoftwareShader::~SoftwareShader()
+    {
+        SoftwareContext::Get().Release(this);
+    }
+
+    void SoftwareShader::ResolveKernel()
+    {
+        // Compute shaders are registered under their path, so match on the stem
+        std::string stem = GetFileStem(m_Name);
+        if (stem == "Geodesic")
+            m_Kernel = Kernel::Geodesic;
+        else if (stem == "Blur")
+            m_Kernel = Kernel::Blur;
+        else if (stem == "TexturedQuad")
+            m_Kernel = Kernel::TexturedQuad;
+        else
+            DONUT_WARN("Shader '{}' has no software kernel; draws with it are skipped", m_Name);
+    }
+
+    void SoftwareShader::Bind() const
+    {
+        SoftwareContext::Get().Program = this;
+    }
+
+    void SoftwareShader::Unbind() const
+    {
+        SoftwareContext::Get().Release(this);
+    }
+
+    void SoftwareShader::SetInt(const std::string& name, int value)
+    {
+        m_Ints[name] = value;
+    }
+
+    void SoftwareShader::SetIntArray(const std::string& name, int* values, uint32_t count)
+    {
+        for (uint32_t i = 0; i < count; ++i)
+            m_Ints[name + "[" + std::to_string(i) + "]"] = values[i];
+    }
+
+    void SoftwareShader::SetFloat(const std::string& name, float value)
+    {
+        m_Floats[name] = glm::vec4(value, 0.0f, 0.0f, 0.0f);
+    }
+
+    void SoftwareShader::SetFloat2(const std::string& name, const glm::vec2& value)
+    {
+        m_Floats[name] = glm::vec4(value, 0.0f, 0.0f);
+    }
+
+    void SoftwareShader::SetFloat3(const std::string& name, const glm::vec3& value)
+    {
+        m_Floats[name] = glm::vec4(value, 0.0f);
+    }
+
+    void SoftwareShader::SetFloat4(const std::string& name, const glm::vec4& value)
+    {
+        m_Floats[name] = value;
+    }
+
+    void SoftwareShader::SetMat4(const std::string& name, const glm::mat4& value)
+    {
+        m_Matrices[name] = value;
+    }
+
+    int SoftwareShader::GetInt(const std::string& name, int defaultValue) const
+    {
+        auto it = m_Ints.find(name);
+        return it != m_Ints.end() ? it->second : defaultValue;
+    }
+
+    glm::vec4 SoftwareShader::GetFloat4(const std::string& name, const glm::vec4& defaultValue) const
+    {
+        auto it = m_Floats.find(name);
+        return it != m_Floats.end() ? it->second : defaultValue;
+    }
+
+    void SoftwareShader::Dispatch(uint32_t x, uint32_t y, uint32_t z)
+    {
+        auto& context = SoftwareContext::Get();
+        switch (m_Kernel)
+        {
+            case Kernel::Geodesic:
+                SoftwareKernels::Geodesic(context, x, y);
+                break;
+            default:
+                break;
+        }
+    }
+
+    void SoftwareShader::DispatchIndirect(uint32_t offset)
+    {
+        DONUT_WARN("Indirect dispatch is not supported by the software renderer");
+    }
+
+    void SoftwareShader::MemoryBarrier(uint32_t barriers)
+    {
+        // Kernels have finished writing by the time Dispatch returns
+    }
+
+    void SoftwareShader::Draw() const
+    {
+        auto& context = SoftwareContext::Get();
+        switch (m_Kernel)
+        {
+            case Kernel::Blur:
+                SoftwareKernels::Blur(context, *this);
+                break;
+            case Kernel::TexturedQuad:
+                SoftwareKernels::TexturedQuad(context, *this);
+                break;
+            default:
+                break;
+        }
+    }
+};
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "Rendering/Shader.h"
+
+#include <unordered_map>
+#include <glm/glm.hpp>
+
+namespace Donut 
+{
+    // The software backend cannot run GLSL, so a shader is a handle to the C++ port of
+    // the program with the same file stem (see SoftwareKernels). Uniforms are recorded
+    // for the kernel to read; programs without a port compile to a no-op.
+    class SoftwareShader 
+        : public Shader 
+    {
+    public:
+        enum class Kernel
+        {
+            None = 0,
+            Geodesic,
+            Blur,
+            TexturedQuad,
+        };
+    public:
+        SoftwareShader(const std::string& filepath);
+        SoftwareShader(const std::string& name, const std::string& vertexSrc, const std::string& fragmentSrc);
+        SoftwareShader(const std::string& name, const std::string& computeSrc);
+        virtual ~SoftwareShader();
+
+        virtual void Bind()   const override;
+        virtual void Unbind() const override;
+
+        virtual void SetInt(     const std::string& name, int value)                   override;
+        virtual void SetIntArray(const std::string& name, int* values, uint32_t count) override;
+        virtual void SetFloat(   const std::string& name, float value)                 override;
+        virtual void SetFloat2(  const std::string& name, const glm::vec2& value)      override;
+        virtual void SetFloat3(  const std::string& name, const glm::vec3& value)      override;
+        virtual void SetFloat4(  const std::string& name, const glm::vec4& value)      override;
+        virtual void SetMat4(    const std::string& name, const glm::mat4& value)      override;
+
+        virtual void Dispatch(uint32_t x, uint32_t y = 1, uint32_t z = 1) override;
+        virtual void DispatchIndirect(uint32_t offset = 0)                override;
+        virtual void MemoryBarrier(uint32_t barriers)                     override;
+
+        virtual const std::string& GetName() const override { return m_Name; }
+        virtual uint32_t GetRendererID() const override { return 0; }
+
+        // Runs the fragment kernel over the viewport, for RenderCommand::DrawArrays
+        void Draw() const;
+
+        Kernel    GetKernel() const { return m_Kernel; }
+        int       GetInt(   const std::string& name, int defaultValue = 0)                     const;
+        glm::vec4 GetFloat4(const std::string& name, const glm::vec4& defaultValue = glm::vec4(0.0f)) const;
+    private:
+        void ResolveKernel();
+    private:
+        std::string m_Name;
+        Kernel      m_Kernel = Kernel::None;
+
+        std::unordered_map<std::string, int>       m_Ints;
+        std::unordered_map<std::string, glm::vec4> m_Floats;
+        std::unordered_map<std::string, glm::mat4> m_Matrices;
+    };
+};
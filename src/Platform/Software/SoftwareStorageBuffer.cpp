@@ -0,0 +1,40 @@
+#include "SoftwareStorageBuffer.h"
+#include "SoftwareContext.h"
+
+#include <cstring>
+
+namespace Donut
+{
+    SoftwareStorageBuffer::SoftwareStorageBuffer(uint32_t size, uint32_t binding)
+        : m_Data(size, 0), m_Binding(binding)
+    {
+        Bind(binding);
+    }
+
+    SoftwareStorageBuffer::~SoftwareStorageBuffer()
+    {
+        SoftwareContext::Get().Release(&m_Data);
+    }
+
+    void SoftwareStorageBuffer::SetData(const void* data, uint32_t size, uint32_t offset)
+    {
+        if (offset + size > m_Data.size())
+            Resize(offset + size);
+        std::memcpy(m_Data.data() + offset, data, size);
+    }
+
+    void SoftwareStorageBuffer::Resize(uint32_t size)
+    {
+        // Bindings reference the vector rather than its storage, so they survive the reallocation
+        m_Data.resize(size);
+    }
+
+    void SoftwareStorageBuffer::Bind(uint32_t binding)
+    {
+        if (binding >= SoftwareContext::MaxBindings)
+            return;
+
+        m_Binding = binding;
+        SoftwareContext::Get().StorageBlocks[binding] = { &m_Data, 0, 0 };
+    }
+};
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Rendering/StorageBuffer.h"
+
+#include <vector>
+
+namespace Donut
+{
+    class SoftwareStorageBuffer : public StorageBuffer
+    {
+    public:
+        SoftwareStorageBuffer(uint32_t size, uint32_t binding);
+        virtual ~SoftwareStorageBuffer();
+
+        virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) override;
+        virtual void Resize(uint32_t size)                                         override;
+        virtual void Bind(uint32_t binding)                                        override;
+
+        virtual uint32_t GetSize() const override { return static_cast<uint32_t>(m_Data.size()); }
+    private:
+        std::vector<uint8_t> m_Data;
+        uint32_t             m_Binding;
+    };
+};
@@ -0,0 +1,489 @@
+#include "SoftwareTexture.h"
+#include "SoftwareContext.h"
+
+#include "Core/Log.h"
+#include "Core/JobSystem.h"
+
+#include "stb_image.h"
+#include <glm/gtc/packing.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace Donut
+{
+    static int WrapRepeat(int i, uint32_t size)
+    {
+        int m = i % static_cast<int>(size);
+        return m < 0 ? m + static_cast<int>(size) : m;
+    }
+
+    static glm::vec3 UnpackRGB9E5(uint32_t texel)
+    {
+        float scale = std::exp2(static_cast<float>(static_cast<int>(texel >> 27) - 15 - 9));
+        return glm::vec3(static_cast<float>(texel & 0x1FF),
+                         static_cast<float>((texel >> 9) & 0x1FF),
+                         static_cast<float>((texel >> 18) & 0x1FF)) * scale;
+    }
+
+    // Inverse of the face selection in SoftwareCubemapTexture::Sample; sc and tc are in [-1, 1]
+    static glm::vec3 FaceDirection(uint32_t face, float sc, float tc)
+    {
+        switch (face)
+        {
+            case 0:  return glm::vec3( 1.0f, -tc,  -sc);
+            case 1:  return glm::vec3(-1.0f, -tc,   sc);
+            case 2:  return glm::vec3(  sc,  1.0f,  tc);
+            case 3:  return glm::vec3(  sc, -1.0f, -tc);
+            case 4:  return glm::vec3(  sc,  -tc,  1.0f);
+            default: return glm::vec3( -sc,  -tc, -1.0f);
+        }
+    }
+
+    void SoftwareImage::Resize(uint32_t width, uint32_t height)
+    {
+        Width  = width;
+        Height = height;
+        Pixels.assign(static_cast<size_t>(width) * height * 4, 0);
+    }
+
+    void SoftwareImage::Fill(const glm::vec4& color)
+    {
+        if (Pixels.empty())
+            return;
+
+        Store(0, 0, color);
+        for (size_t i = 4; i < Pixels.size(); i += 4)
+            std::memcpy(&Pixels[i], &Pixels[0], 4);
+    }
+
+    glm::vec4 SoftwareImage::Load(uint32_t x, uint32_t y) const
+    {
+        const uint8_t* pixel = &Pixels[(static_cast<size_t>(y) * Width + x) * 4];
+        return glm::vec4(pixel[0], pixel[1], pixel[2], pixel[3]) * (1.0f / 255.0f);
+    }
+
+    void SoftwareImage::Store(uint32_t x, uint32_t y, const glm::vec4& color)
+    {
+        uint8_t* pixel = &Pixels[(static_cast<size_t>(y) * Width + x) * 4];
+        for (int c = 0; c < 4; ++c)
+            pixel[c] = static_cast<uint8_t>(std::clamp(color[c], 0.0f, 1.0f) * 255.0f + 0.5f);
+    }
+
+    glm::vec4 SoftwareImage::Sample(const glm::vec2& uv) const
+    {
+        if (Width == 0 || Height == 0)
+            return glm::vec4(0.0f);
+
+        float sx = uv.x * static_cast<float>(Width)  - 0.5f;
+        float sy = uv.y * static_cast<float>(Height) - 0.5f;
+        float fx = std::floor(sx);
+        float fy = std::floor(sy);
+        float ax = sx - fx;
+        float ay = sy - fy;
+
+        uint32_t x0 = WrapRepeat(static_cast<int>(fx),     Width);
+        uint32_t x1 = WrapRepeat(static_cast<int>(fx) + 1, Width);
+        uint32_t y0 = WrapRepeat(static_cast<int>(fy),     Height);
+        uint32_t y1 = WrapRepeat(static_cast<int>(fy) + 1, Height);
+
+        glm::vec4 bottom = Load(x0, y0) * (1.0f - ax) + Load(x1, y0) * ax;
+        glm::vec4 top    = Load(x0, y1) * (1.0f - ax) + Load(x1, y1) * ax;
+        return bottom * (1.0f - ay) + top * ay;
+    }
+
+    SoftwareTexture2D::SoftwareTexture2D(uint32_t width, uint32_t height)
+    {
+        m_Image.Resize(width, height);
+        m_RendererID = SoftwareContext::Get().RegisterImage(&m_Image);
+    }
+
+    SoftwareTexture2D::SoftwareTexture2D(const std::string& path)
+        : m_Path(path)
+    {
+        m_Image.Resize(1, 1);
+        m_Image.Fill(glm::vec4(1.0f));
+        m_RendererID = SoftwareContext::Get().RegisterImage(&m_Image);
+
+        DONUT_INFO("Created default texture (image loading not available: {})", path);
+    }
+
+    SoftwareTexture2D::~SoftwareTexture2D()
+    {
+        SoftwareContext::Get().Release(&m_Image);
+    }
+
+    void SoftwareTexture2D::SetData(void* data, uint32_t size)
+    {
+        if (size != m_Image.Pixels.size())
+        {
+            DONUT_ERROR("Data must be entire texture!");
+            return;
+        }
+
+        if (data)
+            std::memcpy(m_Image.Pixels.data(), data, size);
+        else
+            std::fill(m_Image.Pixels.begin(), m_Image.Pixels.end(), uint8_t(0));
+    }
+
+    void SoftwareTexture2D::SetSubData(const void* data, uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint32_t rowLength)
+    {
+        if (x + width > m_Image.Width || y + height > m_Image.Height)
+        {
+            DONUT_ERROR("Sub-image exceeds the texture bounds!");
+            return;
+        }
+
+        size_t pitch = static_cast<size_t>(rowLength ? rowLength : width) * 4;
+        const uint8_t* source = static_cast<const uint8_t*>(data);
+        for (uint32_t row = 0; row < height; ++row)
+            std::memcpy(&m_Image.Pixels[(static_cast<size_t>(y + row) * m_Image.Width + x) * 4], source + row * pitch, width * 4);
+    }
+
+    void SoftwareTexture2D::Bind(uint32_t slot) const
+    {
+        auto& context = SoftwareContext::Get();
+        if (slot >= SoftwareContext::MaxBindings)
+            return;
+
+        context.Textures[slot] = &m_Image;
+        context.Cubemaps[slot] = nullptr;
+    }
+
+    void SoftwareTexture2D::BindAsImage(uint32_t slot, bool readOnly) const
+    {
+        if (slot >= SoftwareContext::MaxBindings)
+            return;
+
+        // Like a GL image unit, the binding is writable even though the texture handle is const
+        SoftwareContext::Get().Images[slot] = const_cast<SoftwareImage*>(&m_Image);
+    }
+
+    SoftwareCubemapTexture::SoftwareCubemapTexture(uint32_t width, uint32_t height)
+        : m_Size(width)
+    {
+        AllocateLevels();
+    }
+
+    SoftwareCubemapTexture::SoftwareCubemapTexture(const std::string& path)
+        : m_Path(path), m_Size(1024)
+    {
+        AllocateLevels();
+
+        stbi_set_flip_vertically_on_load(true);
+        int width, height, channels;
+        float* hdrData = stbi_loadf(path.c_str(), &width, &height, &channels, 3);
+        if (!hdrData)
+        {
+            DONUT_ERROR("Failed to load HDRI: {}", path);
+            for (auto& level : m_Levels)
+            {
+                for (size_t i = 0; i < level.size(); i += 3)
+                {
+                    level[i + 0] = 0.5f;
+                    level[i + 1] = 0.7f;
+                    level[i + 2] = 1.0f;
+                }
+            }
+            return;
+        }
+
+        auto image    = CreateRef<HDRIImage>();
+        image->Path   = path;
+        image->Width  = static_cast<uint32_t>(width);
+        image->Height = static_cast<uint32_t>(height);
+        image->Pixels.resize(static_cast<size_t>(width) * height * 4);
+        for (size_t i = 0; i < static_cast<size_t>(width) * height; ++i)
+        {
+            image->Pixels[i * 4 + 0] = glm::packHalf1x16(hdrData[i * 3 + 0]);
+            image->Pixels[i * 4 + 1] = glm::packHalf1x16(hdrData[i * 3 + 1]);
+            image->Pixels[i * 4 + 2] = glm::packHalf1x16(hdrData[i * 3 + 2]);
+            image->Pixels[i * 4 + 3] = glm::packHalf1x16(1.0f);
+        }
+        stbi_image_free(hdrData);
+
+        BeginUpload(image);
+        ContinueUpload(UINT32_MAX);
+
+        DONUT_INFO("Successfully loaded HDRI: {} ({}x{})", path, width, height);
+    }
+
+    SoftwareCubemapTexture::SoftwareCubemapTexture(const CubemapData& data)
+        : m_Size(data.FaceSize)
+    {
+        AllocateLevels();
+
+        const uint32_t* texels = data.Texels;
+        uint32_t levels = std::min(data.MipCount, GetMipCount());
+        for (uint32_t level = 0; level < levels; ++level)
+        {
+            std::vector<float>& rgb = m_Levels[level];
+            for (size_t i = 0; i < rgb.size() / 3; ++i)
+            {
+                glm::vec3 color = UnpackRGB9E5(texels[i]);
+                rgb[i * 3 + 0] = color.r;
+                rgb[i * 3 + 1] = color.g;
+                rgb[i * 3 + 2] = color.b;
+            }
+            texels += rgb.size() / 3;
+        }
+
+        if (levels > 0 && levels < GetMipCount())
+            GenerateMips(levels);
+    }
+
+    SoftwareCubemapTexture::~SoftwareCubemapTexture()
+    {
+        SoftwareContext::Get().Release(this);
+    }
+
+    void SoftwareCubemapTexture::AllocateLevels()
+    {
+        m_Levels.clear();
+        if (m_Size == 0)
+            return;
+
+        for (uint32_t size = m_Size; ; size >>= 1)
+        {
+            m_Levels.emplace_back(static_cast<size_t>(size) * size * 6 * 3, 0.0f);
+            if (size == 1)
+                break;
+        }
+    }
+
+    uint64_t SoftwareCubemapTexture::GetMemorySize() const
+    {
+        uint64_t total = 0;
+        for (const auto& level : m_Levels)
+            total += level.size() * sizeof(float);
+        return total;
+    }
+
+    bool SoftwareCubemapTexture::ReadPixels(uint32_t level, std::vector<float>& rgb) const
+    {
+        if (level >= m_Levels.size())
+            return false;
+
+        rgb = m_Levels[level];
+        return true;
+    }
+
+    void SoftwareCubemapTexture::BeginUpload(const Ref<HDRIImage>& image)
+    {
+        m_UploadImage.reset();
+        m_ConvertedRows = 0;
+        if (!image || image->Width == 0 || image->Height == 0 || m_Levels.empty())
+            return;
+
+        m_Path        = image->Path;
+        m_UploadImage = image;
+    }
+
+    bool SoftwareCubemapTexture::ContinueUpload(uint32_t byteBudget)
+    {
+        if (!m_UploadImage)
+            return true;
+
+        uint32_t totalRows = m_Size * 6;
+        uint32_t rowBytes  = m_Size * 3 * sizeof(float);
+        if (m_ConvertedRows < totalRows)
+        {
+            uint32_t rows = std::clamp(byteBudget / rowBytes, 1u, totalRows - m_ConvertedRows);
+            ConvertFaceRows(m_ConvertedRows, rows);
+            m_ConvertedRows += rows;
+            if (m_ConvertedRows < totalRows)
+                return false;
+        }
+
+        GenerateMips(1);
+        m_UploadImage.reset();
+        m_ConvertedRows = 0;
+        return true;
+    }
+
+    float SoftwareCubemapTexture::GetUploadProgress() const
+    {
+        if (!m_UploadImage)
+            return 1.0f;
+
+        return static_cast<float>(m_ConvertedRows) / static_cast<float>(m_Size * 6 + 1);
+    }
+
+    void SoftwareCubemapTexture::ConvertFaceRows(uint32_t firstRow, uint32_t rowCount)
+    {
+        std::vector<float>& faces = m_Levels[0];
+        JobSystem::ParallelFor(rowCount, 16, [&](uint32_t begin, uint32_t end)
+        {
+            for (uint32_t r = firstRow + begin; r < firstRow + end; ++r)
+            {
+                uint32_t face = r / m_Size;
+                uint32_t j    = r % m_Size;
+                float    tc   = 2.0f * (static_cast<float>(j) + 0.5f) / static_cast<float>(m_Size) - 1.0f;
+
+                float* row = &faces[static_cast<size_t>(r) * m_Size * 3];
+                for (uint32_t i = 0; i < m_Size; ++i)
+                {
+                    float     sc    = 2.0f * (static_cast<float>(i) + 0.5f) / static_cast<float>(m_Size) - 1.0f;
+                    glm::vec3 color = SampleEquirect(glm::normalize(FaceDirection(face, sc, tc)));
+                    row[i * 3 + 0] = color.r;
+                    row[i * 3 + 1] = color.g;
+                    row[i * 3 + 2] = color.b;
+                }
+            }
+        });
+    }
+
+    // Same mapping as EquirectToCubemap.glsl, bilinear with clamped edges
+    glm::vec3 SoftwareCubemapTexture::SampleEquirect(const glm::vec3& direction) const
+    {
+        const HDRIImage& image = *m_UploadImage;
+
+        float u = std::atan2(direction.z, direction.x) * 0.1591f + 0.5f;
+        float v = std::asin(std::clamp(direction.y, -1.0f, 1.0f)) * 0.3183f + 0.5f;
+
+        float sx = std::clamp(u * static_cast<float>(image.Width)  - 0.5f, 0.0f, static_cast<float>(image.Width  - 1));
+        float sy = std::clamp(v * static_cast<float>(image.Height) - 0.5f, 0.0f, static_cast<float>(image.Height - 1));
+        uint32_t x0 = static_cast<uint32_t>(sx);
+        uint32_t y0 = static_cast<uint32_t>(sy);
+        uint32_t x1 = std::min(x0 + 1, image.Width  - 1);
+        uint32_t y1 = std::min(y0 + 1, image.Height - 1);
+        float    ax = sx - static_cast<float>(x0);
+        float    ay = sy - static_cast<float>(y0);
+
+        auto load = [&](uint32_t x, uint32_t y)
+        {
+            const uint16_t* pixel = &image.Pixels[(static_cast<size_t>(y) * image.Width + x) * 4];
+            return glm::vec3(glm::unpackHalf1x16(pixel[0]), glm::unpackHalf1x16(pixel[1]), glm::unpackHalf1x16(pixel[2]));
+        };
+
+        glm::vec3 bottom = load(x0, y0) * (1.0f - ax) + load(x1, y0) * ax;
+        glm::vec3 top    = load(x0, y1) * (1.0f - ax) + load(x1, y1) * ax;
+        return bottom * (1.0f - ay) + top * ay;
+    }
+
+    void SoftwareCubemapTexture::GenerateMips(uint32_t firstLevel)
+    {
+        for (uint32_t level = std::max(firstLevel, 1u); level < m_Levels.size(); ++level)
+        {
+            uint32_t sourceSize = std::max(m_Size >> (level - 1), 1u);
+            uint32_t size       = std::max(m_Size >> level, 1u);
+            const std::vector<float>& source = m_Levels[level - 1];
+            std::vector<float>&       target = m_Levels[level];
+
+            for (uint32_t face = 0; face < 6; ++face)
+            {
+                const float* sourceFace = &source[static_cast<size_t>(face) * sourceSize * sourceSize * 3];
+                float*       targetFace = &target[static_cast<size_t>(face) * size * size * 3];
+                for (uint32_t y = 0; y < size; ++y)
+                {
+                    for (uint32_t x = 0; x < size; ++x)
+                    {
+                        uint32_t x0 = std::min(x * 2, sourceSize - 1), x1 = std::min(x * 2 + 1, sourceSize - 1);
+                        uint32_t y0 = std::min(y * 2, sourceSize - 1), y1 = std::min(y * 2 + 1, sourceSize - 1);
+                        for (uint32_t c = 0; c < 3; ++c)
+                        {
+                            targetFace[(y * size + x) * 3 + c] = 0.25f * (sourceFace[(y0 * sourceSize + x0) * 3 + c] +
+                                                                          sourceFace[(y0 * sourceSize + x1) * 3 + c] +
+                                                                          sourceFace[(y1 * sourceSize + x0) * 3 + c] +
+                                                                          sourceFace[(y1 * sourceSize + x1) * 3 + c]);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    glm::vec3 SoftwareCubemapTexture::Sample(const glm::vec3& direction, float lod) const
+    {
+        if (m_Levels.empty())
+            return glm::vec3(0.0f);
+
+        // Major axis selection from the GL spec's cube map table
+        glm::vec3 a = glm::abs(direction);
+        uint32_t  face;
+        float     sc, tc, ma;
+        if (a.x >= a.y && a.x >= a.z)
+        {
+            ma   = a.x;
+            face = direction.x >= 0.0f ? 0 : 1;
+            sc   = direction.x >= 0.0f ? -direction.z : direction.z;
+            tc   = -direction.y;
+        }
+        else if (a.y >= a.z)
+        {
+            ma   = a.y;
+            face = direction.y >= 0.0f ? 2 : 3;
+            sc   = direction.x;
+            tc   = direction.y >= 0.0f ? direction.z : -direction.z;
+        }
+        else
+        {
+            ma   = a.z;
+            face = direction.z >= 0.0f ? 4 : 5;
+            sc   = direction.z >= 0.0f ? direction.x : -direction.x;
+            tc   = -direction.y;
+        }
+
+        if (ma <= 0.0f)
+            return glm::vec3(0.0f);
+
+        float s = 0.5f * (sc / ma + 1.0f);
+        float t = 0.5f * (tc / ma + 1.0f);
+
+        lod = std::clamp(lod, 0.0f, static_cast<float>(m_Levels.size() - 1));
+        uint32_t  level = static_cast<uint32_t>(lod);
+        float     blend = lod - static_cast<float>(level);
+        glm::vec3 color = SampleLevel(level, face, s, t);
+        if (blend > 0.0f && level + 1 < m_Levels.size())
+            color = color * (1.0f - blend) + SampleLevel(level + 1, face, s, t) * blend;
+
+        return color;
+    }
+
+    glm::vec3 SoftwareCubemapTexture::SampleLevel(uint32_t level, uint32_t face, float s, float t) const
+    {
+        uint32_t size = std::max(m_Size >> level, 1u);
+        const float* texels = &m_Levels[level][static_cast<size_t>(face) * size * size * 3];
+
+        float sx = std::clamp(s * static_cast<float>(size) - 0.5f, 0.0f, static_cast<float>(size - 1));
+        float sy = std::clamp(t * static_cast<float>(size) - 0.5f, 0.0f, static_cast<float>(size - 1));
+        uint32_t x0 = static_cast<uint32_t>(sx);
+        uint32_t y0 = static_cast<uint32_t>(sy);
+        uint32_t x1 = std::min(x0 + 1, size - 1);
+        uint32_t y1 = std::min(y0 + 1, size - 1);
+        float    ax = sx - static_cast<float>(x0);
+        float    ay = sy - static_cast<float>(y0);
+
+        auto load = [&](uint32_t x, uint32_t y)
+        {
+            const float* texel = &texels[(static_cast<size_t>(y) * size + x) * 3];
+            return glm::vec3(texel[0], texel[1], texel[2]);
+        };
+
+        glm::vec3 bottom = load(x0, y0) * (1.0f - ax) + load(x1, y0) * ax;
+        glm::vec3 top    = load(x0, y1) * (1.0f - ax) + load(x1, y1) * ax;
+        return bottom * (1.0f - ay) + top * ay;
+    }
+
+    void SoftwareCubemapTexture::SetData(void* data, uint32_t size)
+    {
+        DONUT_WARN("SetData not implemented for cubemaps");
+    }
+
+    void SoftwareCubemapTexture::Bind(uint32_t slot) const
+    {
+        auto& context = SoftwareContext::Get();
+        if (slot >= SoftwareContext::MaxBindings)
+            return;
+
+        context.Cubemaps[slot] = this;
+        context.Textures[slot] = nullptr;
+    }
+
+    void SoftwareCubemapTexture::BindAsImage(uint32_t slot, bool readOnly) const
+    {
+        DONUT_WARN("Cubemaps cannot be bound as images by the software renderer");
+    }
+};
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "Rendering/Texture.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Donut
+{
+    // RGBA8 image with the bottom row first, the layout GL uses for textures and readbacks
+    struct SoftwareImage
+    {
+        uint32_t             Width  = 0;
+        uint32_t             Height = 0;
+        std::vector<uint8_t> Pixels;
+
+        void Resize(uint32_t width, uint32_t height);
+        void Fill(const glm::vec4& color);
+
+        glm::vec4 Load(uint32_t x, uint32_t y) const;
+        void      Store(uint32_t x, uint32_t y, const glm::vec4& color);
+
+        // Bilinear with repeat wrapping, matching the GL sampler state of Texture2D
+        glm::vec4 Sample(const glm::vec2& uv) const;
+    };
+
+    class SoftwareTexture2D
+        : public Texture2D
+    {
+    public:
+        SoftwareTexture2D(uint32_t width, uint32_t height);
+        SoftwareTexture2D(const std::string& path);
+        virtual ~SoftwareTexture2D();
+
+        virtual uint32_t GetWidth()      const override { return m_Image.Width;  }
+        virtual uint32_t GetHeight()     const override { return m_Image.Height; }
+        virtual uint32_t GetRendererID() const override { return m_RendererID;   }
+
+        virtual void SetData(void* data, uint32_t size) override;
+        virtual void SetSubData(const void* data, uint32_t x, uint32_t y,
+                                uint32_t width, uint32_t height, uint32_t rowLength = 0) override;
+        virtual void Bind(uint32_t slot = 0) const override;
+        virtual void BindAsImage(uint32_t slot = 0, bool readOnly = false) const override;
+
+        virtual bool operator==(const Texture& other) const override
+        {
+            return m_RendererID == other.GetRendererID();
+        }
+
+        const SoftwareImage& GetImage() const { return m_Image; }
+    private:
+        std::string   m_Path;
+        SoftwareImage m_Image;
+        uint32_t      m_RendererID = 0;
+    };
+
+    // RGB float faces, level-major like CubemapTexture::ReadPixels, with the mip chain
+    // built on the CPU. Sampling follows GL's face selection with trilinear filtering.
+    class SoftwareCubemapTexture
+        : public CubemapTexture
+    {
+    public:
+        SoftwareCubemapTexture(uint32_t width, uint32_t height);
+        SoftwareCubemapTexture(const std::string& path);
+        SoftwareCubemapTexture(const CubemapData& data);
+        virtual ~SoftwareCubemapTexture();
+
+        virtual uint32_t GetWidth()      const override { return m_Size; }
+        virtual uint32_t GetHeight()     const override { return m_Size; }
+        virtual uint32_t GetRendererID() const override { return 0;      }
+
+        virtual void SetData(void* data, uint32_t size)                          override;
+        virtual void Bind(uint32_t slot = 0)                               const override;
+        virtual void BindAsImage(uint32_t slot = 0, bool readOnly = false) const override;
+
+        virtual uint32_t GetMipCount()   const override { return static_cast<uint32_t>(m_Levels.size()); }
+        virtual uint64_t GetMemorySize() const override;
+        virtual bool     ReadPixels(uint32_t level, std::vector<float>& rgb) const override;
+
+        virtual void  BeginUpload(const Ref<HDRIImage>& image) override;
+        virtual bool  ContinueUpload(uint32_t byteBudget)      override;
+        virtual float GetUploadProgress() const                override;
+
+        virtual bool operator==(const Texture& other) const override
+        {
+            return this == &other;
+        }
+
+        glm::vec3 Sample(const glm::vec3& direction, float lod) const;
+    private:
+        void AllocateLevels();
+        void ConvertFaceRows(uint32_t firstRow, uint32_t rowCount);
+        void GenerateMips(uint32_t firstLevel);
+        glm::vec3 SampleLevel(uint32_t level, uint32_t face, float s, float t) const;
+        glm::vec3 SampleEquirect(const glm::vec3& direction) const;
+    private:
+        std::string m_Path;
+        uint32_t    m_Size = 0;
+
+        std::vector<std::vector<float>> m_Levels;
+
+        // Equirectangular source while an upload is converting it into the faces
+        Ref<HDRIImage> m_UploadImage;
+        uint32_t       m_ConvertedRows = 0;
+    };
+};
@@ -0,0 +1,36 @@
+#include "SoftwareUniformBuffer.h"
+#include "SoftwareContext.h"
+#include "Core/Log.h"
+
+#include <cstring>
+
+namespace Donut
+{
+    SoftwareUniformBuffer::SoftwareUniformBuffer(uint32_t size, uint32_t binding)
+        : m_Data(size, 0)
+    {
+        Bind(binding);
+    }
+
+    SoftwareUniformBuffer::~SoftwareUniformBuffer()
+    {
+        SoftwareContext::Get().Release(&m_Data);
+    }
+
+    void SoftwareUniformBuffer::SetData(const void* data, uint32_t size, uint32_t offset)
+    {
+        if (offset + size > m_Data.size())
+        {
+            DONUT_ERROR("Uniform buffer write exceeds its size ({} bytes at offset {})", size, offset);
+            return;
+        }
+
+        std::memcpy(m_Data.data() + offset, data, size);
+    }
+
+    void SoftwareUniformBuffer::Bind(uint32_t binding)
+    {
+        if (binding < SoftwareContext::MaxBindings)
+            SoftwareContext::Get().UniformBlocks[binding] = { &m_Data, 0, 0 };
+    }
+};
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Rendering/UniformBuffer.h"
+
+#include <vector>
+
+namespace Donut
+{
+    class SoftwareUniformBuffer : public UniformBuffer
+    {
+    public:
+        SoftwareUniformBuffer(uint32_t size, uint32_t binding);
+        virtual ~SoftwareUniformBuffer();
+
+        virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) override;
+        virtual void Bind(uint32_t binding)                                        override;
+    private:
+        std::vector<uint8_t> m_Data;
+    };
+};
@@ -0,0 +1,70 @@
+#include "SoftwareUniformRingBuffer.h"
+#include "SoftwareContext.h"
+#include "Core/Log.h"
+
+#include <cstring>
+
+namespace Donut
+{
+    // std140 blocks only need 16-byte alignment when they are plain structs in memory
+    static constexpr uint32_t s_Alignment = 16;
+
+    static uint32_t AlignUp(uint32_t value, uint32_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    SoftwareUniformRingBuffer::SoftwareUniformRingBuffer(uint32_t frameSize, uint32_t framesInFlight)
+        : m_FrameSize(AlignUp(frameSize, s_Alignment)), m_FramesInFlight(framesInFlight)
+    {
+        m_Data.resize(static_cast<size_t>(m_FrameSize) * m_FramesInFlight);
+    }
+
+    SoftwareUniformRingBuffer::~SoftwareUniformRingBuffer()
+    {
+        SoftwareContext::Get().Release(&m_Data);
+    }
+
+    void SoftwareUniformRingBuffer::BeginFrame()
+    {
+        m_FrameIndex++;
+        m_Head = static_cast<uint32_t>(m_FrameIndex % m_FramesInFlight) * m_FrameSize;
+    }
+
+    void SoftwareUniformRingBuffer::EndFrame()
+    {
+    }
+
+    UniformRingBuffer::Allocation SoftwareUniformRingBuffer::Upload(const void* data, uint32_t size)
+    {
+        uint32_t segmentEnd = (static_cast<uint32_t>(m_FrameIndex % m_FramesInFlight) + 1) * m_FrameSize;
+        if (m_Head + size > segmentEnd)
+        {
+            DONUT_ERROR("Uniform ring buffer segment exhausted ({} bytes requested)", size);
+            return {};
+        }
+
+        Allocation alloc;
+        alloc.Offset = m_Head;
+        alloc.Size   = size;
+        alloc.Frame  = m_FrameIndex;
+
+        std::memcpy(m_Data.data() + m_Head, data, size);
+        m_Head = AlignUp(m_Head + size, s_Alignment);
+
+        return alloc;
+    }
+
+    void SoftwareUniformRingBuffer::BindRange(uint32_t binding, const Allocation& alloc)
+    {
+        if (alloc.Size == 0 || binding >= SoftwareContext::MaxBindings)
+            return;
+
+        SoftwareContext::Get().UniformBlocks[binding] = { &m_Data, alloc.Offset, alloc.Size };
+    }
+
+    bool SoftwareUniformRingBuffer::IsResident(const Allocation& alloc) const
+    {
+        return alloc.Size > 0 && m_FrameIndex - alloc.Frame < m_FramesInFlight;
+    }
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Rendering/UniformRingBuffer.h"
+
+#include <vector>
+
+namespace Donut
+{
+    // Dispatches finish before they return, so there are no fences: a segment is
+    // free again as soon as its frame has been submitted
+    class SoftwareUniformRingBuffer : public UniformRingBuffer
+    {
+    public:
+        SoftwareUniformRingBuffer(uint32_t frameSize, uint32_t framesInFlight);
+        virtual ~SoftwareUniformRingBuffer();
+
+        virtual void BeginFrame() override;
+        virtual void EndFrame()   override;
+
+        virtual Allocation Upload(const void* data, uint32_t size)            override;
+        virtual void       BindRange(uint32_t binding, const Allocation& alloc) override;
+        virtual bool       IsResident(const Allocation& alloc)            const override;
+    private:
+        std::vector<uint8_t> m_Data;
+        uint32_t             m_FrameSize      = 0;
+        uint32_t             m_FramesInFlight = 0;
+        uint32_t             m_Head           = 0;
+        uint64_t             m_FrameIndex     = 0;
+    };
+};
@@ -0,0 +1,14 @@
+#include "SoftwareVertexArray.h"
+
+namespace Donut
+{
+    void SoftwareVertexArray::AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer)
+    {
+        m_VertexBuffers.push_back(vertexBuffer);
+    }
+
+    void SoftwareVertexArray::SetIndexBuffer(const Ref<IndexBuffer>& indexBuffer)
+    {
+        m_IndexBuffer = indexBuffer;
+    }
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Core/Memory.h"
+
+#include "Rendering/VertexArray.h"
+#include "Rendering/VertexBuffer.h"
+#include "Rendering/IndexBuffer.h"
+
+#include <vector>
+
+namespace Donut
+{
+    class SoftwareVertexArray 
+        : public VertexArray 
+    {
+    public:
+        SoftwareVertexArray()          = default;
+        virtual ~SoftwareVertexArray() = default;
+
+        virtual void Bind()   const override {}
+        virtual void Unbind() const override {}
+
+        virtual void AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer) override;
+        virtual void SetIndexBuffer(const Ref<IndexBuffer>& indexBuffer)    override;
+
+        virtual const std::vector<Ref<VertexBuffer>>& GetVertexBuffers() const override 
+        { 
+            return m_VertexBuffers; 
+        }
+        
+        virtual const Ref<IndexBuffer>& GetIndexBuffer() const override 
+        { 
+            return m_IndexBuffer; 
+        }
+    private:
+        std::vector<Ref<VertexBuffer>> m_VertexBuffers;
+        Ref<IndexBuffer>               m_IndexBuffer;
+    };
+};
@@ -0,0 +1,23 @@
+#include "SoftwareVertexBuffer.h"
+
+#include <cstring>
+
+namespace Donut
+{
+    SoftwareVertexBuffer::SoftwareVertexBuffer(uint32_t size)
+        : m_Data(size, 0)
+    {
+    }
+
+    SoftwareVertexBuffer::SoftwareVertexBuffer(const void* data, uint32_t size)
+        : m_Data(static_cast<const uint8_t*>(data), static_cast<const uint8_t*>(data) + size)
+    {
+    }
+
+    void SoftwareVertexBuffer::SetData(const void* data, uint32_t size)
+    {
+        if (size > m_Data.size())
+            m_Data.resize(size);
+        std::memcpy(m_Data.data(), data, size);
+    }
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Rendering/VertexBuffer.h"
+
+#include <vector>
+
+namespace Donut
+{
+    // Vertex data is kept for completeness only; the software renderer draws its
+    // fullscreen passes procedurally and does not rasterise meshes
+    class SoftwareVertexBuffer
+        : public VertexBuffer 
+    {
+    public:
+        SoftwareVertexBuffer(uint32_t size);
+        SoftwareVertexBuffer(const void* data, uint32_t size);
+        virtual ~SoftwareVertexBuffer() = default;
+
+        virtual void Bind()                             const override {}
+        virtual void Unbind()                           const override {}
+        virtual void SetData(const void* data, uint32_t size) override;
+
+        virtual const VertexBufferLayout& GetLayout()      const override { return m_Layout;   }
+        virtual void SetLayout(const VertexBufferLayout& layout) override { m_Layout = layout; }
+
+    private:
+        std::vector<uint8_t> m_Data;
+        VertexBufferLayout   m_Layout;
+    };
+};
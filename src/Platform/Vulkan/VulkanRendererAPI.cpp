@@ -52,6 +52,11 @@ namespace Donut
         // TODO(Hachem): Implement Vulkan indexed drawing
     }
 
+    void VulkanRendererAPI::DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t instanceCount, uint32_t indexCount)
+    {
+        // TODO(Hachem): Implement Vulkan instanced indexed drawing
+    }
+
     void VulkanRendererAPI::DrawArrays(uint32_t vertexCount, uint32_t first)
     {
         // TODO(Hachem): Implement Vulkan array drawing
@@ -83,4 +88,9 @@ namespace Donut
         // 3. Mapping the staging buffer and copying to the pixels array
         // 4. Unmapping and destroying the staging buffer
     }
+
+    void VulkanRendererAPI::Present()
+    {
+        // TODO(Hachem): Implement Vulkan presentation
+    }
 };
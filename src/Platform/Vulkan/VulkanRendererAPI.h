@@ -22,6 +22,9 @@ namespace Donut
 
         virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, 
                                  uint32_t indexCount = 0)         override;
+        virtual void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray,
+                                          uint32_t instanceCount,
+                                          uint32_t indexCount = 0) override;
         
         virtual void DrawArrays(uint32_t vertexCount, 
                                 uint32_t first = 0)               override;
@@ -34,5 +37,6 @@ namespace Donut
                                       bool readOnly = false)      override;
         virtual void ReadPixels(uint32_t x, uint32_t y, uint32_t width, uint32_t height, 
                                 uint32_t format, uint32_t type, void* pixels) override;
+        virtual void Present()                                    override;
     };
 };
@@ -0,0 +1,31 @@
+#include "VulkanStorageBuffer.h"
+
+namespace Donut
+{
+    VulkanStorageBuffer::VulkanStorageBuffer(uint32_t size, uint32_t binding)
+        : m_Size(size), m_Binding(binding)
+    {
+        // TODO: Implement Vulkan storage buffer
+    }
+
+    VulkanStorageBuffer::~VulkanStorageBuffer()
+    {
+        // TODO: Implement Vulkan storage buffer cleanup
+    }
+
+    void VulkanStorageBuffer::SetData(const void* data, uint32_t size, uint32_t offset)
+    {
+        // TODO: Implement Vulkan storage buffer data setting
+    }
+
+    void VulkanStorageBuffer::Resize(uint32_t size)
+    {
+        m_Size = size;
+        // TODO: Implement Vulkan storage buffer reallocation
+    }
+
+    void VulkanStorageBuffer::Bind(uint32_t binding)
+    {
+        // TODO: Implement Vulkan storage buffer binding
+    }
+};
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "Rendering/StorageBuffer.h"
+
+namespace Donut
+{
+    class VulkanStorageBuffer : public StorageBuffer
+    {
+    public:
+        VulkanStorageBuffer(uint32_t size, uint32_t binding);
+        virtual ~VulkanStorageBuffer();
+
+        virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) override;
+        virtual void Resize(uint32_t size)                                         override;
+        virtual void Bind(uint32_t binding)                                        override;
+
+        virtual uint32_t GetSize() const override { return m_Size; }
+    private:
+        uint32_t m_Size;
+        uint32_t m_Binding;
+    };
+};
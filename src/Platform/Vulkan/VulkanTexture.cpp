@@ -28,6 +28,11 @@ namespace Donut
 	{
 	}
 
+	void VulkanTexture2D::SetSubData(const void* data, uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint32_t rowLength)
+	{
+		// TODO(Hachem): Implement Vulkan texture sub-image upload
+	}
+
 	void VulkanTexture2D::Bind(uint32_t slot) const
 	{
 	}
@@ -55,6 +60,15 @@ namespace Donut
 		m_RendererID = 0;
 	}
 
+	VulkanCubemapTexture::VulkanCubemapTexture(const CubemapData& data)
+		: m_Width(data.FaceSize), m_Height(data.FaceSize)
+	{
+		// TODO: Implement Vulkan cubemap upload from cached data
+		m_InternalFormat = 0;
+		m_DataFormat = 0;
+		m_RendererID = 0;
+	}
+
 	VulkanCubemapTexture::~VulkanCubemapTexture()
 	{
 	}
@@ -70,4 +84,19 @@ namespace Donut
 	void VulkanCubemapTexture::BindAsImage(uint32_t slot, bool readOnly) const
 	{
 	}
+
+	bool VulkanCubemapTexture::ReadPixels(uint32_t level, std::vector<float>& rgb) const
+	{
+		return false;
+	}
+
+	void VulkanCubemapTexture::BeginUpload(const Ref<HDRIImage>& image)
+	{
+		// TODO: Implement Vulkan staged cubemap upload
+	}
+
+	bool VulkanCubemapTexture::ContinueUpload(uint32_t byteBudget)
+	{
+		return true;
+	}
 };
@@ -17,6 +17,8 @@ namespace Donut
 		virtual uint32_t GetRendererID() const override { return m_RendererID; }
 
 		virtual void SetData(void* data, uint32_t size) override;
+		virtual void SetSubData(const void* data, uint32_t x, uint32_t y,
+		                        uint32_t width, uint32_t height, uint32_t rowLength = 0) override;
 		virtual void Bind(uint32_t slot = 0) const override;
 		virtual void BindAsImage(uint32_t slot = 0, bool readOnly = false) const override;
 
@@ -37,6 +39,7 @@ namespace Donut
 	public:
 		VulkanCubemapTexture(uint32_t width, uint32_t height);
 		VulkanCubemapTexture(const std::string& path);
+		VulkanCubemapTexture(const CubemapData& data);
 		virtual ~VulkanCubemapTexture();
 
 		virtual uint32_t GetWidth()      const override { return m_Width;      }
@@ -47,6 +50,14 @@ namespace Donut
 		virtual void Bind(uint32_t slot = 0)                               const override;
 		virtual void BindAsImage(uint32_t slot = 0, bool readOnly = false) const override;
 
+		virtual uint32_t GetMipCount()   const override { return 1; }
+		virtual uint64_t GetMemorySize() const override { return 0; }
+		virtual bool     ReadPixels(uint32_t level, std::vector<float>& rgb) const override;
+
+		virtual void  BeginUpload(const Ref<HDRIImage>& image) override;
+		virtual bool  ContinueUpload(uint32_t byteBudget)      override;
+		virtual float GetUploadProgress() const                override { return 1.0f; }
+
 		virtual bool operator==(const Texture& other) const override
 		{
 			return m_RendererID == ((VulkanCubemapTexture&)other).m_RendererID;
@@ -0,0 +1,41 @@
+#include "VulkanUniformRingBuffer.h"
+
+namespace Donut
+{
+    VulkanUniformRingBuffer::VulkanUniformRingBuffer(uint32_t frameSize, uint32_t framesInFlight)
+        : m_FrameSize(frameSize), m_FramesInFlight(framesInFlight)
+    {
+        // TODO: Implement Vulkan uniform ring buffer
+    }
+
+    VulkanUniformRingBuffer::~VulkanUniformRingBuffer()
+    {
+        // TODO: Implement Vulkan uniform ring buffer cleanup
+    }
+
+    void VulkanUniformRingBuffer::BeginFrame()
+    {
+        // TODO: Implement Vulkan uniform ring buffer frame begin
+    }
+
+    void VulkanUniformRingBuffer::EndFrame()
+    {
+        // TODO: Implement Vulkan uniform ring buffer frame end
+    }
+
+    UniformRingBuffer::Allocation VulkanUniformRingBuffer::Upload(const void* data, uint32_t size)
+    {
+        // TODO: Implement Vulkan uniform ring buffer upload
+        return {};
+    }
+
+    void VulkanUniformRingBuffer::BindRange(uint32_t binding, const Allocation& alloc)
+    {
+        // TODO: Implement Vulkan uniform ring buffer binding
+    }
+
+    bool VulkanUniformRingBuffer::IsResident(const Allocation& alloc) const
+    {
+        return false;
+    }
+};
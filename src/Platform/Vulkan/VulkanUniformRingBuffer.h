@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Rendering/UniformRingBuffer.h"
+
+namespace Donut
+{
+    class VulkanUniformRingBuffer : public UniformRingBuffer
+    {
+    public:
+        VulkanUniformRingBuffer(uint32_t frameSize, uint32_t framesInFlight);
+        virtual ~VulkanUniformRingBuffer();
+
+        virtual void BeginFrame() override;
+        virtual void EndFrame()   override;
+
+        virtual Allocation Upload(const void* data, uint32_t size)            override;
+        virtual void       BindRange(uint32_t binding, const Allocation& alloc) override;
+        virtual bool       IsResident(const Allocation& alloc)            const override;
+    private:
+        uint32_t m_FrameSize;
+        uint32_t m_FramesInFlight;
+    };
+};
@@ -0,0 +1,335 @@
+#include "AssetRegistry.h"
+
+#include "Core/Log.h"
+#include "Rendering/VertexBuffer.h"
+#include "Rendering/IndexBuffer.h"
+
+#include <cmath>
+#include <fstream>
+#include <numbers>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
+namespace Donut
+{
+    namespace
+    {
+        struct RegistryData
+        {
+            std::unordered_map<std::string, Ref<Shader>>      Shaders;
+            std::unordered_map<std::string, Ref<Texture2D>>   Textures;
+            std::unordered_map<std::string, Ref<VertexArray>> Meshes;
+        };
+
+        Scope<RegistryData> s_Data;
+
+        RegistryData& Data()
+        {
+            // Lazily created so assets can be requested before Init() runs
+            if (!s_Data)
+                s_Data = CreateScope<RegistryData>();
+            return *s_Data;
+        }
+
+        Ref<VertexArray> BuildUVSphere(uint32_t segments, uint32_t rings)
+        {
+            std::vector<float>    vertices;
+            std::vector<uint32_t> indices;
+
+            for (uint32_t ring = 0; ring <= rings; ++ring)
+            {
+                float phi    = static_cast<float>(std::numbers::pi) * ring / rings;
+                float sinPhi = std::sin(phi);
+                float cosPhi = std::cos(phi);
+
+                for (uint32_t segment = 0; segment <= segments; ++segment)
+                {
+                    float theta = 2.0f * static_cast<float>(std::numbers::pi) * segment / segments;
+
+                    float x = std::cos(theta) * sinPhi;
+                    float y = cosPhi;
+                    float z = std::sin(theta) * sinPhi;
+
+                    // Unit sphere, so the normal is the position
+                    vertices.insert(vertices.end(), { x, y, z, x, y, z });
+                }
+            }
+
+            for (uint32_t ring = 0; ring < rings; ++ring)
+            {
+                for (uint32_t segment = 0; segment < segments; ++segment)
+                {
+                    uint32_t first  = ring * (segments + 1) + segment;
+                    uint32_t second = first + segments + 1;
+
+                    indices.insert(indices.end(), { first, second, first + 1, second, second + 1, first + 1 });
+                }
+            }
+
+            auto vertexBuffer = Ref<VertexBuffer>(VertexBuffer::Create(vertices.data(), static_cast<uint32_t>(vertices.size() * sizeof(float))));
+            VertexBufferLayout layout;
+            layout.Push<float>(3);
+            layout.Push<float>(3);
+            vertexBuffer->SetLayout(layout);
+
+            auto indexBuffer = Ref<IndexBuffer>(IndexBuffer::Create(indices.data(), static_cast<uint32_t>(indices.size())));
+
+            auto vertexArray = Ref<VertexArray>(VertexArray::Create());
+            vertexArray->AddVertexBuffer(vertexBuffer);
+            vertexArray->SetIndexBuffer(indexBuffer);
+            return vertexArray;
+        }
+
+        Ref<VertexArray> BuildGridLines(float extent, uint32_t lines)
+        {
+            const float halfSize = extent * 0.5f;
+            const float step     = extent / (lines - 1);
+
+            std::vector<float>    vertices;
+            std::vector<uint32_t> indices;
+
+            for (uint32_t i = 0; i < lines; ++i)
+            {
+                float z = -halfSize + i * step;
+                vertices.insert(vertices.end(), { -halfSize, 0.0f, z, halfSize, 0.0f, z });
+
+                uint32_t baseIndex = static_cast<uint32_t>(vertices.size() / 3) - 2;
+                indices.insert(indices.end(), { baseIndex, baseIndex + 1 });
+            }
+
+            for (uint32_t i = 0; i < lines; ++i)
+            {
+                float x = -halfSize + i * step;
+                vertices.insert(vertices.end(), { x, 0.0f, -halfSize, x, 0.0f, halfSize });
+
+                uint32_t baseIndex = static_cast<uint32_t>(vertices.size() / 3) - 2;
+                indices.insert(indices.end(), { baseIndex, baseIndex + 1 });
+            }
+
+            auto vertexBuffer = Ref<VertexBuffer>(VertexBuffer::Create(vertices.data(), static_cast<uint32_t>(vertices.size() * sizeof(float))));
+            VertexBufferLayout layout;
+            layout.Push<float>(3);
+            vertexBuffer->SetLayout(layout);
+
+            auto indexBuffer = Ref<IndexBuffer>(IndexBuffer::Create(indices.data(), static_cast<uint32_t>(indices.size())));
+
+            auto vertexArray = Ref<VertexArray>(VertexArray::Create());
+            vertexArray->AddVertexBuffer(vertexBuffer);
+            vertexArray->SetIndexBuffer(indexBuffer);
+            vertexArray->Unbind();
+            return vertexArray;
+        }
+
+        Ref<VertexArray> BuildSkyboxCube()
+        {
+            float vertices[] = 
+            {
+                -1.0f,  1.0f, -1.0f,  -1.0f, -1.0f, -1.0f,   1.0f, -1.0f, -1.0f,   1.0f, -1.0f, -1.0f,   1.0f,  1.0f, -1.0f,  -1.0f,  1.0f, -1.0f,
+                -1.0f, -1.0f,  1.0f,  -1.0f, -1.0f, -1.0f,  -1.0f,  1.0f, -1.0f,  -1.0f,  1.0f, -1.0f,  -1.0f,  1.0f,  1.0f,  -1.0f, -1.0f,  1.0f,
+                 1.0f, -1.0f, -1.0f,   1.0f, -1.0f,  1.0f,   1.0f,  1.0f,  1.0f,   1.0f,  1.0f,  1.0f,   1.0f,  1.0f, -1.0f,   1.0f, -1.0f, -1.0f,
+                -1.0f, -1.0f,  1.0f,  -1.0f,  1.0f,  1.0f,   1.0f,  1.0f,  1.0f,   1.0f,  1.0f,  1.0f,   1.0f, -1.0f,  1.0f,  -1.0f, -1.0f,  1.0f,
+                -1.0f,  1.0f, -1.0f,   1.0f,  1.0f, -1.0f,   1.0f,  1.0f,  1.0f,   1.0f,  1.0f,  1.0f,  -1.0f,  1.0f,  1.0f,  -1.0f,  1.0f, -1.0f,
+                -1.0f, -1.0f, -1.0f,  -1.0f, -1.0f,  1.0f,   1.0f, -1.0f, -1.0f,   1.0f, -1.0f, -1.0f,  -1.0f, -1.0f,  1.0f,   1.0f, -1.0f,  1.0f
+            };
+
+            auto vertexBuffer = Ref<VertexBuffer>(VertexBuffer::Create(vertices, sizeof(vertices)));
+            VertexBufferLayout layout;
+            layout.Push<float>(3);
+            vertexBuffer->SetLayout(layout);
+
+            auto vertexArray = Ref<VertexArray>(VertexArray::Create());
+            vertexArray->AddVertexBuffer(vertexBuffer);
+            return vertexArray;
+        }
+
+        Ref<VertexArray> BuildFullscreenQuad()
+        {
+            float vertices[] = 
+            {
+                // Positions   // TexCoords
+                -1.0f,  1.0f,  0.0f, 1.0f,
+                -1.0f, -1.0f,  0.0f, 0.0f,
+                 1.0f, -1.0f,  1.0f, 0.0f,
+                -1.0f,  1.0f,  0.0f, 1.0f,
+                 1.0f, -1.0f,  1.0f, 0.0f,
+                 1.0f,  1.0f,  1.0f, 1.0f
+            };
+
+            auto vertexBuffer = Ref<VertexBuffer>(VertexBuffer::Create(vertices, static_cast<uint32_t>(sizeof(vertices))));
+            VertexBufferLayout layout;
+            layout.Push<float>(2);
+            layout.Push<float>(2);
+            vertexBuffer->SetLayout(layout);
+
+            auto vertexArray = Ref<VertexArray>(VertexArray::Create());
+            vertexArray->AddVertexBuffer(vertexBuffer);
+            return vertexArray;
+        }
+
+        Ref<VertexArray> BuildImpostorQuad()
+        {
+            float vertices[] = 
+            {
+                -1.0f, -1.0f,
+                 1.0f, -1.0f,
+                 1.0f,  1.0f,
+                -1.0f,  1.0f
+            };
+            uint32_t indices[] = { 0, 1, 2, 2, 3, 0 };
+
+            auto vertexBuffer = Ref<VertexBuffer>(VertexBuffer::Create(vertices, static_cast<uint32_t>(sizeof(vertices))));
+            VertexBufferLayout layout;
+            layout.Push<float>(2);
+            vertexBuffer->SetLayout(layout);
+
+            auto indexBuffer = Ref<IndexBuffer>(IndexBuffer::Create(indices, 6));
+
+            auto vertexArray = Ref<VertexArray>(VertexArray::Create());
+            vertexArray->AddVertexBuffer(vertexBuffer);
+            vertexArray->SetIndexBuffer(indexBuffer);
+            return vertexArray;
+        }
+    }
+
+    void AssetRegistry::Init()
+    {
+        Data();
+    }
+
+    void AssetRegistry::Shutdown()
+    {
+        if (s_Data)
+            DONUT_INFO("Releasing {} shared assets", GetAssetCount());
+        s_Data.reset();
+    }
+
+    void AssetRegistry::Preload()
+    {
+        GetShader("Assets/Shaders/TexturedQuad.glsl");
+        GetShader("Assets/Shaders/Blur.glsl");
+        GetShader("Assets/Shaders/Sphere.glsl");
+        GetShader("Assets/Shaders/SphereImpostor.glsl");
+        GetShader("Assets/Shaders/Skybox.glsl");
+        GetShader("Assets/Shaders/Grid.glsl");
+        GetShader("Assets/Shaders/EquirectToCubemap.glsl");
+        GetComputeShader("Assets/Shaders/Geodesic.glsl");
+
+        GetUVSphere(16, 8);
+        GetUVSphere(32, 16);
+        GetUVSphere(64, 32);
+        GetGridLines(50.0f, 101);
+        GetSkyboxCube();
+        GetFullscreenQuad();
+        GetImpostorQuad();
+
+        DONUT_INFO("Preloaded {} shared assets", GetAssetCount());
+    }
+
+    Ref<Shader> AssetRegistry::GetShader(const std::string& path)
+    {
+        auto& shaders = Data().Shaders;
+        auto it = shaders.find(path);
+        if (it != shaders.end())
+            return it->second;
+
+        auto shader = Ref<Shader>(Shader::Create(path));
+        if (!shader)
+        {
+            DONUT_ERROR("Failed to create shader: {}", path);
+            return nullptr;
+        }
+
+        shaders[path] = shader;
+        return shader;
+    }
+
+    Ref<Shader> AssetRegistry::GetComputeShader(const std::string& path)
+    {
+        auto& shaders = Data().Shaders;
+        auto it = shaders.find(path);
+        if (it != shaders.end())
+            return it->second;
+
+        std::ifstream in(path);
+        if (!in.is_open())
+        {
+            DONUT_ERROR("Failed to open compute shader: {}", path);
+            return nullptr;
+        }
+
+        std::stringstream ss;
+        ss << in.rdbuf();
+
+        auto shader = Ref<Shader>(Shader::CreateCompute(path, ss.str()));
+        if (!shader)
+        {
+            DONUT_ERROR("Failed to create compute shader: {}", path);
+            return nullptr;
+        }
+
+        shaders[path] = shader;
+        return shader;
+    }
+
+    Ref<Texture2D> AssetRegistry::GetTexture(const std::string& path)
+    {
+        auto& textures = Data().Textures;
+        auto it = textures.find(path);
+        if (it != textures.end())
+            return it->second;
+
+        auto texture = Texture2D::Create(path);
+        if (texture)
+            textures[path] = texture;
+        return texture;
+    }
+
+    Ref<VertexArray> AssetRegistry::GetMesh(const std::string& key, const MeshFactory& factory)
+    {
+        auto& meshes = Data().Meshes;
+        auto it = meshes.find(key);
+        if (it != meshes.end())
+            return it->second;
+
+        auto mesh = factory();
+        if (mesh)
+            meshes[key] = mesh;
+        return mesh;
+    }
+
+    Ref<VertexArray> AssetRegistry::GetUVSphere(uint32_t segments, uint32_t rings)
+    {
+        return GetMesh("UVSphere:" + std::to_string(segments) + "x" + std::to_string(rings),
+                       [=]() { return BuildUVSphere(segments, rings); });
+    }
+
+    Ref<VertexArray> AssetRegistry::GetGridLines(float extent, uint32_t lines)
+    {
+        return GetMesh("GridLines:" + std::to_string(extent) + "x" + std::to_string(lines),
+                       [=]() { return BuildGridLines(extent, lines); });
+    }
+
+    Ref<VertexArray> AssetRegistry::GetSkyboxCube()
+    {
+        return GetMesh("SkyboxCube", BuildSkyboxCube);
+    }
+
+    Ref<VertexArray> AssetRegistry::GetFullscreenQuad()
+    {
+        return GetMesh("FullscreenQuad", BuildFullscreenQuad);
+    }
+
+    Ref<VertexArray> AssetRegistry::GetImpostorQuad()
+    {
+        return GetMesh("ImpostorQuad", BuildImpostorQuad);
+    }
+
+    uint32_t AssetRegistry::GetAssetCount()
+    {
+        if (!s_Data)
+            return 0;
+
+        return static_cast<uint32_t>(s_Data->Shaders.size() + s_Data->Textures.size() + s_Data->Meshes.size());
+    }
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Core/Memory.h"
+#include "Rendering/Shader.h"
+#include "Rendering/Texture.h"
+#include "Rendering/VertexArray.h"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace Donut
+{
+    // Shared GPU assets keyed by path (shaders, textures) or by generator and
+    // parameters (meshes). Each asset is created on first request and handed out
+    // as a shared Ref; the registry keeps it alive until Shutdown(), so states
+    // can be entered and left without rebuilding anything. GL thread only;
+    // callers on other threads go through RenderThread::Execute.
+    class AssetRegistry
+    {
+    public:
+        using MeshFactory = std::function<Ref<VertexArray>()>;
+
+        static void Init();
+        static void Shutdown();
+
+        // Creates every asset the built-in states use, instead of on first use
+        static void Preload();
+
+        static Ref<Shader>      GetShader(const std::string& path);
+        static Ref<Shader>      GetComputeShader(const std::string& path);
+        static Ref<Texture2D>   GetTexture(const std::string& path);
+        static Ref<VertexArray> GetMesh(const std::string& key, const MeshFactory& factory);
+
+        static Ref<VertexArray> GetUVSphere(uint32_t segments, uint32_t rings);
+        static Ref<VertexArray> GetGridLines(float extent, uint32_t lines);
+        static Ref<VertexArray> GetSkyboxCube();
+        static Ref<VertexArray> GetFullscreenQuad();
+        static Ref<VertexArray> GetImpostorQuad();
+
+        static uint32_t GetAssetCount();
+    };
+};
@@ -2,6 +2,7 @@
 #include "Renderer.h"
 
 #include "Platform/OpenGL/OpenGLFramebuffer.h"
+#include "Platform/Software/SoftwareFramebuffer.h"
 
 namespace Donut
 {
@@ -9,7 +10,8 @@ namespace Donut
     {
         switch (Renderer::GetAPI())
         {
-            case RendererAPI::API::OpenGL:  return CreateRef<OpenGLFramebuffer>(spec);
+            case RendererAPI::API::OpenGL:   return CreateRef<OpenGLFramebuffer>(spec);
+            case RendererAPI::API::Software: return CreateRef<SoftwareFramebuffer>(spec);
         }
 
         return nullptr;
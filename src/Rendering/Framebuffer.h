@@ -55,6 +55,9 @@ namespace Donut
         virtual void Resize(uint32_t width, uint32_t height)           = 0;
         virtual int  ReadPixel(uint32_t attachmentIndex, int x, int y) = 0;
 
+        // Whole RGBA8 attachment, bottom row first
+        virtual void ReadColorAttachment(uint32_t attachmentIndex, std::vector<uint8_t>& pixels) = 0;
+
         virtual void ClearAttachment(uint32_t attachmentIndex, int value)       = 0;
         virtual uint32_t GetColorAttachmentRendererID(uint32_t index = 0) const = 0;
 
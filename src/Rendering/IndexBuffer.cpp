@@ -3,6 +3,7 @@
 
 #include "Platform/OpenGL/OpenGLIndexBuffer.h"
 #include "Platform/Vulkan/VulkanIndexBuffer.h"
+#include "Platform/Software/SoftwareIndexBuffer.h"
 
 namespace Donut 
 {
@@ -14,6 +15,8 @@ namespace Donut
                 return new OpenGLIndexBuffer(indices, count);
             case RendererAPI::API::Vulkan:
                 return new VulkanIndexBuffer((uint32_t*)indices, count);
+            case RendererAPI::API::Software:
+                return new SoftwareIndexBuffer(indices, count);
             default:
                 return nullptr;
         }
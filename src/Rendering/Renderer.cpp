@@ -2,6 +2,7 @@
 
 #include "Platform/OpenGL/OpenGLRendererAPI.h"
 #include "Platform/Vulkan/VulkanRendererAPI.h"
+#include "Platform/Software/SoftwareRendererAPI.h"
 
 #include <glm/gtc/matrix_transform.hpp>
 
@@ -15,11 +16,38 @@ namespace Donut
                 return CreateScope<OpenGLRendererAPI>();
             case API::Vulkan:
                 return CreateScope<VulkanRendererAPI>();
+            case API::Software:
+                return CreateScope<SoftwareRendererAPI>();
             default:
                 return nullptr;
         }
     }
 
+    bool RendererAPI::IsSupported(API api)
+    {
+        return api == API::OpenGL || api == API::Software;
+    }
+
+    const char* RendererAPI::GetAPIName(API api)
+    {
+        switch (api)
+        {
+            case API::OpenGL:   return "OpenGL";
+            case API::Vulkan:   return "Vulkan";
+            case API::Software: return "Software";
+            default:            return "None";
+        }
+    }
+
+    RendererAPI::API RendererAPI::GetAPIFromName(const std::string& name)
+    {
+        if (name == "Vulkan")
+            return API::Vulkan;
+        if (name == "Software")
+            return API::Software;
+        return API::OpenGL;
+    }
+
     RendererAPI::API RendererAPI::s_API = RendererAPI::API::OpenGL;
 
     void Renderer::Init()
@@ -50,7 +78,7 @@ namespace Donut
         RenderCommand::DrawIndexed(vertexArray);
     }
 
-    Scope<RendererAPI> RenderCommand::s_RendererAPI = RendererAPI::Create();
+    Scope<RendererAPI> RenderCommand::s_RendererAPI;
 
     void Renderer::SetClearColor(const glm::vec4& color)
     {
@@ -14,9 +14,10 @@ namespace Donut
     public:
         enum class API 
         {
-            None   = 0, 
-            OpenGL = 1,
-            Vulkan = 2,
+            None     = 0, 
+            OpenGL   = 1,
+            Vulkan   = 2,
+            Software = 3,
         };
     public:
         virtual ~RendererAPI() = default;
@@ -34,6 +35,9 @@ namespace Donut
 
         virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, 
                                  uint32_t indexCount = 0)                 = 0;
+        virtual void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray,
+                                          uint32_t instanceCount,
+                                          uint32_t indexCount = 0)        = 0;
         
         virtual void DrawArrays(uint32_t vertexCount, uint32_t first = 0) = 0;
         virtual void DrawLines(const Ref<VertexArray>& vertexArray, 
@@ -45,9 +49,20 @@ namespace Donut
         virtual void ReadPixels(uint32_t x, uint32_t y, uint32_t width, uint32_t height, 
                                 uint32_t format, uint32_t type, void* pixels) = 0;
 
+        // Shows the default framebuffer on the window before the UI is drawn over it;
+        // only backends that do not render into the window themselves need this
+        virtual void Present()                                            = 0;
+
         inline static API GetAPI()         { return s_API; }
         inline static void SetAPI(API api) { s_API = api;  }
         static Scope<RendererAPI> Create();
+
+        // Whether the backend can actually render; Vulkan is still stubbed out
+        static bool IsSupported(API api);
+
+        // Names as they appear in settings.json and the config UI
+        static const char* GetAPIName(API api);
+        static API         GetAPIFromName(const std::string& name);
     private:
         static API s_API;
     };
@@ -55,8 +70,10 @@ namespace Donut
     class RenderCommand 
     {
     public:
+        // The backend is created here rather than statically, once the API has been chosen
         inline static void Init() 
         {
+            s_RendererAPI = RendererAPI::Create();
             s_RendererAPI->Init();
         }
 
@@ -105,6 +122,11 @@ namespace Donut
             s_RendererAPI->DrawIndexed(vertexArray, indexCount);
         }
 
+        inline static void DrawIndexedInstanced(const Ref<VertexArray>& vertexArray, uint32_t instanceCount, uint32_t indexCount = 0)
+        {
+            s_RendererAPI->DrawIndexedInstanced(vertexArray, instanceCount, indexCount);
+        }
+
         inline static void DrawArrays(uint32_t vertexCount, uint32_t first = 0)
         {
             s_RendererAPI->DrawArrays(vertexCount, first);
@@ -131,6 +153,11 @@ namespace Donut
             s_RendererAPI->ReadPixels(x, y, width, height, format, type, pixels);
         }
 
+        inline static void Present()
+        {
+            s_RendererAPI->Present();
+        }
+
     private:
         static Scope<RendererAPI> s_RendererAPI;
     };
@@ -3,6 +3,7 @@
 
 #include "Platform/OpenGL/OpenGLShader.h"
 #include "Platform/Vulkan/VulkanShader.h"
+#include "Platform/Software/SoftwareShader.h"
 
 namespace Donut
 {
@@ -14,6 +15,8 @@ namespace Donut
                 return new OpenGLShader(filepath);
             case RendererAPI::API::Vulkan:
                 return new VulkanShader(filepath);
+            case RendererAPI::API::Software:
+                return new SoftwareShader(filepath);
             default:
                 return nullptr;
         }
@@ -27,6 +30,8 @@ namespace Donut
                 return new OpenGLShader(name, vertexSrc, fragmentSrc);
             case RendererAPI::API::Vulkan:
                 return new VulkanShader(name, vertexSrc, fragmentSrc);
+            case RendererAPI::API::Software:
+                return new SoftwareShader(name, vertexSrc, fragmentSrc);
             default:
                 return nullptr;
         }
@@ -40,6 +45,8 @@ namespace Donut
                 return new OpenGLShader(name, computeSrc);
             case RendererAPI::API::Vulkan:
                 return new VulkanShader(name, computeSrc);
+            case RendererAPI::API::Software:
+                return new SoftwareShader(name, computeSrc);
             default:
                 return nullptr;
         }
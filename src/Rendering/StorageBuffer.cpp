@@ -0,0 +1,26 @@
+#include "StorageBuffer.h"
+#include "Renderer.h"
+
+#include "Platform/OpenGL/OpenGLStorageBuffer.h"
+#include "Platform/Vulkan/VulkanStorageBuffer.h"
+#include "Platform/Software/SoftwareStorageBuffer.h"
+
+namespace Donut
+{
+    Ref<StorageBuffer> StorageBuffer::Create(uint32_t size, uint32_t binding)
+    {
+        switch (Renderer::GetAPI())
+        {
+        case RendererAPI::API::OpenGL:
+            return CreateRef<OpenGLStorageBuffer>(size, binding);
+        case RendererAPI::API::Vulkan:
+            return CreateRef<VulkanStorageBuffer>(size, binding);
+        case RendererAPI::API::Software:
+            return CreateRef<SoftwareStorageBuffer>(size, binding);
+        case RendererAPI::API::None:
+            return nullptr;
+        default:
+            return nullptr;
+        }
+    }
+};
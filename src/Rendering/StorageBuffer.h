@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Core/Memory.h"
+#include <cstdint>
+
+namespace Donut
+{
+    class StorageBuffer
+    {
+    public:
+        virtual ~StorageBuffer() = default;
+
+        virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) = 0;
+        virtual void Resize(uint32_t size)                                         = 0;
+        virtual void Bind(uint32_t binding)                                        = 0;
+
+        virtual uint32_t GetSize() const = 0;
+
+        static Ref<StorageBuffer> Create(uint32_t size, uint32_t binding);
+    };
+};
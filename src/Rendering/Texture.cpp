@@ -3,6 +3,7 @@
 
 #include "Platform/OpenGL/OpenGLTexture.h"
 #include "Platform/Vulkan/VulkanTexture.h"
+#include "Platform/Software/SoftwareTexture.h"
 
 namespace Donut
 {
@@ -14,6 +15,8 @@ namespace Donut
             return CreateRef<OpenGLTexture2D>(width, height);
         case RendererAPI::API::Vulkan:
             return CreateRef<VulkanTexture2D>(width, height);
+        case RendererAPI::API::Software:
+            return CreateRef<SoftwareTexture2D>(width, height);
         case RendererAPI::API::None:
             return nullptr;
         default:
@@ -29,6 +32,8 @@ namespace Donut
             return CreateRef<OpenGLTexture2D>(path);
         case RendererAPI::API::Vulkan:
             return CreateRef<VulkanTexture2D>(path);
+        case RendererAPI::API::Software:
+            return CreateRef<SoftwareTexture2D>(path);
         case RendererAPI::API::None:
             return nullptr;
         default:
@@ -44,6 +49,25 @@ namespace Donut
             return CreateRef<OpenGLCubemapTexture>(width, height);
         case RendererAPI::API::Vulkan:
             return CreateRef<VulkanCubemapTexture>(width, height);
+        case RendererAPI::API::Software:
+            return CreateRef<SoftwareCubemapTexture>(width, height);
+        case RendererAPI::API::None:
+            return nullptr;
+        default:
+            return nullptr;
+        }
+    }
+
+    Ref<CubemapTexture> CubemapTexture::Create(const CubemapData& data)
+    {
+        switch (Renderer::GetAPI())
+        {
+        case RendererAPI::API::OpenGL:
+            return CreateRef<OpenGLCubemapTexture>(data);
+        case RendererAPI::API::Vulkan:
+            return CreateRef<VulkanCubemapTexture>(data);
+        case RendererAPI::API::Software:
+            return CreateRef<SoftwareCubemapTexture>(data);
         case RendererAPI::API::None:
             return nullptr;
         default:
@@ -59,6 +83,8 @@ namespace Donut
             return CreateRef<OpenGLCubemapTexture>(path);
         case RendererAPI::API::Vulkan:
             return CreateRef<VulkanCubemapTexture>(path);
+        case RendererAPI::API::Software:
+            return CreateRef<SoftwareCubemapTexture>(path);
         case RendererAPI::API::None:
             return nullptr;
         default:
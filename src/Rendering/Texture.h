@@ -3,6 +3,7 @@
 #include "Core/Memory.h"
 
 #include <string>
+#include <vector>
 #include <glm/glm.hpp>
 
 namespace Donut
@@ -28,15 +29,50 @@ namespace Donut
         : public Texture
     {
     public:
+        // Uploads an RGBA8 rectangle; rowLength is the source pitch in pixels, zero for tightly packed
+        virtual void SetSubData(const void* data, uint32_t x, uint32_t y,
+                                uint32_t width, uint32_t height, uint32_t rowLength = 0) = 0;
+
         static Ref<Texture2D> Create(uint32_t width, uint32_t height);
         static Ref<Texture2D> Create(const std::string& path);
     };
 
+    // Decoded equirectangular HDRI, RGBA half floats with the bottom row first
+    struct HDRIImage
+    {
+        std::string           Path;
+        uint32_t              Width  = 0;
+        uint32_t              Height = 0;
+        std::vector<uint16_t> Pixels;
+    };
+
+    // Pre-converted cubemap in packed RGB9E5, level-major with the six faces of
+    // each mip level stored back to back
+    struct CubemapData
+    {
+        uint32_t        FaceSize = 0;
+        uint32_t        MipCount = 0;
+        const uint32_t* Texels   = nullptr;
+    };
+
     class CubemapTexture
         : public Texture
     {
     public:
+        virtual uint32_t GetMipCount()   const = 0;
+        virtual uint64_t GetMemorySize() const = 0;
+
+        // Reads every face of one mip level back as RGB floats
+        virtual bool ReadPixels(uint32_t level, std::vector<float>& rgb) const = 0;
+
+        // Streams a decoded HDRI in slices of at most byteBudget bytes per call;
+        // ContinueUpload returns true once the cubemap faces have been rendered
+        virtual void  BeginUpload(const Ref<HDRIImage>& image) = 0;
+        virtual bool  ContinueUpload(uint32_t byteBudget)      = 0;
+        virtual float GetUploadProgress() const                = 0;
+
         static Ref<CubemapTexture> Create(uint32_t width, uint32_t height);
         static Ref<CubemapTexture> CreateFromHDRI(const std::string& path);
+        static Ref<CubemapTexture> Create(const CubemapData& data);
     };
 };
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include "Platform/OpenGL/OpenGLUniformBuffer.h"
 #include "Platform/Vulkan/VulkanUniformBuffer.h"
+#include "Platform/Software/SoftwareUniformBuffer.h"
 
 namespace Donut
 {
@@ -14,6 +15,8 @@ namespace Donut
             return CreateRef<OpenGLUniformBuffer>(size, binding);
         case RendererAPI::API::Vulkan:
             return CreateRef<VulkanUniformBuffer>(size, binding);
+        case RendererAPI::API::Software:
+            return CreateRef<SoftwareUniformBuffer>(size, binding);
         case RendererAPI::API::None:
             return nullptr;
         default:
@@ -0,0 +1,26 @@
+#include "UniformRingBuffer.h"
+#include "Renderer.h"
+
+#include "Platform/OpenGL/OpenGLUniformRingBuffer.h"
+#include "Platform/Vulkan/VulkanUniformRingBuffer.h"
+#include "Platform/Software/SoftwareUniformRingBuffer.h"
+
+namespace Donut
+{
+    Ref<UniformRingBuffer> UniformRingBuffer::Create(uint32_t frameSize, uint32_t framesInFlight)
+    {
+        switch (Renderer::GetAPI())
+        {
+        case RendererAPI::API::OpenGL:
+            return CreateRef<OpenGLUniformRingBuffer>(frameSize, framesInFlight);
+        case RendererAPI::API::Vulkan:
+            return CreateRef<VulkanUniformRingBuffer>(frameSize, framesInFlight);
+        case RendererAPI::API::Software:
+            return CreateRef<SoftwareUniformRingBuffer>(frameSize, framesInFlight);
+        case RendererAPI::API::None:
+            return nullptr;
+        default:
+            return nullptr;
+        }
+    }
+};
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Core/Memory.h"
+#include <cstdint>
+
+namespace Donut
+{
+    // Streaming allocator for per-frame uniform data. The backing store is split
+    // into one segment per frame in flight; a segment is only reused once the GPU
+    // has finished the frame that last wrote to it.
+    class UniformRingBuffer
+    {
+    public:
+        struct Allocation
+        {
+            uint32_t Offset = 0;
+            uint32_t Size   = 0;
+            uint64_t Frame  = 0;
+        };
+    public:
+        virtual ~UniformRingBuffer() = default;
+
+        virtual void BeginFrame() = 0;
+        virtual void EndFrame()   = 0;
+
+        virtual Allocation Upload(const void* data, uint32_t size)            = 0;
+        virtual void       BindRange(uint32_t binding, const Allocation& alloc) = 0;
+        virtual bool       IsResident(const Allocation& alloc)            const = 0;
+
+        static Ref<UniformRingBuffer> Create(uint32_t frameSize, uint32_t framesInFlight = 3);
+    };
+};
@@ -3,6 +3,7 @@
 
 #include "Platform/OpenGL/OpenGLVertexArray.h"
 #include "Platform/Vulkan/VulkanVertexArray.h"
+#include "Platform/Software/SoftwareVertexArray.h"
 
 namespace Donut
 {
@@ -25,6 +26,8 @@ namespace Donut
                 return new OpenGLVertexArray();
             case RendererAPI::API::Vulkan:
                 return new VulkanVertexArray();
+            case RendererAPI::API::Software:
+                return new SoftwareVertexArray();
             default:
                 return nullptr;
         }
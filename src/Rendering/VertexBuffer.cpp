@@ -3,9 +3,25 @@
 
 #include "Platform/OpenGL/OpenGLVertexBuffer.h"
 #include "Platform/Vulkan/VulkanVertexBuffer.h"
+#include "Platform/Software/SoftwareVertexBuffer.h"
 
 namespace Donut
 {
+    VertexBuffer* VertexBuffer::Create(uint32_t size)
+    {
+        switch (Renderer::GetAPI()) 
+        {
+            case RendererAPI::API::OpenGL:
+                return new OpenGLVertexBuffer(size);
+            case RendererAPI::API::Vulkan:
+                return new VulkanVertexBuffer(size);
+            case RendererAPI::API::Software:
+                return new SoftwareVertexBuffer(size);
+            default:
+                return nullptr;
+        }
+    }
+
     VertexBuffer* VertexBuffer::Create(const void* data, uint32_t size)
     {
         switch (Renderer::GetAPI()) 
@@ -14,6 +30,8 @@ namespace Donut
                 return new OpenGLVertexBuffer(data, size);
             case RendererAPI::API::Vulkan:
                 return new VulkanVertexBuffer((float*)data, size);
+            case RendererAPI::API::Software:
+                return new SoftwareVertexBuffer(data, size);
             default:
                 return nullptr;
         }
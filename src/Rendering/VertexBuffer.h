@@ -48,12 +48,17 @@ namespace Donut
             m_Stride += count * VertexBufferElement::GetSizeOfType(0x1401);
         }
 
+        // A non-zero step rate advances the attributes once per that many instances instead of per vertex
+        inline void SetInstanceStepRate(uint32_t rate) { m_InstanceStepRate = rate; }
+
         inline const std::vector<VertexBufferElement>& GetElements() const { return m_Elements; }
         inline uint32_t GetStride() const { return m_Stride; }
+        inline uint32_t GetInstanceStepRate() const { return m_InstanceStepRate; }
 
     private:
         std::vector<VertexBufferElement> m_Elements;
         uint32_t m_Stride = 0;
+        uint32_t m_InstanceStepRate = 0;
     };
 
     class VertexBuffer
@@ -68,6 +73,7 @@ namespace Donut
         virtual const VertexBufferLayout& GetLayout()      const = 0;
         virtual void SetLayout(const VertexBufferLayout& layout) = 0;
 
+        static VertexBuffer* Create(uint32_t size);
         static VertexBuffer* Create(const void* data, uint32_t size);
     };
 };
@@ -16,7 +16,7 @@ namespace Donut
         
         const auto& settings = SettingsManager::GetSettingsConst();
         
-        m_SelectedAPI            = (settings.graphics.renderAPI == "Vulkan") ? RendererAPI::API::Vulkan : RendererAPI::API::OpenGL;
+        m_SelectedAPI            = RendererAPI::GetAPIFromName(settings.graphics.renderAPI);
         m_SelectedTheme          = (settings.graphics.selectedTheme == "Light") ? 1 : 
                                    (settings.graphics.selectedTheme == "Blue") ? 2 : 0;
         m_TargetFPS              = settings.simulation.targetFPS;
@@ -30,6 +30,16 @@ namespace Donut
         m_ShowPerformanceMetrics = settings.graphics.showPerformanceMetrics;
         m_ShowDebugInfo          = settings.graphics.showDebugInfo;
         m_EnableAntiAliasing     = settings.graphics.enableAntiAliasing;
+        m_HDRICacheBudgetMB      = settings.graphics.hdriCacheBudgetMB;
+
+        auto glString = [](GLenum name)
+        {
+            const GLubyte* value = glGetString(name);
+            return value ? std::string(reinterpret_cast<const char*>(value)) : std::string("Unknown");
+        };
+        m_GLVersion  = glString(GL_VERSION);
+        m_GLRenderer = glString(GL_RENDERER);
+        m_GLVendor   = glString(GL_VENDOR);
     }
     
     void ConfigState::OnExit()
@@ -50,10 +60,13 @@ namespace Donut
         }
     }
     
-    void ConfigState::OnRender()
+    void ConfigState::OnRender(FramePacket& packet)
     {
-        Renderer::SetClearColor({ 0.1f, 0.1f, 0.1f, 1.0f });
-        Renderer::Clear();
+        packet.Submit([]()
+        {
+            Renderer::SetClearColor({ 0.1f, 0.1f, 0.1f, 1.0f });
+            Renderer::Clear();
+        });
     }
     
     void ConfigState::OnEvent(Event& event)
@@ -85,7 +98,7 @@ namespace Donut
         ImGui::SameLine();
         ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "(requires restart)");
         
-        const char* apiNames[] = { "OpenGL", "Vulkan" };
+        const char* apiNames[] = { "OpenGL", "Vulkan", "Software" };
         static int currentAPI = (int)m_SelectedAPI - 1; 
         
         if (ImGui::BeginCombo("##RenderAPI", apiNames[currentAPI]))
@@ -93,7 +106,9 @@ namespace Donut
             for (int i = 0; i < IM_ARRAYSIZE(apiNames); i++)
             {
                 const bool isSelected = (currentAPI == i);
-                if (ImGui::Selectable(apiNames[i], isSelected))
+                const bool supported  = RendererAPI::IsSupported((RendererAPI::API)(i + 1));
+                std::string label = supported ? apiNames[i] : std::string(apiNames[i]) + " (not available yet)";
+                if (ImGui::Selectable(label.c_str(), isSelected, supported ? 0 : ImGuiSelectableFlags_Disabled))
                 {
                     currentAPI = i;
                     m_SelectedAPI = (RendererAPI::API)(i + 1);
@@ -110,7 +125,7 @@ namespace Donut
         
         ImGui::Text("Current API: ");
         ImGui::SameLine();
-        const char* currentAPIName = (Renderer::GetAPI() == RendererAPI::API::OpenGL) ? "OpenGL" : "Vulkan";
+        const char* currentAPIName = RendererAPI::GetAPIName(Renderer::GetAPI());
         ImGui::TextColored(ImVec4(0.3f, 0.8f, 0.3f, 1.0f), currentAPIName);
         
         ImGui::Spacing();
@@ -118,6 +133,9 @@ namespace Donut
         ImGui::Checkbox("Enable VSync", &m_VSyncEnabled);
         ImGui::SameLine();
         ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "(recommended)");
+
+        ImGui::SliderInt("HDRI Cache Budget", &m_HDRICacheBudgetMB, 64, 4096, "%d MB");
+        ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "GPU memory kept for recently used environments");
         
         ImGui::Spacing();
         
@@ -132,9 +150,9 @@ namespace Donut
         ImGui::TextColored(ImVec4(0.9f, 0.9f, 1.0f, 1.0f), "System Info");
         ImGui::Separator();
         
-        ImGui::Text("OpenGL Version: %s", glGetString(GL_VERSION));
-        ImGui::Text("GPU: %s", glGetString(GL_RENDERER));
-        ImGui::Text("Vendor: %s", glGetString(GL_VENDOR));
+        ImGui::Text("OpenGL Version: %s", m_GLVersion.c_str());
+        ImGui::Text("GPU: %s", m_GLRenderer.c_str());
+        ImGui::Text("Vendor: %s", m_GLVendor.c_str());
         
         ImGui::Spacing();
         
@@ -262,6 +280,7 @@ namespace Donut
     {
         SimulationSettings simSettings;
         simSettings.targetFPS = m_TargetFPS;
+        simSettings.physicsRate = SettingsManager::GetPhysicsRate();
         simSettings.computeHeight = m_ComputeHeight;
         simSettings.maxStepsMoving = m_MaxStepsMoving;
         simSettings.maxStepsStatic = m_MaxStepsStatic;
@@ -269,19 +288,20 @@ namespace Donut
         simSettings.gravityEnabled = m_GravityEnabled;
         
         GraphicsSettings gfxSettings;
-        gfxSettings.renderAPI = (m_SelectedAPI == RendererAPI::API::Vulkan) ? "Vulkan" : "OpenGL";
+        gfxSettings.renderAPI = RendererAPI::GetAPIName(m_SelectedAPI);
         gfxSettings.vSyncEnabled = m_VSyncEnabled;
         gfxSettings.showFPS = m_ShowFPS;
         gfxSettings.showPerformanceMetrics = m_ShowPerformanceMetrics;
         gfxSettings.showDebugInfo = m_ShowDebugInfo;
         gfxSettings.enableAntiAliasing = m_EnableAntiAliasing;
+        gfxSettings.hdriCacheBudgetMB = m_HDRICacheBudgetMB;
         gfxSettings.selectedTheme = (m_SelectedTheme == 1) ? "Light" : 
                                     (m_SelectedTheme == 2) ? "Blue"  : "Dark";
         
         SettingsManager::SetSimulationSettings(simSettings);
         SettingsManager::SetGraphicsSettings(gfxSettings);
         
-        RendererAPI::SetAPI(m_SelectedAPI);
+        // Resources already created belong to the running backend, so the switch waits for a restart
         DONUT_INFO("Settings applied and saved");
     }
     
@@ -299,6 +319,7 @@ namespace Donut
         m_ShowPerformanceMetrics = true;
         m_ShowDebugInfo          = false;
         m_EnableAntiAliasing     = true;
+        m_HDRICacheBudgetMB      = 256;
         m_SelectedTheme          = 0;
         
         ApplySettings();
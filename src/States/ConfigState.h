@@ -5,6 +5,8 @@
 #include "Core/Log.h"
 #include "Rendering/Renderer.h"
 
+#include <string>
+
 namespace Donut
 {
     class ConfigState
@@ -13,12 +15,12 @@ namespace Donut
     public:
         ~ConfigState() = default;
         
-        void OnEnter()                 override;
-        void OnExit()                  override;
-        void OnUpdate(float deltaTime) override;
-        void OnRender()                override;
-        void OnImUIRender()            override;
-        void OnEvent(Event& event)     override;
+        void OnEnter()                     override;
+        void OnExit()                      override;
+        void OnUpdate(float deltaTime)     override;
+        void OnRender(FramePacket& packet) override;
+        void OnImUIRender()                override;
+        void OnEvent(Event& event)         override;
         
     private:
         void ApplySettings();
@@ -41,7 +43,13 @@ namespace Donut
         bool m_ShowPerformanceMetrics = true;
         bool m_ShowDebugInfo = false;
         bool m_EnableAntiAliasing = true;
+        int  m_HDRICacheBudgetMB = 256;
         
         int m_SelectedTheme = 0; // 0=Dark, 1=Light, 2=Blue
+
+        // Queried on entry, where the context is current; the UI is built on the main thread
+        std::string m_GLVersion;
+        std::string m_GLRenderer;
+        std::string m_GLVendor;
     };
 };
\ No newline at end of file
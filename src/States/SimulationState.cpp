@@ -2,6 +2,7 @@
 #include "Rendering/Renderer.h"
 #include "Core/Application.h"
 #include "Core/HDRIManager.h"
+#include "Core/RenderThread.h"
 #include "Core/Window.h"
 #include "Core/Event.h"
 #include "Core/SettingsManager.h"
@@ -23,6 +24,7 @@ namespace Donut
         auto& engine = Application::Get().GetEngine();
         
         engine.SetTargetFPS(settings.simulation.targetFPS);
+        engine.SetPhysicsRate(settings.simulation.physicsRate);
         engine.SetComputeHeight(settings.simulation.computeHeight);
         engine.SetMaxStepsMoving(settings.simulation.maxStepsMoving);
         engine.SetMaxStepsStatic(settings.simulation.maxStepsStatic);
@@ -35,7 +37,6 @@ namespace Donut
         engine.SetBlurStrength(settings.simulation.blurStrength);
         engine.SetGlowIntensity(settings.simulation.glowIntensity);
         
-        engine.UpdateComputeDimensions();
         m_Initialized = true;
     }
     
@@ -48,7 +49,6 @@ namespace Donut
     {
         auto& engine = Application::Get().GetEngine();
         engine.UpdatePerformance(deltaTime);
-        engine.UpdateWindowDimensions();
         engine.UpdatePhysics(deltaTime);
 
         if (engine.GetCamera().IsDragging())
@@ -60,15 +60,20 @@ namespace Donut
         }
     }
     
-    void SimulationState::OnRender()
+    void SimulationState::OnRender(FramePacket& packet)
     {
         auto& engine = Application::Get().GetEngine();
-        RenderCommand::SetClearColor(glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
-        RenderCommand::Clear();
-        RenderCommand::SetViewport(0, 0, static_cast<uint32_t>(engine.GetWidth()), static_cast<uint32_t>(engine.GetHeight()));
+        EngineFrame frame = engine.BuildFrame(engine.GetCamera(), true);
 
-        engine.DispatchCompute(engine.GetCamera());
-        engine.DrawBlurPass();
+        packet.Submit([&engine, frame = std::move(frame)]()
+        {
+            RenderCommand::SetClearColor(glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+            RenderCommand::Clear();
+            RenderCommand::SetViewport(0, 0, static_cast<uint32_t>(frame.Width), static_cast<uint32_t>(frame.Height));
+
+            engine.DispatchCompute(frame);
+            engine.DrawBlurPass(frame);
+        });
     }
     
     void SimulationState::OnEvent(Event& event)
@@ -130,6 +135,7 @@ namespace Donut
         {
             SimulationSettings settings = SettingsManager::GetSettingsConst().simulation;
             settings.targetFPS = engine.GetTargetFPS();
+            settings.physicsRate = engine.GetPhysicsRate();
             settings.computeHeight = engine.GetComputeHeight();
             settings.maxStepsMoving = engine.GetMaxStepsMoving();
             settings.maxStepsStatic = engine.GetMaxStepsStatic();
@@ -147,6 +153,21 @@ namespace Donut
         ImGui::Text("FPS: %.1f", ImGui::GetIO().Framerate);
         ImGui::Text("Frame Time: %.3f ms", 1000.0f / ImGui::GetIO().Framerate);
         ImGui::Text("Engine FPS: %.1f", engine.GetCurrentFPS());
+
+        RenderThreadStats renderStats = RenderThread::GetStats();
+        ImGui::Text("Render Thread: %s, %.2f ms/frame", RenderThread::IsRunning() ? "on" : "off", renderStats.RenderTime);
+        ImGui::Text("Input Latency: %.1f ms (avg %.1f ms)", renderStats.LastLatency, renderStats.AverageLatency);
+
+        const FrameSchedulerStats& pacing = Application::Get().GetFrameScheduler().GetStats();
+        ImGui::Text("Frame Pacing: %.2f ms work, %.2f ms wait, %.2f ms late", pacing.WorkTime, pacing.WaitTime, pacing.Lateness);
+        ImGui::Text("Idle: %.0f%% (%.1f s total)", pacing.IdleFraction * 100.0, pacing.TotalIdleTime);
+
+        uint64_t issued  = engine.GetIssuedDispatches();
+        uint64_t skipped = engine.GetSkippedDispatches();
+        uint64_t built   = issued + skipped;
+        ImGui::Text("Traces Skipped: %llu of %llu (%.0f%%)", static_cast<unsigned long long>(skipped), static_cast<unsigned long long>(built),
+                    built > 0 ? 100.0 * static_cast<double>(skipped) / static_cast<double>(built) : 0.0);
+        ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "The last trace is shown again while the view, disk and objects are still");
         
         int targetFPS = engine.GetTargetFPS();
         if (ImGui::SliderInt("Target FPS", &targetFPS, 30, 120))
@@ -156,6 +177,15 @@ namespace Donut
             settings.targetFPS = targetFPS;
             SettingsManager::SetSimulationSettings(settings);
         }
+
+        int physicsRate = engine.GetPhysicsRate();
+        if (ImGui::SliderInt("Physics Rate (Hz)", &physicsRate, 10, 1000))
+        {
+            engine.SetPhysicsRate(physicsRate);
+            SimulationSettings settings = SettingsManager::GetSettingsConst().simulation;
+            settings.physicsRate = physicsRate;
+            SettingsManager::SetSimulationSettings(settings);
+        }
         
         ImGui::Spacing();
         
@@ -173,13 +203,17 @@ namespace Donut
         if (ImGui::SliderInt("Compute Height", &computeHeight, 64, 2048))
         {
             engine.SetComputeHeight(computeHeight);
-            engine.UpdateComputeDimensions();
             SimulationSettings settings = SettingsManager::GetSettingsConst().simulation;
             settings.computeHeight = computeHeight;
             SettingsManager::SetSimulationSettings(settings);
         }
         
         ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "Compute Width: %d (auto-calculated)", engine.GetComputeWidth());
+
+        bool pipelined = engine.IsPipelinedCompute();
+        if (ImGui::Checkbox("Overlap Tracing With Post-Processing", &pipelined))
+            engine.SetPipelinedCompute(pipelined);
+        ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "Shows the previous trace, one frame behind");
         
         ImGui::Spacing();
         
@@ -308,9 +342,26 @@ namespace Donut
         {
             auto& hdriManager = HDRIManager::Get();
             hdriManager.SetCurrentHDRI(availableHDRI[selectedHDRI]);
-            engine.SetHDRIEnvironment(hdriManager.GetCurrentHDRI());
+        }
+
+        if (hdriManager.IsLoading())
+        {
+            const char* stage = hdriManager.IsDecoding() ? "Decoding..." : "Uploading...";
+            ImGui::ProgressBar(hdriManager.GetLoadingProgress(), ImVec2(-1.0f, 0.0f), stage);
         }
         ImGui::TextDisabled("HDRI provides background and lighting for the simulation");
+
+        const std::string& selectedPath = availableHDRI[selectedHDRI];
+        bool pinned = hdriManager.IsPinned(selectedPath);
+        if (ImGui::Checkbox("Keep Resident", &pinned))
+            hdriManager.SetPinned(selectedPath, pinned);
+
+        const auto& hdriStats = hdriManager.GetStats();
+        ImGui::Text("Cache: %u resident, %.0f / %.0f MB", hdriStats.ResidentCount,
+                    hdriStats.ResidentBytes / (1024.0 * 1024.0), hdriManager.GetMemoryBudget() / (1024.0 * 1024.0));
+        ImGui::Text("Hits: %llu  Misses: %llu  Evictions: %llu  Prefetched: %llu",
+                    static_cast<unsigned long long>(hdriStats.Hits),      static_cast<unsigned long long>(hdriStats.Misses),
+                    static_cast<unsigned long long>(hdriStats.Evictions), static_cast<unsigned long long>(hdriStats.Prefetches));
         ImGui::PopID();
         
         ImGui::Spacing();
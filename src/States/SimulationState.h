@@ -14,12 +14,12 @@ namespace Donut
     public:
         ~SimulationState() = default;
         
-        void OnEnter()                 override;
-        void OnExit()                  override;
-        void OnUpdate(float deltaTime) override;
-        void OnRender()                override;
-        void OnImUIRender()            override;
-        void OnEvent(Event& event)     override;
+        void OnEnter()                     override;
+        void OnExit()                      override;
+        void OnUpdate(float deltaTime)     override;
+        void OnRender(FramePacket& packet) override;
+        void OnImUIRender()                override;
+        void OnEvent(Event& event)         override;
     
     private:
         bool m_Initialized = false;
@@ -10,6 +10,9 @@
 #include "Rendering/VertexBuffer.h"
 #include "Rendering/IndexBuffer.h"
 #include "Rendering/Texture.h"
+#include "Rendering/AssetRegistry.h"
+
+#include "Engine/SceneSerializer.h"
 
 #include <imgui.h>
 #include <ImGuizmo.h>
@@ -18,11 +21,9 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
-#include <nlohmann/json.hpp>
-
+#include <algorithm>
+#include <cstdio>
 #include <numbers>
-#include <fstream>
-#include <sstream>
 #include <limits>
 #include <vector>
 
@@ -33,6 +34,12 @@ namespace Donut
         DONUT_INFO("Entering World Builder State");
         
         ImGuizmo::Enable(true);
+        
+        if (!m_Initialized)
+        {
+            const char* scenePath = Application::Get().GetCommandLineArgs().GetValue("--scene");
+            std::snprintf(m_ScenePath, sizeof(m_ScenePath), "%s", scenePath ? scenePath : SceneSerializer::DefaultPath);
+        }
 
         m_Camera.SetCameraMode(CameraMode::Orbital);
         m_Camera.SetOrbitalTarget(glm::vec3(0.0f, 0.0f, 0.0f));
@@ -44,9 +51,10 @@ namespace Donut
         m_Camera.SetElevation(static_cast<float>(std::numbers::pi) / 3.0f);
         m_Camera.UpdateOrbital();
         
-        m_SphereShader = Ref<Shader>(Shader::Create("Assets/Shaders/Sphere.glsl"));
-        m_SkyboxShader = Ref<Shader>(Shader::Create("Assets/Shaders/Skybox.glsl"));
-        m_GridShader   = Ref<Shader>(Shader::Create("Assets/Shaders/Grid.glsl"));
+        // Shared with every other state, so re-entering doesn't recompile or re-upload anything
+        m_SphereShader = AssetRegistry::GetShader("Assets/Shaders/Sphere.glsl");
+        m_SkyboxShader = AssetRegistry::GetShader("Assets/Shaders/Skybox.glsl");
+        m_GridShader   = AssetRegistry::GetShader("Assets/Shaders/Grid.glsl");
         
         if (!m_SphereShader)
             DONUT_ERROR("Failed to create sphere shader");
@@ -55,19 +63,21 @@ namespace Donut
         if (!m_GridShader)
             DONUT_ERROR("Failed to create grid shader");
         
-        InitializeSphereGeometry();
-        InitializeSkyboxGeometry();
-        InitializeGridGeometry();
+        m_ImpostorShader = AssetRegistry::GetShader("Assets/Shaders/SphereImpostor.glsl");
+        if (!m_ImpostorShader)
+            DONUT_ERROR("Failed to create sphere impostor shader");
+        
+        m_PreviewShader = AssetRegistry::GetShader("Assets/Shaders/TexturedQuad.glsl");
+        m_PreviewQuad   = AssetRegistry::GetFullscreenQuad();
+        m_ImpostorBatch.SetMesh(AssetRegistry::GetImpostorQuad());
+        for (uint32_t lod = 0; lod < SphereLODCount; ++lod)
+            m_SphereLODBatches[lod].SetMesh(AssetRegistry::GetUVSphere(SphereLODSegments[lod], SphereLODSegments[lod] / 2));
+        m_SkyboxVAO = AssetRegistry::GetSkyboxCube();
+        m_GridVAO   = AssetRegistry::GetGridLines(GridExtent, GridLines);
         
         auto& hdriManager = HDRIManager::Get();
-        m_HDRIEnvironment = hdriManager.GetCurrentHDRI();
-        if (!m_HDRIEnvironment)
-        {
+        if (!hdriManager.GetCurrentHDRI())
             hdriManager.SetCurrentHDRI("Assets/HDRI/HDR_blue_nebulae-1.hdr");
-            m_HDRIEnvironment = hdriManager.GetCurrentHDRI();
-            if (!m_HDRIEnvironment)
-                DONUT_WARN("Failed to load default HDRI for WorldBuilder, using fallback");
-        }
         
         Material blackHoleMaterial(glm::vec3(0.0f, 0.0f, 0.0f), 0.0f, 0.0f);
         m_BlackHole = Object(glm::vec3(0.0f, 0.0f, 0.0f), 2.0f, blackHoleMaterial);
@@ -82,10 +92,26 @@ namespace Donut
     void WorldBuilderState::OnExit()
     {
         DONUT_INFO("Exiting World Builder State");
+        m_PreviewRenderer.Cancel();
     }
     
     void WorldBuilderState::OnUpdate(float deltaTime)
     {
+        // Refitting is linear in the object count, so gizmo edits never need to flag anything
+        m_Scene.UpdateBVH();
+        UpdatePreview();
+        
+        m_HoveredObjectIndex = -1;
+        if (!m_CameraDragging && !ImGuizmo::IsUsing() && !ImGui::GetIO().WantCaptureMouse)
+        {
+            GLFWwindow* window = static_cast<GLFWwindow*>(Application::Get().GetWindow().GetNativeWindow());
+            double xpos, ypos;
+            glfwGetCursorPos(window, &xpos, &ypos);
+            
+            bool hitBlackHole;
+            m_HoveredObjectIndex = PickObject(xpos, ypos, hitBlackHole);
+        }
+        
         if (m_CameraDragging && 
             !ImGuizmo::IsUsing())
         {
@@ -113,21 +139,59 @@ namespace Donut
         }
     }
     
-    void WorldBuilderState::OnRender()
+    void WorldBuilderState::OnRender(FramePacket& packet)
     {
-        auto& hdriManager = HDRIManager::Get();
-        m_HDRIEnvironment = hdriManager.GetCurrentHDRI();
-        
-        RenderCommand::SetClearColor(glm::vec4(0.1f, 0.1f, 0.1f, 1.0f));
-        RenderCommand::Clear();
+        GLFWwindow* window = static_cast<GLFWwindow*>(Application::Get().GetWindow().GetNativeWindow());
+        int width, height;
+        glfwGetFramebufferSize(window, &width, &height);
         
-        if (m_HDRIEnvironment)
-            RenderSkybox();
+        ViewFrame frame;
+        frame.Width        = static_cast<uint32_t>(width);
+        frame.Height       = static_cast<uint32_t>(height);
+        frame.View         = m_Camera.GetViewMatrix();
+        frame.Projection   = m_Camera.GetProjectionMatrix();
+        frame.CameraPos    = m_Camera.GetOrbitalPosition();
+        frame.LightPos     = m_Scene.m_LightPos;
+        frame.OutlineColor = m_OutlineColor;
+        frame.ShowGrid     = m_ShowGrid;
+        frame.GridColor    = m_GridColor;
+        frame.GridAlpha    = m_GridAlpha;
+        frame.GridSize     = m_GridSize;
+        frame.Environment  = HDRIManager::Get().GetCurrentHDRI();
+        
+        if (m_ShowCPUPreview && m_PreviewRenderer.GetTexture())
+        {
+            // Tile uploads go ahead of the draw in the same packet
+            if (RenderCommandFn upload = m_PreviewRenderer.Update())
+                packet.Submit(std::move(upload));
+
+            packet.Submit([this, frame = std::move(frame), texture = m_PreviewRenderer.GetTexture()]()
+            {
+                RenderCommand::SetClearColor(glm::vec4(0.1f, 0.1f, 0.1f, 1.0f));
+                RenderCommand::Clear();
+                RenderPreview(frame, texture);
+            });
+            return;
+        }
         
-        if (m_ShowGrid)
-            RenderGrid();
+        GatherSphereInstances(frame);
+        m_ImpostorCount = frame.Impostors.size();
+        for (uint32_t lod = 0; lod < SphereLODCount; ++lod)
+            m_SphereLODCounts[lod] = frame.SphereLODs[lod].size();
         
-        RenderScene();
+        packet.Submit([this, frame = std::move(frame)]()
+        {
+            RenderCommand::SetClearColor(glm::vec4(0.1f, 0.1f, 0.1f, 1.0f));
+            RenderCommand::Clear();
+            
+            if (frame.Environment)
+                RenderSkybox(frame);
+            
+            if (frame.ShowGrid)
+                RenderGrid(frame);
+            
+            RenderScene(frame);
+        });
     }
     
     void WorldBuilderState::OnEvent(Event& event)
@@ -146,81 +210,10 @@ namespace Donut
                 double xpos, ypos;
                 glfwGetCursorPos(window, &xpos, &ypos);
                 
-                int width, height;
-                glfwGetFramebufferSize(window, &width, &height);
-                
-                float ndcX = (2.0f * static_cast<float>(xpos)) / static_cast<float>(width) - 1.0f;
-                float ndcY = 1.0f - (2.0f * static_cast<float>(ypos)) / static_cast<float>(height);
-                
-                glm::vec4 rayStart_NDC(ndcX, ndcY, -1.0f, 1.0f);
-                glm::vec4 rayEnd_NDC(ndcX, ndcY, 0.0f, 1.0f);
-                
-                glm::mat4 invVP          = glm::inverse(m_Camera.GetProjectionMatrix() * m_Camera.GetViewMatrix());
-                glm::vec4 rayStart_World = invVP * rayStart_NDC;
-                glm::vec4 rayEnd_World   = invVP * rayEnd_NDC;
-                
-                rayStart_World /= rayStart_World.w;
-                rayEnd_World   /= rayEnd_World.w;
-                
-                glm::vec3 rayDir    = glm::normalize(glm::vec3(rayEnd_World - rayStart_World));
-                glm::vec3 rayOrigin = glm::vec3(rayStart_World);
-                
-                float closestDistance  = std::numeric_limits<float>::max();
-                int closestObjectIndex = -1;
-                
-                if (m_BlackHoleInitialized)
-                {
-                    glm::vec3 oc       = rayOrigin - m_BlackHole.m_Centre;
-                    float a            = glm::dot(rayDir, rayDir);
-                    float b            = 2.0f * glm::dot(oc, rayDir);
-                    float c            = glm::dot(oc, oc) - m_BlackHole.m_Radius * m_BlackHole.m_Radius;
-                    float discriminant = b * b - 4 * a * c;
-                    
-                    if (discriminant > 0)
-                    {
-                        float t1 = (-b - sqrt(discriminant)) / (2.0f * a);
-                        float t2 = (-b + sqrt(discriminant)) / (2.0f * a);
-                        
-                        if (t1 > 0 && t1 < closestDistance)
-                        {
-                            closestDistance = t1;
-                            closestObjectIndex = -2;
-                        }
-                        else if (t2 > 0 && t2 < closestDistance)
-                        {
-                            closestDistance = t2;
-                            closestObjectIndex = -2;
-                        }
-                    }
-                }
-                
-                for (size_t i = 0; i < m_Scene.objs.size(); ++i)
-                {
-                    const Object& obj = m_Scene.objs[i];
-                    
-                    glm::vec3 oc       = rayOrigin - obj.m_Centre;
-                    float a            = glm::dot(rayDir, rayDir);
-                    float b            = 2.0f * glm::dot(oc, rayDir);
-                    float c            = glm::dot(oc, oc) - obj.m_Radius * obj.m_Radius;
-                    float discriminant = b * b - 4 * a * c;
-                    
-                    if (discriminant > 0)
-                    {
-                        float t1 = (-b - sqrt(discriminant)) / (2.0f * a);
-                        float t2 = (-b + sqrt(discriminant)) / (2.0f * a);
-                        
-                        if (t1 > 0 && t1 < closestDistance)
-                        {
-                            closestDistance = t1;
-                            closestObjectIndex = static_cast<int>(i);
-                        }
-                        else if (t2 > 0 && t2 < closestDistance)
-                        {
-                            closestDistance = t2;
-                            closestObjectIndex = static_cast<int>(i);
-                        }
-                    }
-                }
+                bool hitBlackHole      = false;
+                int closestObjectIndex = PickObject(xpos, ypos, hitBlackHole);
+                if (hitBlackHole)
+                    closestObjectIndex = -2;
                 
                 if (closestObjectIndex >= 0)
                 {
@@ -331,7 +324,7 @@ namespace Donut
         
                  if (ImGui::CollapsingHeader("Scene Info"))
          {
-            ImGui::Text("Objects in scene: %zu/16 (+ 1 black hole)", m_Scene.objs.size());
+            ImGui::Text("Objects in scene: %zu (+ 1 black hole)", m_Scene.objs.size());
             
             ImGui::Separator();
             ImGui::TextColored(ImVec4(0.9f, 0.9f, 1.0f, 1.0f), "Camera Info:");
@@ -382,7 +375,7 @@ namespace Donut
             ImGui::TextColored(ImVec4(0.9f, 0.9f, 1.0f, 1.0f), "New Sphere");
             ImGui::Separator();
             
-            ImGui::TextColored(ImVec4(0.8f, 0.8f, 0.8f, 1.0f), "Objects: %zu/16", m_Scene.objs.size());
+            ImGui::TextColored(ImVec4(0.8f, 0.8f, 0.8f, 1.0f), "Objects: %zu", m_Scene.objs.size());
             
             ImGui::Text("Position:");
             ImGui::DragFloat3("##Position", &m_NewObjectPosition.x, 0.1f);
@@ -401,17 +394,8 @@ namespace Donut
             
             ImGui::Spacing();
             
-            if (m_Scene.objs.size() >= 16)
-            {
-                ImGui::PushStyleVar(ImGuiStyleVar_Alpha, 0.5f);
-                ImGui::Button("Add Sphere (Limit Reached)", ImVec2(ImGui::GetWindowWidth() - 20, 30));
-                ImGui::PopStyleVar();
-            }
-            else
-            {
-                if (ImGui::Button("Add Sphere", ImVec2(ImGui::GetWindowWidth() - 20, 30)))
-                    AddSphere();
-            }
+            if (ImGui::Button("Add Sphere", ImVec2(ImGui::GetWindowWidth() - 20, 30)))
+                AddSphere();
         }
         
         ImGui::Spacing();
@@ -488,6 +472,44 @@ namespace Donut
 
         ImGui::Spacing();
 
+        if (ImGui::CollapsingHeader("Sphere Rendering"))
+        {
+            ImGui::Checkbox("Ray-cast Impostors", &m_UseSphereImpostors);
+
+            ImGui::Spacing();
+            ImGui::Text("Impostors: %zu", m_ImpostorCount);
+            for (uint32_t lod = 0; lod < SphereLODCount; ++lod)
+                ImGui::Text("Mesh LOD %u (%u segments): %zu", lod, SphereLODSegments[lod], m_SphereLODCounts[lod]);
+
+            ImGui::Spacing();
+            ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "Selected spheres always use the mesh path for their outline");
+        }
+
+        ImGui::Spacing();
+
+        if (ImGui::CollapsingHeader("CPU Preview"))
+        {
+            ImGui::Checkbox("Ray-traced CPU Preview", &m_ShowCPUPreview);
+
+            if (m_PreviewRenderer.IsActive())
+            {
+                char progress[32];
+                std::snprintf(progress, sizeof(progress), "%.0f%%", m_PreviewRenderer.GetProgress() * 100.0f);
+                ImGui::ProgressBar(m_PreviewRenderer.GetProgress(), ImVec2(-1.0f, 0.0f), progress);
+                ImGui::Text("%ux%u in %ux%u tiles", m_PreviewRenderer.GetWidth(), m_PreviewRenderer.GetHeight(),
+                            PreviewRenderer::TileSize, PreviewRenderer::TileSize);
+
+                if (m_PreviewRenderer.IsComplete() && ImGui::Button("Save Reference Image"))
+                    PreviewRenderer::SaveImage(PreviewImagePath, m_PreviewRenderer.GetPixels(),
+                                               m_PreviewRenderer.GetWidth(), m_PreviewRenderer.GetHeight());
+            }
+
+            ImGui::Spacing();
+            ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "Traced on the job system; saves to %s", PreviewImagePath);
+        }
+
+        ImGui::Spacing();
+
         if (ImGui::CollapsingHeader("Selection Outline"))
         {
             ImGui::TextColored(ImVec4(0.9f, 0.9f, 1.0f, 1.0f), "Outline Settings:");
@@ -521,10 +543,6 @@ namespace Donut
             ImGui::Text("Grid Size:");
             ImGui::SliderFloat("##GridSize", &m_GridSize, 1.0f, 500.0f, "%.1f");
 
-            ImGui::Spacing();
-            if (ImGui::Button("Regenerate Grid", ImVec2(ImGui::GetWindowWidth() - 20, 25)))
-                InitializeGridGeometry();
-
             ImGui::Spacing();
             ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "Reference grid for spatial orientation");
         }
@@ -559,9 +577,21 @@ namespace Donut
             {
                 auto& hdriManager = HDRIManager::Get();
                 hdriManager.SetCurrentHDRI(availableHDRI[selectedHDRI]);
-                m_HDRIEnvironment = hdriManager.GetCurrentHDRI();
             }
 
+            if (hdriManager.IsLoading())
+            {
+                const char* stage = hdriManager.IsDecoding() ? "Decoding..." : "Uploading...";
+                ImGui::ProgressBar(hdriManager.GetLoadingProgress(), ImVec2(-1.0f, 0.0f), stage);
+            }
+
+            const auto& hdriStats = hdriManager.GetStats();
+            ImGui::Text("Cache: %u resident, %.0f / %.0f MB", hdriStats.ResidentCount,
+                        hdriStats.ResidentBytes / (1024.0 * 1024.0), hdriManager.GetMemoryBudget() / (1024.0 * 1024.0));
+            ImGui::Text("Hits: %llu  Misses: %llu  Evictions: %llu",
+                        static_cast<unsigned long long>(hdriStats.Hits), static_cast<unsigned long long>(hdriStats.Misses),
+                        static_cast<unsigned long long>(hdriStats.Evictions));
+
             ImGui::Spacing();
             ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "HDRI provides background skybox and lighting for the scene");
             ImGui::PopID();
@@ -571,6 +601,10 @@ namespace Donut
         ImGui::Separator();
         ImGui::Spacing();
         
+        ImGui::Text("Scene File (.json or .dscene):");
+        ImGui::SetNextItemWidth(ImGui::GetWindowWidth() - 20);
+        ImGui::InputText("##ScenePath", m_ScenePath, sizeof(m_ScenePath));
+        
         float buttonWidth = (ImGui::GetWindowWidth() - 30) / 2.0f;
         
         if (ImGui::Button("Save Scene", ImVec2(buttonWidth, 30)))
@@ -614,12 +648,12 @@ namespace Donut
                       objectTransform = glm::translate(objectTransform, selectedObj.m_Centre);
                       objectTransform = glm::scale(objectTransform, glm::vec3(selectedObj.m_Radius));
             
-            DONUT_INFO("Object position: ({}, {}, {})", selectedObj.m_Centre.x, selectedObj.m_Centre.y, selectedObj.m_Centre.z);
+            DONUT_INFO_LIMITED(2, "Object position: ({}, {}, {})", selectedObj.m_Centre.x, selectedObj.m_Centre.y, selectedObj.m_Centre.z);
             glm::vec3 cameraPos = m_Camera.GetOrbitalPosition();
-            DONUT_INFO("Camera position: ({}, {}, {})", cameraPos.x, cameraPos.y, cameraPos.z);
+            DONUT_INFO_LIMITED(2, "Camera position: ({}, {}, {})", cameraPos.x, cameraPos.y, cameraPos.z);
             
             glm::vec3 viewTranslation = glm::vec3(view[3][0], view[3][1], view[3][2]);
-            DONUT_INFO("View translation: ({}, {}, {})", viewTranslation.x, viewTranslation.y, viewTranslation.z);
+            DONUT_INFO_LIMITED(2, "View translation: ({}, {}, {})", viewTranslation.x, viewTranslation.y, viewTranslation.z);
             
             ImGuizmo::SetDrawlist(ImGui::GetForegroundDrawList());
             if (ImGuizmo::Manipulate(glm::value_ptr(view), glm::value_ptr(projection), 
@@ -638,20 +672,14 @@ namespace Donut
                 );
                 selectedObj.m_Radius = (scale.x + scale.y + scale.z) / 3.0f;
                 
-                DONUT_INFO("Matrix [3]: ({}, {}, {}, {})", objectTransform[3][0], objectTransform[3][1], objectTransform[3][2], objectTransform[3][3]);
-                DONUT_INFO("New position: ({}, {}, {})", newPosition.x, newPosition.y, newPosition.z);
+                DONUT_INFO_LIMITED(2, "Matrix [3]: ({}, {}, {}, {})", objectTransform[3][0], objectTransform[3][1], objectTransform[3][2], objectTransform[3][3]);
+                DONUT_INFO_LIMITED(2, "New position: ({}, {}, {})", newPosition.x, newPosition.y, newPosition.z);
             }
         }
     }
     
     void WorldBuilderState::AddSphere()
     {
-        if (m_Scene.objs.size() >= 16)
-        {
-            DONUT_WARN("Cannot add more objects. Maximum of 16 objects reached.");
-            return;
-        }
-        
         Material material(m_NewObjectColor, m_NewObjectSpecular, m_NewObjectEmission);
         Object   sphere(m_NewObjectPosition, m_NewObjectRadius, material);
         m_Scene.objs.push_back(sphere);
@@ -686,319 +714,284 @@ namespace Donut
     
     void WorldBuilderState::SaveScene()
     {
-        nlohmann::json sceneData;
-        sceneData["objects"] = nlohmann::json::array();
-
-        for (const auto& obj : m_Scene.objs)
-        {
-            nlohmann::json sphereData;
-            sphereData["position"] = 
-            { 
-                obj.m_Centre.x, 
-                obj.m_Centre.y, 
-                obj.m_Centre.z 
-            };
-
-            sphereData["color"] = 
-            {
-                obj.m_Material.m_Color.x, 
-                obj.m_Material.m_Color.y, 
-                obj.m_Material.m_Color.z
-            };
-
-            sphereData["radius"]  = obj.m_Radius;
-            sphereData["specular"] = obj.m_Material.m_Specular;
-            sphereData["emission"] = obj.m_Material.m_Emission;
-            sceneData["objects"].push_back(sphereData);
-        }
-
-        std::ofstream file("Scene.json");
-        if (file.is_open())
-        {
-            file << sceneData.dump(4);
-            file.close();
-            DONUT_INFO("Scene saved to Scene.json (black hole always present at center)");
-        }
-        else
-            DONUT_ERROR("Failed to save scene");
+        if (SceneSerializer::Save(m_Scene, m_ScenePath))
+            DONUT_INFO("Black hole is not stored; it is always present at the center");
     }
     
     void WorldBuilderState::LoadScene()
     {
-        std::ifstream file("Scene.json");
-        if (file.is_open())
-        {
-            m_Scene.objs.clear();
-            m_SelectedObjectIndex = -1;
-            
-            nlohmann::json sceneData;
-            file >> sceneData;
+        Scene loaded;
+        if (!SceneSerializer::Load(loaded, m_ScenePath))
+            return;
+        
+        m_Scene.objs          = std::move(loaded.objs);
+        m_SelectedObjectIndex = -1;
+        m_HoveredObjectIndex  = -1;
+    }
+    
+    void WorldBuilderState::RenderScene(const ViewFrame& frame)
+    {
+        RenderCommand::SetViewport(0, 0, frame.Width, frame.Height);
+        RenderCommand::EnableDepthTest();
+        
+        glm::mat4 viewProjection = frame.Projection * frame.View;
+        
+        m_SphereShader->Bind();
+        m_SphereShader->SetMat4("u_ViewProjection", viewProjection);
+        m_SphereShader->SetFloat3("u_LightPos",  frame.LightPos);
+        m_SphereShader->SetFloat3("u_CameraPos", frame.CameraPos);
 
-            if (sceneData.contains("objects"))
-            {
-                for (const auto& sphereData : sceneData["objects"])
-                {
-                    glm::vec3 position;
-                    glm::vec3 color;
-                    float radius;
-                    float specular;
-                    float emission;
-                    
-                    auto posArray = sphereData["position"];
-                    position.x = posArray[0].get<float>();
-                    position.y = posArray[1].get<float>();
-                    position.z = posArray[2].get<float>();
-                    
-                    auto colorArray = sphereData["color"];
-                    color.x = colorArray[0].get<float>();
-                    color.y = colorArray[1].get<float>();
-                    color.z = colorArray[2].get<float>();
-                    
-                    radius   = sphereData["radius"].get<float>();
-                    specular = sphereData["specular"].get<float>();
-                    emission = sphereData["emission"].get<float>();
-                    
-                    Material material(color, specular, emission);
-                    Object   sphere(position, radius, material);
-                    m_Scene.objs.push_back(sphere);
-                }
-            }
+        m_SphereShader->SetFloat3("u_OutlineColor", frame.OutlineColor);
+        
+        if (frame.Environment)
+        {
+            frame.Environment->Bind(1);
+            m_SphereShader->SetInt("u_HDRIEnvironment", 1);
+        }
+        
+        for (uint32_t lod = 0; lod < SphereLODCount; ++lod)
+            m_SphereLODBatches[lod].Draw(frame.SphereLODs[lod]);
+        
+        if (!frame.Impostors.empty() && m_ImpostorShader)
+        {
+            m_ImpostorShader->Bind();
+            m_ImpostorShader->SetMat4("u_ViewProjection", viewProjection);
+            m_ImpostorShader->SetFloat3("u_LightPos",  frame.LightPos);
+            m_ImpostorShader->SetFloat3("u_CameraPos", frame.CameraPos);
+            if (frame.Environment)
+                m_ImpostorShader->SetInt("u_HDRIEnvironment", 1);
             
-            file.close();
-            DONUT_INFO("Scene loaded from Scene.json (black hole remains at center)");
+            m_ImpostorBatch.Draw(frame.Impostors);
         }
-        else
-            DONUT_ERROR("Failed to load scene");
+        
+        RenderCommand::DisableDepthTest();
     }
     
-    void WorldBuilderState::InitializeSphereGeometry()
+
+    
+    void WorldBuilderState::UpdatePreview()
     {
-        std::vector<float> vertices;
-        std::vector<uint32_t> indices;
+        if (!m_ShowCPUPreview)
+        {
+            m_PreviewRenderer.Cancel();
+            return;
+        }
         
-        const int segments = 32;
-        const int rings = 16;
+        GLFWwindow* window = static_cast<GLFWwindow*>(Application::Get().GetWindow().GetNativeWindow());
+        int width, height;
+        glfwGetFramebufferSize(window, &width, &height);
         
-        for (int ring = 0; ring <= rings; ++ring)
+        glm::mat4 view       = m_Camera.GetViewMatrix();
+        glm::mat4 projection = m_Camera.GetProjectionMatrix();
+        
+        // FNV-1a over everything the traced image depends on
+        uint64_t signature = 14695981039346656037ull;
+        auto hash = [&signature](const void* data, size_t size)
         {
-            float phi = static_cast<float>(std::numbers::pi) * ring / rings;
-            float sinPhi = sin(phi);
-            float cosPhi = cos(phi);
-            
-            for (int segment = 0; segment <= segments; ++segment)
-            {
-                float theta = 2.0f * static_cast<float>(std::numbers::pi) * segment / segments;
-                float sinTheta = sin(theta);
-                float cosTheta = cos(theta);
-                
-                float x = cosTheta * sinPhi;
-                float y = cosPhi;
-                float z = sinTheta * sinPhi;
-                
-                float nx = x;
-                float ny = y;
-                float nz = z;
-                
-                vertices.push_back(x);
-                vertices.push_back(y);
-                vertices.push_back(z);
-                vertices.push_back(nx);
-                vertices.push_back(ny);
-                vertices.push_back(nz);
-            }
+            const uint8_t* bytes = static_cast<const uint8_t*>(data);
+            for (size_t i = 0; i < size; ++i)
+                signature = (signature ^ bytes[i]) * 1099511628211ull;
+        };
+        hash(&view, sizeof(view));
+        hash(&projection, sizeof(projection));
+        hash(&width, sizeof(width));
+        hash(&height, sizeof(height));
+        hash(&m_Scene.m_LightPos, sizeof(m_Scene.m_LightPos));
+        for (const auto& obj : m_Scene.objs)
+        {
+            hash(&obj.m_Centre, sizeof(obj.m_Centre));
+            hash(&obj.m_Radius, sizeof(obj.m_Radius));
+            hash(&obj.m_Material.m_Color, sizeof(obj.m_Material.m_Color));
         }
         
-        for (int ring = 0; ring < rings; ++ring)
+        if (signature != m_PreviewSignature || !m_PreviewRenderer.IsActive())
         {
-            for (int segment = 0; segment < segments; ++segment)
-            {
-                uint32_t first = ring * (segments + 1) + segment;
-                uint32_t second = first + segments + 1;
-                
-                indices.push_back(first);
-                indices.push_back(second);
-                indices.push_back(first + 1);
-                
-                indices.push_back(second);
-                indices.push_back(second + 1);
-                indices.push_back(first + 1);
-            }
+            Scene preview = m_Scene;
+            if (m_BlackHoleInitialized)
+                preview.objs.push_back(m_BlackHole);
+            
+            m_PreviewRenderer.Start(std::move(preview), view, projection, static_cast<uint32_t>(width), static_cast<uint32_t>(height));
+            m_PreviewSignature = signature;
         }
+    }
+    
+    void WorldBuilderState::RenderPreview(const ViewFrame& frame, const Ref<Texture2D>& texture)
+    {
+        RenderCommand::SetViewport(0, 0, frame.Width, frame.Height);
+        RenderCommand::DisableDepthTest();
         
-        auto vertexBuffer = Ref<VertexBuffer>(VertexBuffer::Create(vertices.data(), static_cast<uint32_t>(vertices.size() * sizeof(float))));
-        VertexBufferLayout layout;
-        layout.Push<float>(3);
-        layout.Push<float>(3);
-        vertexBuffer->SetLayout(layout);
-        
-        auto indexBuffer = Ref<IndexBuffer>(IndexBuffer::Create(indices.data(), static_cast<uint32_t>(indices.size())));
+        m_PreviewShader->Bind();
+        m_PreviewQuad->Bind();
+        texture->Bind(0);
+        m_PreviewShader->SetInt("u_ScreenTexture", 0);
         
-        m_SphereVAO = Ref<VertexArray>(VertexArray::Create());
-        m_SphereVAO->AddVertexBuffer(vertexBuffer);
-        m_SphereVAO->SetIndexBuffer(indexBuffer);
+        RenderCommand::DrawArrays(6);
     }
     
-    void WorldBuilderState::RenderScene()
+    int WorldBuilderState::PickObject(double xpos, double ypos, bool& hitBlackHole) const
     {
+        hitBlackHole = false;
+        
         GLFWwindow* window = static_cast<GLFWwindow*>(Application::Get().GetWindow().GetNativeWindow());
         int width, height;
         glfwGetFramebufferSize(window, &width, &height);
-
-        RenderCommand::SetViewport(0, 0, width, height);
-        RenderCommand::EnableDepthTest();
+        if (width <= 0 || height <= 0)
+            return -1;
         
-        glm::mat4 view           = m_Camera.GetViewMatrix();
-        glm::mat4 projection     = m_Camera.GetProjectionMatrix();
-        glm::mat4 viewProjection = projection * view;
+        float ndcX = (2.0f * static_cast<float>(xpos)) / static_cast<float>(width) - 1.0f;
+        float ndcY = 1.0f - (2.0f * static_cast<float>(ypos)) / static_cast<float>(height);
         
-        glm::vec3 lightPos  = m_Scene.m_LightPos;
-        glm::vec3 cameraPos = m_Camera.GetOrbitalPosition();
+        glm::vec4 rayStart_NDC(ndcX, ndcY, -1.0f, 1.0f);
+        glm::vec4 rayEnd_NDC(ndcX, ndcY, 0.0f, 1.0f);
         
-        m_SphereShader->Bind();
-        m_SphereShader->SetMat4("u_ViewProjection", viewProjection);
-        m_SphereShader->SetFloat3("u_LightPos",  lightPos);
-        m_SphereShader->SetFloat3("u_CameraPos", cameraPos);
-
-        m_SphereShader->SetFloat3("u_OutlineColor", m_OutlineColor);
-        m_SphereShader->SetFloat("u_OutlineWidth",  m_OutlineWidth);
+        glm::mat4 invVP          = glm::inverse(m_Camera.GetProjectionMatrix() * m_Camera.GetViewMatrix());
+        glm::vec4 rayStart_World = invVP * rayStart_NDC;
+        glm::vec4 rayEnd_World   = invVP * rayEnd_NDC;
+        
+        rayStart_World /= rayStart_World.w;
+        rayEnd_World   /= rayEnd_World.w;
         
-        if (m_HDRIEnvironment)
+        Ray ray(glm::vec3(rayStart_World), glm::vec3(rayEnd_World - rayStart_World));
+        
+        float closestDistance = std::numeric_limits<float>::max();
+        int   closestIndex    = -1;
+        
+        float t;
+        int   index;
+        if (m_Scene.Intersect(ray, t, index))
         {
-            m_HDRIEnvironment->Bind(1);
-            m_SphereShader->SetInt("u_HDRIEnvironment", 1);
+            closestDistance = t;
+            closestIndex    = index;
         }
         
-        if (m_BlackHoleInitialized)
+        if (m_BlackHoleInitialized && m_BlackHole.Intersect(ray, t) && t < closestDistance)
         {
-            glm::mat4 blackHoleTransform = glm::translate(glm::mat4(1.0f), m_BlackHole.m_Centre);
-                      blackHoleTransform = glm::scale(blackHoleTransform, glm::vec3(m_BlackHole.m_Radius));
-            
-            m_SphereShader->SetMat4("u_Transform", blackHoleTransform);
-            m_SphereShader->SetInt("u_IsSelected", 1);
-            m_SphereShader->SetFloat3("u_Color", m_BlackHole.m_Material.m_Color);
-            m_SphereShader->SetFloat("u_Emission", m_BlackHole.m_Material.m_Emission);
-            m_SphereShader->SetFloat("u_Specular", m_BlackHole.m_Material.m_Specular);
-            m_SphereShader->SetFloat("u_OutlineWidth", 0.3f);
+            hitBlackHole = true;
+            return -1;
+        }
+        
+        return closestIndex;
+    }
+    
+    void WorldBuilderState::GatherSphereInstances(ViewFrame& frame) const
+    {
+        glm::vec3 cameraPos  = frame.CameraPos;
+        float     pixelScale = frame.Projection[1][1] * static_cast<float>(frame.Height) * 0.5f;
+        
+        auto submit = [&](const SphereInstance& instance, bool outlined)
+        {
+            if (m_UseSphereImpostors && !outlined)
+            {
+                frame.Impostors.push_back(instance);
+                return;
+            }
             
-            m_SphereVAO->Bind();
-            RenderCommand::DrawIndexed(m_SphereVAO);
+            float distance     = std::max(glm::length(glm::vec3(instance.CentreRadius) - cameraPos), 1e-4f);
+            float screenRadius = instance.CentreRadius.w / distance * pixelScale;
             
-            m_SphereShader->SetFloat("u_OutlineWidth", m_OutlineWidth);
+            uint32_t lod = 0;
+            while (lod + 1 < SphereLODCount && screenRadius > SphereLODMaxPixels[lod])
+                ++lod;
+            frame.SphereLODs[lod].push_back(instance);
+        };
+        
+        if (m_BlackHoleInitialized)
+        {
+            const auto& material = m_BlackHole.m_Material;
+            submit(
+            {
+                glm::vec4(m_BlackHole.m_Centre, m_BlackHole.m_Radius),
+                glm::vec4(material.m_Color, material.m_Specular),
+                glm::vec4(material.m_Emission, 1.0f, 0.3f, 0.0f)
+            }, true);
         }
         
         for (size_t i = 0; i < m_Scene.objs.size(); ++i)
         {
             const auto& obj = m_Scene.objs[i];
-            
-            glm::mat4 transform = glm::translate(glm::mat4(1.0f), obj.m_Centre);
-                      transform = glm::scale(transform, glm::vec3(obj.m_Radius));
-            
-            m_SphereShader->SetMat4("u_Transform", transform);
-            
             bool isSelected = (m_SelectedObjectIndex == static_cast<int>(i));
-            m_SphereShader->SetInt("u_IsSelected", isSelected ? 1 : 0);
+            
+            glm::vec3 color    = obj.m_Material.m_Color;
+            float     emission = obj.m_Material.m_Emission;
             if (isSelected)
             {
-                glm::vec3 highlightColor = obj.m_Material.m_Color * 1.5f;
-                highlightColor = glm::clamp(highlightColor, 0.0f, 1.0f);
-                m_SphereShader->SetFloat3("u_Color", highlightColor);
-                m_SphereShader->SetFloat("u_Emission", 0.2f);
+                color    = glm::clamp(color * 1.5f, 0.0f, 1.0f);
+                emission = 0.2f;
             }
-            else
+            else if (m_HoveredObjectIndex == static_cast<int>(i))
             {
-                m_SphereShader->SetFloat3("u_Color", obj.m_Material.m_Color);
-                m_SphereShader->SetFloat("u_Emission", obj.m_Material.m_Emission);
+                color    = glm::clamp(color * 1.25f, 0.0f, 1.0f);
+                emission = std::max(emission, 0.1f);
             }
             
-            m_SphereShader->SetFloat("u_Specular", obj.m_Material.m_Specular);
-            
-            m_SphereVAO->Bind();
-            RenderCommand::DrawIndexed(m_SphereVAO);
+            submit(
+            {
+                glm::vec4(obj.m_Centre, obj.m_Radius),
+                glm::vec4(color, obj.m_Material.m_Specular),
+                glm::vec4(emission, isSelected ? 1.0f : 0.0f, m_OutlineWidth, 0.0f)
+            }, isSelected);
         }
-        
-        RenderCommand::DisableDepthTest();
     }
     
-
+    void WorldBuilderState::SphereBatch::SetMesh(const Ref<VertexArray>& mesh)
+    {
+        if (Mesh == mesh)
+            return;
+        
+        Mesh = mesh;
+        Instanced.reset();
+        InstanceBuffer.reset();
+        Capacity = 0;
+    }
     
-    void WorldBuilderState::InitializeSkyboxGeometry()
+    void WorldBuilderState::SphereBatch::Draw(const std::vector<SphereInstance>& instances)
     {
-        float skyboxVertices[] = 
+        if (instances.empty() || !Mesh)
+            return;
+        
+        uint32_t count = static_cast<uint32_t>(instances.size());
+        if (count > Capacity)
         {
-            -1.0f,  1.0f, -1.0f,
-            -1.0f, -1.0f, -1.0f,
-             1.0f, -1.0f, -1.0f,
-             1.0f, -1.0f, -1.0f,
-             1.0f,  1.0f, -1.0f,
-            -1.0f,  1.0f, -1.0f,
-
-            -1.0f, -1.0f,  1.0f,
-            -1.0f, -1.0f, -1.0f,
-            -1.0f,  1.0f, -1.0f,
-            -1.0f,  1.0f, -1.0f,
-            -1.0f,  1.0f,  1.0f,
-            -1.0f, -1.0f,  1.0f,
-
-             1.0f, -1.0f, -1.0f,
-             1.0f, -1.0f,  1.0f,
-             1.0f,  1.0f,  1.0f,
-             1.0f,  1.0f,  1.0f,
-             1.0f,  1.0f, -1.0f,
-             1.0f, -1.0f, -1.0f,
-
-            -1.0f, -1.0f,  1.0f,
-            -1.0f,  1.0f,  1.0f,
-             1.0f,  1.0f,  1.0f,
-             1.0f,  1.0f,  1.0f,
-             1.0f, -1.0f,  1.0f,
-            -1.0f, -1.0f,  1.0f,
-
-            -1.0f,  1.0f, -1.0f,
-             1.0f,  1.0f, -1.0f,
-             1.0f,  1.0f,  1.0f,
-             1.0f,  1.0f,  1.0f,
-            -1.0f,  1.0f,  1.0f,
-            -1.0f,  1.0f, -1.0f,
-
-            -1.0f, -1.0f, -1.0f,
-            -1.0f, -1.0f,  1.0f,
-             1.0f, -1.0f, -1.0f,
-             1.0f, -1.0f, -1.0f,
-            -1.0f, -1.0f,  1.0f,
-             1.0f, -1.0f,  1.0f
-        };
-
-        auto vertexBuffer = Ref<VertexBuffer>(VertexBuffer::Create(skyboxVertices, sizeof(skyboxVertices)));
-        VertexBufferLayout layout;
-        layout.Push<float>(3);
-        vertexBuffer->SetLayout(layout);
-
-        m_SkyboxVAO = Ref<VertexArray>(VertexArray::Create());
-        m_SkyboxVAO->AddVertexBuffer(vertexBuffer);
+            // Grow geometrically so adding objects one at a time doesn't reallocate every frame
+            Capacity       = std::max(count, std::max(64u, Capacity * 2));
+            InstanceBuffer = Ref<VertexBuffer>(VertexBuffer::Create(Capacity * static_cast<uint32_t>(sizeof(SphereInstance))));
+            
+            VertexBufferLayout layout;
+            layout.Push<float>(4);
+            layout.Push<float>(4);
+            layout.Push<float>(4);
+            layout.SetInstanceStepRate(1);
+            InstanceBuffer->SetLayout(layout);
+            
+            // Instance attributes take the locations after the mesh's own
+            Instanced = Ref<VertexArray>(VertexArray::Create());
+            for (const auto& vertexBuffer : Mesh->GetVertexBuffers())
+                Instanced->AddVertexBuffer(vertexBuffer);
+            Instanced->AddVertexBuffer(InstanceBuffer);
+            Instanced->SetIndexBuffer(Mesh->GetIndexBuffer());
+        }
+        
+        InstanceBuffer->SetData(instances.data(), count * static_cast<uint32_t>(sizeof(SphereInstance)));
+        
+        Instanced->Bind();
+        RenderCommand::DrawIndexedInstanced(Instanced, count);
     }
     
-    void WorldBuilderState::RenderSkybox()
+    void WorldBuilderState::RenderSkybox(const ViewFrame& frame)
     {
-        if (!m_SkyboxShader || !m_SkyboxVAO || !m_HDRIEnvironment)
+        if (!m_SkyboxShader || !m_SkyboxVAO || !frame.Environment)
             return;
         
-        GLFWwindow* window = static_cast<GLFWwindow*>(Application::Get().GetWindow().GetNativeWindow());
-        int width, height;
-        glfwGetFramebufferSize(window, &width, &height);
-
-        RenderCommand::SetViewport(0, 0, width, height);
+        RenderCommand::SetViewport(0, 0, frame.Width, frame.Height);
         RenderCommand::DisableDepthTest();
         
-        glm::mat4 view = m_Camera.GetViewMatrix();
-        glm::mat4 projection = m_Camera.GetProjectionMatrix();
-        
-        view = glm::mat4(glm::mat3(view));
+        glm::mat4 view = glm::mat4(glm::mat3(frame.View));
         
         m_SkyboxShader->Bind();
         m_SkyboxShader->SetMat4("u_View", view);
-        m_SkyboxShader->SetMat4("u_Projection", projection);
+        m_SkyboxShader->SetMat4("u_Projection", frame.Projection);
         
-        m_HDRIEnvironment->Bind(0);
+        frame.Environment->Bind(0);
         m_SkyboxShader->SetInt("u_Skybox", 0);
         
         m_SkyboxVAO->Bind();
@@ -1007,97 +1000,25 @@ namespace Donut
         RenderCommand::EnableDepthTest();
     }
     
-    void WorldBuilderState::InitializeGridGeometry()
-    {
-        if (m_GridVAO)
-        {
-            m_GridVAO->Unbind();
-            m_GridVAO.reset();
-        }
-        
-        const float gridSize = 50.0f;
-        const int gridLines = 101;
-        const float halfSize = gridSize * 0.5f;
-        const float step = gridSize / (gridLines - 1);
-        
-        std::vector<float> vertices;
-        std::vector<uint32_t> indices;
-        
-        for (int i = 0; i < gridLines; ++i)
-        {
-            float z = -halfSize + i * step;
-            
-            vertices.push_back(-halfSize);
-            vertices.push_back(0.0f);
-            vertices.push_back(z);
-            
-            vertices.push_back(halfSize);
-            vertices.push_back(0.0f);
-            vertices.push_back(z);
-            
-            uint32_t baseIndex = static_cast<uint32_t>(vertices.size() / 3) - 2;
-            indices.push_back(baseIndex);
-            indices.push_back(baseIndex + 1);
-        }
-        
-        for (int i = 0; i < gridLines; ++i)
-        {
-            float x = -halfSize + i * step;
-            
-            vertices.push_back(x);
-            vertices.push_back(0.0f);
-            vertices.push_back(-halfSize);
-            
-            vertices.push_back(x);
-            vertices.push_back(0.0f);
-            vertices.push_back(halfSize);
-            
-            uint32_t baseIndex = static_cast<uint32_t>(vertices.size() / 3) - 2;
-            indices.push_back(baseIndex);
-            indices.push_back(baseIndex + 1);
-        }
-        
-        auto vertexBuffer = Ref<VertexBuffer>(VertexBuffer::Create(vertices.data(), static_cast<uint32_t>(vertices.size() * sizeof(float))));
-        VertexBufferLayout layout;
-        layout.Push<float>(3);
-        vertexBuffer->SetLayout(layout);
-        
-        auto indexBuffer = Ref<IndexBuffer>(IndexBuffer::Create(indices.data(), static_cast<uint32_t>(indices.size())));
-        
-        m_GridVAO = Ref<VertexArray>(VertexArray::Create());
-        m_GridVAO->AddVertexBuffer(vertexBuffer);
-        m_GridVAO->SetIndexBuffer(indexBuffer);
-        
-        m_GridVAO->Unbind();
-    }
-    
-    void WorldBuilderState::RenderGrid()
+    void WorldBuilderState::RenderGrid(const ViewFrame& frame)
     {
         if (!m_GridShader || !m_GridVAO)
             return;
         
-        GLFWwindow* window = static_cast<GLFWwindow*>(Application::Get().GetWindow().GetNativeWindow());
-        int width, height;
-        glfwGetFramebufferSize(window, &width, &height);
-
-        RenderCommand::SetViewport(0, 0, width, height);
+        RenderCommand::SetViewport(0, 0, frame.Width, frame.Height);
         RenderCommand::EnableDepthTest();
         RenderCommand::EnableBlending();
         
-        glm::mat4 view = m_Camera.GetViewMatrix();
-        glm::mat4 projection = m_Camera.GetProjectionMatrix();
-        glm::mat4 viewProjection = projection * view;
+        glm::mat4 viewProjection = frame.Projection * frame.View;
         glm::mat4 transform = glm::mat4(1.0f);
         
-        glm::vec3 cameraPos = m_Camera.GetOrbitalPosition();
-        
         m_GridShader->Bind();
         m_GridShader->SetMat4("u_ViewProjection", viewProjection);
         m_GridShader->SetMat4("u_Transform", transform);
-        m_GridShader->SetFloat3("u_GridColor", m_GridColor);
-        m_GridShader->SetFloat("u_GridAlpha", m_GridAlpha);
-        m_GridShader->SetFloat("u_GridSize", m_GridSize);
-        m_GridShader->SetFloat3("u_CameraPos", cameraPos);
+        m_GridShader->SetFloat3("u_GridColor", frame.GridColor);
+        m_GridShader->SetFloat("u_GridAlpha", frame.GridAlpha);
+        m_GridShader->SetFloat("u_GridSize", frame.GridSize);
+        m_GridShader->SetFloat3("u_CameraPos", frame.CameraPos);
         
         m_GridVAO->Bind();
         RenderCommand::DrawLines(m_GridVAO);
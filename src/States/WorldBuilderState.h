@@ -7,6 +7,7 @@
 
 #include "Engine/Scene.h"
 #include "Engine/Object.h"
+#include "Engine/PreviewRenderer.h"
 
 #include "Rendering/Renderer.h"
 #include "Rendering/Shader.h"
@@ -15,6 +16,8 @@
 #include <imgui.h>
 #include <ImGuizmo.h>
 
+#include <array>
+#include <limits>
 #include <vector>
 #include <memory>
 
@@ -26,34 +29,109 @@ namespace Donut
     public:
         ~WorldBuilderState() = default;
         
-        void OnEnter()                 override;
-        void OnExit()                  override;
-        void OnUpdate(float deltaTime) override;
-        void OnRender()                override;
-        void OnImUIRender()            override;
-        void OnEvent(Event& event)     override;
+        void OnEnter()                     override;
+        void OnExit()                      override;
+        void OnUpdate(float deltaTime)     override;
+        void OnRender(FramePacket& packet) override;
+        void OnImUIRender()                override;
+        void OnEvent(Event& event)         override;
     private:
         void AddSphere();
         void RemoveSelectedObject();
         void ClearScene();
         void SaveScene();
         void LoadScene();
-        void RenderScene();
-        void InitializeSphereGeometry();
-        void InitializeGridGeometry();
-        void RenderGrid();
+        void UpdatePreview();
+        
+        // Index into m_Scene.objs under the cursor, or -1; the black hole occludes but can't be picked
+        int  PickObject(double xpos, double ypos, bool& hitBlackHole) const;
     private:
+        // Matches the per-instance attributes in Sphere.glsl and SphereImpostor.glsl
+        struct SphereInstance
+        {
+            glm::vec4 CentreRadius;
+            glm::vec4 ColorSpecular;
+            glm::vec4 Params; // Emission, selected, outline width
+        };
+
+        // One instanced draw of a shared mesh; the instance stream gets its own vertex array
+        // because the registry's meshes are shared with other users
+        struct SphereBatch
+        {
+            Ref<VertexArray>  Mesh;
+            Ref<VertexArray>  Instanced;
+            Ref<VertexBuffer> InstanceBuffer;
+            uint32_t          Capacity = 0;
+
+            void SetMesh(const Ref<VertexArray>& mesh);
+            void Draw(const std::vector<SphereInstance>& instances);
+        };
+
+        // Tessellations for the mesh path, picked by projected radius in pixels
+        static constexpr uint32_t SphereLODCount                     = 3;
+        static constexpr uint32_t SphereLODSegments[SphereLODCount]  = { 16, 32, 64 };
+        static constexpr float    SphereLODMaxPixels[SphereLODCount] = { 48.0f, 160.0f, std::numeric_limits<float>::max() };
+
+        // What the render thread draws for one frame, copied from the editor on the main thread
+        struct ViewFrame
+        {
+            uint32_t  Width  = 0;
+            uint32_t  Height = 0;
+            glm::mat4 View;
+            glm::mat4 Projection;
+            glm::vec3 CameraPos;
+            glm::vec3 LightPos;
+            glm::vec3 OutlineColor;
+
+            bool      ShowGrid  = false;
+            glm::vec3 GridColor;
+            float     GridAlpha = 0.0f;
+            float     GridSize  = 0.0f;
+
+            Ref<CubemapTexture> Environment;
+
+            std::vector<SphereInstance>                             Impostors;
+            std::array<std::vector<SphereInstance>, SphereLODCount> SphereLODs;
+        };
+
+        void GatherSphereInstances(ViewFrame& frame) const;
+        void RenderScene(const ViewFrame& frame);
+        void RenderGrid(const ViewFrame& frame);
+        void RenderSkybox(const ViewFrame& frame);
+        void RenderPreview(const ViewFrame& frame, const Ref<Texture2D>& texture);
+
         Scene  m_Scene;
         Camera m_Camera;
         bool   m_Initialized = false;
+        char   m_ScenePath[512] = {};
         
         Ref<Shader>      m_SphereShader;
-        Ref<VertexArray> m_SphereVAO;
-        Ref<CubemapTexture> m_HDRIEnvironment;
+        Ref<Shader>      m_ImpostorShader;
+        SphereBatch      m_ImpostorBatch;
+        std::array<SphereBatch, SphereLODCount> m_SphereLODBatches;
+        
+        // Impostors cost the same four vertices at any zoom; outlined spheres keep the mesh path
+        bool m_UseSphereImpostors = true;
+
+        // Instance counts from the last gathered frame, for the UI
+        size_t                             m_ImpostorCount   = 0;
+        std::array<size_t, SphereLODCount> m_SphereLODCounts = {};
+
+        // Restarted whenever the camera, viewport or scene changes while it is shown
+        static constexpr const char* PreviewImagePath = "Preview.png";
+
+        PreviewRenderer  m_PreviewRenderer;
+        Ref<Shader>      m_PreviewShader;
+        Ref<VertexArray> m_PreviewQuad;
+        uint64_t         m_PreviewSignature = 0;
+        bool             m_ShowCPUPreview   = false;
         
         Ref<Shader>      m_SkyboxShader;
         Ref<VertexArray> m_SkyboxVAO;
         
+        static constexpr float    GridExtent = 50.0f;
+        static constexpr uint32_t GridLines  = 101;
+
         Ref<Shader>      m_GridShader;
         Ref<VertexArray> m_GridVAO;
         
@@ -64,6 +142,7 @@ namespace Donut
         float     m_NewObjectEmission = 0.0f;
         
         int       m_SelectedObjectIndex = -1;
+        int       m_HoveredObjectIndex  = -1;
         bool      m_CameraDragging      = false;
         glm::vec2 m_LastMousePos        = glm::vec2(0.0f, 0.0f);
         
@@ -86,11 +165,5 @@ namespace Donut
         
         Object m_BlackHole;
         bool   m_BlackHoleInitialized = false;
-        
-        void SetHDRIEnvironment(Ref<CubemapTexture> hdri) { m_HDRIEnvironment = hdri; }
-        Ref<CubemapTexture> GetHDRIEnvironment()    const { return m_HDRIEnvironment; }
-        
-        void InitializeSkyboxGeometry();
-        void RenderSkybox();
     };
 };
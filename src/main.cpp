@@ -1,8 +1,324 @@
 #include "Core/Application.h"
+#include "Core/Camera.h"
+#include "Core/JobSystem.h"
+#include "Engine/SceneSerializer.h"
+#include "Engine/PreviewRenderer.h"
+#include "Engine/NBody.h"
+#include "Engine/Object.h"
 
-int main()
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <limits>
+#include <numbers>
+#include <random>
+#include <string_view>
+
+// The World Builder's default camera; the black hole is added because editor scenes don't store it
+static bool LoadPreviewScene(Donut::Scene& scene, const char* scenePath)
+{
+    if (!Donut::SceneSerializer::Load(scene, scenePath))
+        return false;
+
+    scene.objs.emplace_back(glm::vec3(0.0f), 2.0f, Donut::Material(glm::vec3(0.0f), 0.0f, 0.0f));
+    scene.UpdateBVH();
+    return true;
+}
+
+static Donut::Camera GetPreviewCamera(uint32_t width, uint32_t height)
+{
+    Donut::Camera camera(45.0f, static_cast<float>(width) / height, 0.1f, 1000.0f);
+    camera.SetCameraMode(Donut::CameraMode::Orbital);
+    camera.SetOrbitalRadius(15.0f);
+    camera.SetAzimuth(0.0f);
+    camera.SetElevation(static_cast<float>(std::numbers::pi) / 3.0f);
+    camera.UpdateOrbital();
+    return camera;
+}
+
+static bool RenderPreviewImage(const char* scenePath, const char* imagePath)
+{
+    Donut::Scene scene;
+    if (!LoadPreviewScene(scene, scenePath))
+        return false;
+
+    constexpr uint32_t width  = 1280;
+    constexpr uint32_t height = 720;
+    Donut::Camera camera = GetPreviewCamera(width, height);
+
+    std::vector<uint8_t> pixels;
+    Donut::PreviewRenderer::Render(scene, camera.GetViewMatrix(), camera.GetProjectionMatrix(), width, height, pixels);
+    return Donut::PreviewRenderer::SaveImage(imagePath, pixels, width, height);
+}
+
+// Pre-BVH Scene::Trace: every object for the primary ray and again for the shadow ray
+static glm::vec3 TraceLinear(const Donut::Scene& scene, const Donut::Ray& ray)
+{
+    float closest = std::numeric_limits<float>::infinity();
+    const Donut::Object* hitObj = nullptr;
+    for (const auto& obj : scene.objs)
+    {
+        float t;
+        if (obj.Intersect(ray, t) && t < closest)
+        {
+            closest = t;
+            hitObj  = &obj;
+        }
+    }
+
+    if (!hitObj)
+        return glm::vec3(0.0f, 0.0f, 0.1f);
+
+    glm::vec3 hitPoint = ray.m_Origin + ray.m_Direction * closest;
+    glm::vec3 normal   = hitObj->GetNormal(hitPoint);
+    glm::vec3 lightDir = glm::normalize(scene.m_LightPos - hitPoint);
+    float     diff     = std::max(glm::dot(normal, lightDir), 0.0f);
+
+    Donut::Ray shadowRay(hitPoint + normal * 0.001f, lightDir);
+    for (const auto& obj : scene.objs)
+    {
+        float t;
+        if (obj.Intersect(shadowRay, t))
+            return hitObj->m_Material.m_Color * 0.1f;
+    }
+
+    return hitObj->m_Material.m_Color * (0.1f + diff * 0.9f);
+}
+
+// Times the same view traced one ray at a time and in packets, on the calling thread only
+static bool RunTraceBenchmark(const char* scenePath)
+{
+    Donut::Scene scene;
+    if (!LoadPreviewScene(scene, scenePath))
+        return false;
+
+    constexpr uint32_t width      = 640;
+    constexpr uint32_t height     = 360;
+    constexpr size_t   MaxLinear  = 4096;
+    Donut::Camera camera = GetPreviewCamera(width, height);
+    glm::mat4 inverseViewProjection = glm::inverse(camera.GetProjectionMatrix() * camera.GetViewMatrix());
+
+    std::vector<Donut::Ray> rays;
+    rays.reserve(width * height);
+    for (uint32_t y = 0; y < height; ++y)
+        for (uint32_t x = 0; x < width; ++x)
+            rays.push_back(Donut::PreviewRenderer::GetPixelRay(inverseViewProjection, x, y, width, height));
+
+    std::vector<glm::vec3> scalar(rays.size()), packets(rays.size());
+    auto time = [](auto&& fn)
+    {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    double linearMs = 0.0;
+    if (scene.objs.size() <= MaxLinear)
+    {
+        std::vector<glm::vec3> linear(rays.size());
+        linearMs = time([&]() { for (size_t i = 0; i < rays.size(); ++i) linear[i] = TraceLinear(scene, rays[i]); });
+    }
+
+    double scalarMs = time([&]() { for (size_t i = 0; i < rays.size(); ++i) scalar[i] = scene.Trace(rays[i]); });
+    double packetMs = time([&]()
+    {
+        for (size_t i = 0; i < rays.size(); i += Donut::RayPacket::Width)
+        {
+            Donut::RayPacket packet;
+            for (uint32_t l = 0; l < Donut::RayPacket::Width; ++l)
+                packet.Set(l, rays[i + l]);
+            scene.Trace(packet, &packets[i]);
+        }
+    });
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < rays.size(); ++i)
+    {
+        glm::vec3 difference = glm::abs(scalar[i] - packets[i]);
+        mismatches += std::max({ difference.x, difference.y, difference.z }) > 1e-4f ? 1 : 0;
+    }
+
+    std::printf("%zu objects, %zu primary rays at %ux%u\n", scene.objs.size(), rays.size(), width, height);
+    if (linearMs > 0.0)
+        std::printf("  linear scalar : %8.2f ms\n", linearMs);
+    else
+        std::printf("  linear scalar :  skipped above %zu objects\n", MaxLinear);
+    std::printf("  BVH scalar    : %8.2f ms\n", scalarMs);
+    std::printf("  BVH packets   : %8.2f ms (%.2fx, %zu pixels differ)\n", packetMs, scalarMs / packetMs, mismatches);
+    return true;
+}
+
+// Pre-NBodySystem Engine::UpdatePhysics with gravity on: pairwise in float, moving bodies inside
+// the loop and allocating per pair. Only rows [0, rows) are run, so large counts can be sampled.
+static void StepPairwiseLegacy(std::vector<Donut::ObjectData>& objects, size_t rows)
+{
+    constexpr double G = 6.67430e-11;
+    for (size_t i = 0; i < rows; ++i)
+    {
+        auto& obj = objects[i];
+        for (auto& obj2 : objects)
+        {
+            if (&obj == &obj2) continue;
+            float dx = obj2.m_PosRadius.x - obj.m_PosRadius.x;
+            float dy = obj2.m_PosRadius.y - obj.m_PosRadius.y;
+            float dz = obj2.m_PosRadius.z - obj.m_PosRadius.z;
+            float distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+            if (distance > 0)
+            {
+                std::vector<double> direction = {dx / distance, dy / distance, dz / distance};
+                double Gforce = (G * obj.m_Mass * obj2.m_Mass) / (distance * distance);
+                double acc1 = Gforce / obj.m_Mass;
+                std::vector<double> acc = {direction[0] * acc1, direction[1] * acc1, direction[2] * acc1};
+
+                obj.m_Velocity.x += static_cast<float>(acc[0]);
+                obj.m_Velocity.y += static_cast<float>(acc[1]);
+                obj.m_Velocity.z += static_cast<float>(acc[2]);
+
+                obj.m_PosRadius.x += static_cast<float>(obj.m_Velocity.x);
+                obj.m_PosRadius.y += static_cast<float>(obj.m_Velocity.y);
+                obj.m_PosRadius.z += static_cast<float>(obj.m_Velocity.z);
+            }
+        }
+    }
+}
+
+// Times one force evaluation of a debris ball around the hole with the old pairwise loop, the
+// SoA direct kernel and the Barnes-Hut octree at several opening angles, on the calling thread
+// only. Above MaxTimedRows bodies the first two are timed over the first rows and scaled up,
+// since every row costs the same O(n); those rows are also the reference for the octree's error.
+static void RunNBodyBenchmark()
+{
+    constexpr size_t BodyCounts[]    = { 16, 1024, 100000 };
+    constexpr size_t MaxTimedRows    = 1024;
+    constexpr double OpeningAngles[] = { 0.3, 0.5, 0.7, 1.0 };
+
+    auto time = [](auto&& fn)
+    {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    for (size_t count : BodyCounts)
+    {
+        std::mt19937 random(1234);
+        std::uniform_real_distribution<double> unit(-1.0, 1.0);
+        std::uniform_real_distribution<double> mass(1e20, 1e24);
+
+        std::vector<Donut::ObjectData> objects;
+        objects.reserve(count);
+        objects.push_back({ glm::vec4(0.0f, 0.0f, 0.0f, 2.5e10f), glm::vec4(0.0f), 8.54e36f });
+
+        Donut::NBodySystem system;
+        system.Reserve(count);
+        system.AddBody(glm::dvec3(0.0), glm::dvec3(0.0), objects[0].m_Mass, false);
+
+        while (objects.size() < count)
+        {
+            glm::dvec3 position(unit(random), unit(random), unit(random));
+            double     length = glm::length(position);
+            if (length > 1.0 || length < 0.1)
+                continue;
+
+            position *= 1e12;
+            double bodyMass = mass(random);
+            objects.push_back({ glm::vec4(glm::vec3(position), 1e8f), glm::vec4(1.0f), static_cast<float>(bodyMass) });
+            system.AddBody(position, glm::dvec3(0.0), bodyMass);
+        }
+
+        // Small systems are repeated until about a million pairs are timed
+        size_t rows    = std::min(count, MaxTimedRows);
+        size_t repeats = std::max<size_t>(1, (1u << 20) / (rows * count));
+        double scale   = static_cast<double>(count) / static_cast<double>(rows * repeats);
+
+        double legacyMs = time([&]() { for (size_t r = 0; r < repeats; ++r) StepPairwiseLegacy(objects, rows); }) * scale;
+        double directMs = time([&]() { for (size_t r = 0; r < repeats; ++r) system.ComputeAccelerationsDirect(0, rows); }) * scale;
+
+        if (rows < count)
+            std::printf("%zu bodies (timed over the first %zu and scaled)\n", count, rows);
+        else
+            std::printf("%zu bodies\n", count);
+        std::printf("  pairwise loop : %10.3f ms\n", legacyMs);
+        std::printf("  SoA direct    : %10.3f ms (%.1fx)\n", directMs, legacyMs / directMs);
+
+        std::vector<glm::dvec3> reference(rows);
+        for (size_t i = 0; i < rows; ++i)
+            reference[i] = system.GetAcceleration(i);
+
+        system.SetDirectThreshold(0);
+        for (double theta : OpeningAngles)
+        {
+            system.SetOpeningAngle(theta);
+            double octreeMs = time([&]() { for (size_t r = 0; r < repeats; ++r) system.ComputeAccelerations(); }) / repeats;
+
+            double meanError = 0.0, maxError = 0.0;
+            for (size_t i = 0; i < rows; ++i)
+            {
+                double error = glm::length(system.GetAcceleration(i) - reference[i]) / glm::length(reference[i]);
+                meanError += error;
+                maxError   = std::max(maxError, error);
+            }
+            meanError /= static_cast<double>(rows);
+
+            std::printf("  octree %.1f    : %10.3f ms (%.1fx direct), relative force error mean %.1e max %.1e\n",
+                        theta, octreeMs, directMs / octreeMs, meanError, maxError);
+        }
+    }
+}
+
+int main(int argc, char** argv)
 {
-    Donut::Application* app = new Donut::Application("Donut Engine - Black Hole Simulation", 1280, 720);
+    // --convert-scene <input> <output> converts between .json and .dscene without opening a window
+    for (int i = 1; i + 2 < argc; ++i)
+    {
+        if (std::string_view(argv[i]) != "--convert-scene")
+            continue;
+
+        Donut::Logger::Init();
+        bool converted = Donut::SceneSerializer::Convert(argv[i + 1], argv[i + 2]);
+        Donut::Logger::Shutdown();
+        return converted ? 0 : 1;
+    }
+
+    // --render-preview <scene> <output.png> writes a CPU reference image without opening a window
+    for (int i = 1; i + 2 < argc; ++i)
+    {
+        if (std::string_view(argv[i]) != "--render-preview")
+            continue;
+
+        Donut::Logger::Init();
+        Donut::JobSystem::Init();
+        bool rendered = RenderPreviewImage(argv[i + 1], argv[i + 2]);
+        Donut::JobSystem::Shutdown();
+        Donut::Logger::Shutdown();
+        return rendered ? 0 : 1;
+    }
+
+    // --benchmark-trace <scene> compares scalar and packet ray tracing of the preview view
+    for (int i = 1; i + 1 < argc; ++i)
+    {
+        if (std::string_view(argv[i]) != "--benchmark-trace")
+            continue;
+
+        Donut::Logger::Init();
+        bool benchmarked = RunTraceBenchmark(argv[i + 1]);
+        Donut::Logger::Shutdown();
+        return benchmarked ? 0 : 1;
+    }
+
+    // --benchmark-nbody compares the N-body force kernels, and the octree's error, at 16, 1k and 100k bodies
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::string_view(argv[i]) != "--benchmark-nbody")
+            continue;
+
+        Donut::Logger::Init();
+        RunNBodyBenchmark();
+        Donut::Logger::Shutdown();
+        return 0;
+    }
+
+    Donut::Application* app = new Donut::Application("Donut Engine - Black Hole Simulation", 1280, 720, { argc, argv });
     app->Run();
     delete app;
-}
\ No newline at end of file
+}